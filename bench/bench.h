@@ -0,0 +1,44 @@
+#if !defined(LD_BENCH_BENCH_H)
+#define LD_BENCH_BENCH_H
+/**
+ * Description:  Benchmark utility common functions.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "core/print.h"
+#include "core/time.h"
+
+/// Benchmark function.
+typedef void BenchmarkFN(void);
+
+/// Query seconds elapsed since benchmarks started.
+header_only f64 bench_time_seconds(void) {
+    time_update();
+    return time_elapsed_seconds();
+}
+
+/// Print a benchmark section header.
+#define bench_section( name )\
+    println( CONSOLE_COLOR_CYAN "{cc}" CONSOLE_COLOR_RESET, name )
+
+/// Print result of a benchmark run.
+#define bench_report( name, operations, seconds )\
+    println( "    {cc}: {f,.2}ms total, {f,.2}ns/op",\
+        name, (f64)(seconds) * 1000.0,\
+        ((f64)(seconds) * 1000000000.0) / (f64)(operations) )
+
+void benchmark_block_allocator(void);
+void benchmark_slab_allocator(void);
+void benchmark_memory_telemetry(void);
+void benchmark_memory_primitives(void);
+void benchmark_hashmap(void);
+void benchmark_string_hash(void);
+void benchmark_ring(void);
+void benchmark_sort(void);
+void benchmark_radix_sort(void);
+void benchmark_parallel_sort(void);
+void benchmark_sync(void);
+void benchmark_read_mostly(void);
+
+#endif /* header guard */
@@ -0,0 +1,283 @@
+/**
+ * Description:  Block allocator benchmark.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "core/memory.h"
+#include "core/rand.h"
+
+#include "bench/bench.h"
+
+// NOTE(alicia): copy of block allocator from before free list
+// was packed into a bitset, only used for comparison.
+
+struct LegacyBlockAllocator {
+    void* buffer;
+    usize block_size;
+    usize block_count;
+    u8    free_list[];
+};
+typedef struct LegacyBlockAllocator LegacyBlockAllocator;
+
+internal usize legacy_block_allocator_memory_requirement(
+    usize block_count, usize block_size
+) {
+    return sizeof(LegacyBlockAllocator) + ( block_count * block_size ) + block_count;
+}
+internal LegacyBlockAllocator* legacy_block_allocator_create(
+    usize block_count, usize block_size, void* buffer
+) {
+    LegacyBlockAllocator* result = buffer;
+    result->block_size  = block_size;
+    result->block_count = block_count;
+    result->buffer      = (u8*)buffer + sizeof(LegacyBlockAllocator) + block_count;
+    memory_zero( result->free_list, block_count );
+    return result;
+}
+internal b32 legacy_block_allocator_find_free_blocks(
+    LegacyBlockAllocator* allocator, usize block_count, usize* out_head
+) {
+    usize free_block_head  = 0;
+    usize free_block_count = 0;
+    for( usize i = 0; i < allocator->block_count; ++i ) {
+        if( !allocator->free_list[i] ) {
+            if( !free_block_count ) {
+                free_block_head = i;
+            }
+            free_block_count++;
+            if( free_block_count == block_count ) {
+                *out_head = free_block_head;
+                return true;
+            }
+        } else {
+            free_block_count = 0;
+        }
+    }
+    return false;
+}
+internal usize legacy_size_to_blocks( usize block_size, usize size ) {
+    return ( size / block_size ) + ( ( size % block_size ) ? 1 : 0 );
+}
+internal void* legacy_block_allocator_alloc(
+    LegacyBlockAllocator* allocator, usize size
+) {
+    usize block_count = legacy_size_to_blocks( allocator->block_size, size );
+    usize head = 0;
+    if( legacy_block_allocator_find_free_blocks( allocator, block_count, &head ) ) {
+        memory_set( allocator->free_list + head, 1, block_count );
+        return (u8*)allocator->buffer + ( head * allocator->block_size );
+    }
+    return NULL;
+}
+internal void legacy_block_allocator_free(
+    LegacyBlockAllocator* allocator, void* memory, usize size
+) {
+    usize block_count = legacy_size_to_blocks( allocator->block_size, size );
+    usize head = ((usize)memory - (usize)allocator->buffer) / allocator->block_size;
+    memory_zero( memory, size );
+    memory_zero( allocator->free_list + head, block_count );
+}
+internal void* legacy_block_allocator_realloc(
+    LegacyBlockAllocator* allocator, void* memory, usize old_size, usize new_size
+) {
+    usize old_block_count = legacy_size_to_blocks( allocator->block_size, old_size );
+    usize new_block_count = legacy_size_to_blocks( allocator->block_size, new_size );
+    if( new_block_count <= old_block_count ) {
+        return memory;
+    }
+
+    usize head = ((usize)memory - (usize)allocator->buffer) / allocator->block_size;
+    usize tail = head + old_block_count;
+    usize additional = new_block_count - old_block_count;
+
+    b32 adjacent_blocks_are_free = tail + additional <= allocator->block_count;
+    for( usize i = 0; adjacent_blocks_are_free && i < additional; ++i ) {
+        adjacent_blocks_are_free = !allocator->free_list[tail + i];
+    }
+    if( adjacent_blocks_are_free ) {
+        memory_set( allocator->free_list + tail, 1, additional );
+        return memory;
+    }
+
+    void* result = legacy_block_allocator_alloc( allocator, new_size );
+    if( !result ) {
+        return NULL;
+    }
+    memory_copy( result, memory, old_size );
+    legacy_block_allocator_free( allocator, memory, old_size );
+    return result;
+}
+
+#define BENCH_BLOCK_SIZE       (64)
+#define BENCH_BLOCK_COUNT      (8192)
+#define BENCH_MAX_LIVE         (1024)
+#define BENCH_OPERATION_COUNT  (200000)
+
+typedef enum BenchBlockOperation : u8 {
+    BENCH_BLOCK_OPERATION_ALLOC,
+    BENCH_BLOCK_OPERATION_FREE,
+    BENCH_BLOCK_OPERATION_REALLOC,
+} BenchBlockOperation;
+
+typedef struct BenchBlockMix {
+    const char* name;
+    /// Percent of operations that allocate.
+    u32 alloc_percent;
+    /// Percent of operations that reallocate.
+    u32 realloc_percent;
+    /// Largest allocation in blocks.
+    u32 max_blocks;
+} BenchBlockMix;
+
+typedef struct BenchBlockLive {
+    void* memory;
+    usize size;
+} BenchBlockLive;
+
+typedef struct BenchBlockOp {
+    BenchBlockOperation operation;
+    u32 slot;
+    u32 size;
+} BenchBlockOp;
+
+/// Generate operation sequence so that both allocators
+/// receive exactly the same requests.
+internal void ___bench_block_generate(
+    BenchBlockMix* mix, BenchBlockOp* ops, usize op_count
+) {
+    RandState state = rand_init_state( 1234 );
+
+    usize live = 0;
+    for( usize i = 0; i < op_count; ++i ) {
+        BenchBlockOp* op = ops + i;
+        u32 roll = rand_xor_u32_state( &state ) % 100;
+        u32 size =
+            ( rand_xor_u32_state( &state ) %
+            ( mix->max_blocks * BENCH_BLOCK_SIZE ) ) + 1;
+
+        if( !live || ( roll < mix->alloc_percent && live < BENCH_MAX_LIVE ) ) {
+            op->operation = BENCH_BLOCK_OPERATION_ALLOC;
+            op->slot      = live++;
+        } else if( roll < mix->alloc_percent + mix->realloc_percent ) {
+            op->operation = BENCH_BLOCK_OPERATION_REALLOC;
+            op->slot      = rand_xor_u32_state( &state ) % live;
+        } else {
+            op->operation = BENCH_BLOCK_OPERATION_FREE;
+            op->slot      = rand_xor_u32_state( &state ) % live;
+            live--;
+        }
+        op->size = size;
+    }
+}
+
+#define ___bench_block_run( allocator, alloc_fn, realloc_fn, free_fn ) do {\
+    usize live = 0;\
+    for( usize i = 0; i < op_count; ++i ) {\
+        BenchBlockOp* op = ops + i;\
+        switch( op->operation ) {\
+            case BENCH_BLOCK_OPERATION_ALLOC: {\
+                BenchBlockLive* slot = slots + op->slot;\
+                slot->memory = alloc_fn( allocator, op->size );\
+                slot->size   = slot->memory ? op->size : 0;\
+                live++;\
+            } break;\
+            case BENCH_BLOCK_OPERATION_REALLOC: {\
+                BenchBlockLive* slot = slots + op->slot;\
+                if( slot->memory ) {\
+                    usize new_size = slot->size + op->size;\
+                    void* memory   = realloc_fn(\
+                        allocator, slot->memory, slot->size, new_size );\
+                    if( memory ) {\
+                        slot->memory = memory;\
+                        slot->size   = new_size;\
+                    }\
+                }\
+            } break;\
+            case BENCH_BLOCK_OPERATION_FREE: {\
+                BenchBlockLive* slot = slots + op->slot;\
+                if( slot->memory ) {\
+                    free_fn( allocator, slot->memory, slot->size );\
+                }\
+                *slot = slots[--live];\
+            } break;\
+        }\
+    }\
+} while(0)
+
+internal void ___bench_block_mix( BenchBlockMix* mix ) {
+    usize op_count = BENCH_OPERATION_COUNT;
+
+    usize ops_size   = sizeof(BenchBlockOp) * op_count;
+    usize slots_size = sizeof(BenchBlockLive) * BENCH_MAX_LIVE;
+    usize new_size   = block_allocator_memory_requirement(
+        BENCH_BLOCK_COUNT, BENCH_BLOCK_SIZE );
+    usize old_size   = legacy_block_allocator_memory_requirement(
+        BENCH_BLOCK_COUNT, BENCH_BLOCK_SIZE );
+
+    BenchBlockOp*   ops        = system_alloc( ops_size );
+    BenchBlockLive* slots      = system_alloc( slots_size );
+    void*           new_buffer = system_alloc( new_size );
+    void*           old_buffer = system_alloc( old_size );
+    if( !ops || !slots || !new_buffer || !old_buffer ) {
+        println_err( "failed to allocate benchmark memory!" );
+        return;
+    }
+
+    ___bench_block_generate( mix, ops, op_count );
+
+    println( "  {cc}:", mix->name );
+
+    LegacyBlockAllocator* old_allocator = legacy_block_allocator_create(
+        BENCH_BLOCK_COUNT, BENCH_BLOCK_SIZE, old_buffer );
+    memory_zero( slots, slots_size );
+
+    f64 start = bench_time_seconds();
+    ___bench_block_run(
+        old_allocator,
+        legacy_block_allocator_alloc,
+        legacy_block_allocator_realloc,
+        legacy_block_allocator_free );
+    f64 old_seconds = bench_time_seconds() - start;
+    bench_report( "byte free list", op_count, old_seconds );
+
+    memory_zero( new_buffer, new_size );
+    BlockAllocator* new_allocator = block_allocator_create(
+        BENCH_BLOCK_COUNT, BENCH_BLOCK_SIZE, new_buffer );
+    memory_zero( slots, slots_size );
+
+    start = bench_time_seconds();
+    ___bench_block_run(
+        new_allocator,
+        block_allocator_alloc,
+        block_allocator_realloc,
+        block_allocator_free );
+    f64 new_seconds = bench_time_seconds() - start;
+    bench_report( "bitset free list", op_count, new_seconds );
+
+    println( "    speedup: {f,.2}x", old_seconds / new_seconds );
+
+    system_free( old_buffer, old_size );
+    system_free( new_buffer, new_size );
+    system_free( slots, slots_size );
+    system_free( ops, ops_size );
+}
+
+void benchmark_block_allocator(void) {
+    BenchBlockMix mixes[] = {
+        { "alloc/free, small",   55, 0,  4 },
+        { "alloc/free, mixed",   55, 0,  32 },
+        { "alloc/free/realloc",  45, 20, 16 },
+        { "near full",           70, 10, 8 },
+    };
+
+    for( usize i = 0; i < static_array_count( mixes ); ++i ) {
+        ___bench_block_mix( mixes + i );
+    }
+}
+
+#undef ___bench_block_run
+#undef BENCH_BLOCK_SIZE
+#undef BENCH_BLOCK_COUNT
+#undef BENCH_MAX_LIVE
+#undef BENCH_OPERATION_COUNT
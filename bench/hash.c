@@ -0,0 +1,80 @@
+/**
+ * Description:  String hash benchmark.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "core/memory.h"
+#include "core/string.h"
+#include "core/rand.h"
+
+#include "bench/bench.h"
+
+// NOTE(alicia): copy of cstr_hash from before it was replaced,
+// only used for comparison.
+internal u64 legacy_elf_hash( usize len, const char* str ) {
+    unsigned char* ustr = (unsigned char*)str;
+
+    u64 x;
+    u64 result = x = 0;
+    for( usize i = 0; i < len; ++i ) {
+        result = ( result << 4 ) + ustr[i];
+        x = result & 0xF000000000000000;
+        if( x ) {
+            result ^= x >> 24;
+        }
+        result &= ~x;
+    }
+
+    return result;
+}
+
+#define BENCH_HASH_TOTAL_BYTES (megabytes(256))
+#define BENCH_HASH_BUFFER_SIZE (kilobytes(64))
+
+void benchmark_string_hash(void) {
+    usize sizes[] = { 8, 24, 64, 256, kilobytes(4), BENCH_HASH_BUFFER_SIZE };
+
+    char* buffer = system_alloc( BENCH_HASH_BUFFER_SIZE );
+    if( !buffer ) {
+        println_err( "failed to allocate benchmark memory!" );
+        return;
+    }
+    RandState state = rand_init_state( 1234 );
+    for( usize i = 0; i < BENCH_HASH_BUFFER_SIZE; ++i ) {
+        buffer[i] = (char)rand_xor_u32_state( &state );
+    }
+
+    for( usize i = 0; i < static_array_count( sizes ); ++i ) {
+        usize size  = sizes[i];
+        usize count = BENCH_HASH_TOTAL_BYTES / size;
+        usize steps = BENCH_HASH_BUFFER_SIZE - size + 1;
+
+        println( "  {usize} bytes:", size );
+
+        u64 sum = 0;
+        f64 start = bench_time_seconds();
+        for( usize j = 0; j < count; ++j ) {
+            sum += legacy_elf_hash( size, buffer + ( j % steps ) );
+        }
+        f64 legacy_seconds = bench_time_seconds() - start;
+        bench_report( "elf hash", count, legacy_seconds );
+
+        start = bench_time_seconds();
+        for( usize j = 0; j < count; ++j ) {
+            sum += cstr_hash( size, buffer + ( j % steps ) );
+        }
+        f64 seconds = bench_time_seconds() - start;
+        bench_report( "cstr_hash", count, seconds );
+
+        println(
+            "    throughput: {f,.2}GB/s, speedup: {f,.2}x, checksum: {u64}",
+            ( (f64)BENCH_HASH_TOTAL_BYTES / seconds ) / 1000000000.0,
+            legacy_seconds / seconds, sum );
+    }
+
+    system_free( buffer, BENCH_HASH_BUFFER_SIZE );
+}
+
+#undef BENCH_HASH_TOTAL_BYTES
+#undef BENCH_HASH_BUFFER_SIZE
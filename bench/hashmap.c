@@ -0,0 +1,219 @@
+/**
+ * Description:  Hashmap benchmark.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "shared/constants.h"
+#include "core/memory.h"
+#include "core/collections.h"
+#include "core/rand.h"
+
+#include "bench/bench.h"
+
+// NOTE(alicia): copy of hashmap from before it was replaced
+// with an open addressing table, only used for comparison.
+
+#define LEGACY_HASHMAP_MAX_LINEAR_SEARCH (32)
+
+typedef struct LegacyHashmap {
+    Key*  keys;
+    u64*  values;
+    usize count;
+    usize capacity;
+    Key   largest_key;
+} LegacyHashmap;
+
+internal b32 legacy_hashmap_insert( LegacyHashmap* hashmap, Key key, u64 value ) {
+    if( hashmap->count == hashmap->capacity ) {
+        return false;
+    }
+
+    usize index = hashmap->count;
+    if( hashmap->count && key < hashmap->largest_key ) {
+        index = 0;
+        if( key > hashmap->keys[0] ) {
+            usize low  = 0;
+            usize high = hashmap->count;
+            while( low < high ) {
+                usize mid = ( low + high ) >> 1;
+                if( hashmap->keys[mid] < key ) {
+                    low = mid + 1;
+                } else {
+                    high = mid;
+                }
+            }
+            index = low;
+        }
+    }
+
+    usize copy_count = hashmap->count - index;
+    if( copy_count ) {
+        memory_copy_overlapped(
+            hashmap->keys + index + 1, hashmap->keys + index,
+            copy_count * sizeof(Key) );
+        memory_copy_overlapped(
+            hashmap->values + index + 1, hashmap->values + index,
+            copy_count * sizeof(u64) );
+    }
+    hashmap->keys[index]   = key;
+    hashmap->values[index] = value;
+    hashmap->count++;
+    if( key > hashmap->largest_key ) {
+        hashmap->largest_key = key;
+    }
+    return true;
+}
+internal usize legacy_hashmap_find( LegacyHashmap* hashmap, Key key ) {
+    if( hashmap->count < LEGACY_HASHMAP_MAX_LINEAR_SEARCH ) {
+        for( usize i = 0; i < hashmap->count; ++i ) {
+            if( hashmap->keys[i] == key ) {
+                return i;
+            }
+        }
+        return USIZE_MAX;
+    }
+    usize low  = 0;
+    usize high = hashmap->count;
+    while( low < high ) {
+        usize mid = ( low + high ) >> 1;
+        Key k = hashmap->keys[mid];
+        if( k == key ) {
+            return mid;
+        } else if( k < key ) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return USIZE_MAX;
+}
+internal u64* legacy_hashmap_get( LegacyHashmap* hashmap, Key key ) {
+    usize index = legacy_hashmap_find( hashmap, key );
+    return index == USIZE_MAX ? NULL : hashmap->values + index;
+}
+internal b32 legacy_hashmap_remove( LegacyHashmap* hashmap, Key key ) {
+    usize index = legacy_hashmap_find( hashmap, key );
+    if( index == USIZE_MAX ) {
+        return false;
+    }
+    usize copy_count = hashmap->count - index - 1;
+    memory_copy_overlapped(
+        hashmap->keys + index, hashmap->keys + index + 1,
+        copy_count * sizeof(Key) );
+    memory_copy_overlapped(
+        hashmap->values + index, hashmap->values + index + 1,
+        copy_count * sizeof(u64) );
+    hashmap->count--;
+    return true;
+}
+
+internal usize ___bench_hashmap_capacity( usize count ) {
+    usize result = HASHMAP_GROUP_WIDTH;
+    while( hashmap_max_count( result ) < count ) {
+        result <<= 1;
+    }
+    return result;
+}
+
+internal void ___bench_hashmap( usize count ) {
+    usize keys_size       = sizeof(Key) * count;
+    usize legacy_capacity = count;
+    usize legacy_size     = ( sizeof(Key) + sizeof(u64) ) * legacy_capacity;
+    usize capacity        = ___bench_hashmap_capacity( count );
+    usize size            = hashmap_memory_requirement( capacity, sizeof(u64) );
+
+    Key*  keys          = system_alloc( keys_size );
+    void* legacy_buffer = system_alloc( legacy_size );
+    void* buffer        = system_alloc( size );
+    if( !keys || !legacy_buffer || !buffer ) {
+        println_err( "failed to allocate benchmark memory!" );
+        return;
+    }
+
+    RandState state = rand_init_state( 1234 );
+    for( usize i = 0; i < count; ++i ) {
+        keys[i] =
+            ( (u64)rand_xor_u32_state( &state ) << 32 ) |
+            rand_xor_u32_state( &state );
+    }
+
+    println( "  {usize} keys:", count );
+
+    LegacyHashmap legacy = {};
+    legacy.keys     = legacy_buffer;
+    legacy.values   = (u64*)( legacy.keys + legacy_capacity );
+    legacy.capacity = legacy_capacity;
+
+    u64 sum = 0;
+
+    f64 start = bench_time_seconds();
+    for( usize i = 0; i < count; ++i ) {
+        legacy_hashmap_insert( &legacy, keys[i], i );
+    }
+    f64 legacy_insert = bench_time_seconds() - start;
+
+    start = bench_time_seconds();
+    for( usize i = 0; i < count; ++i ) {
+        u64* value = legacy_hashmap_get( &legacy, keys[i] );
+        if( !value ) {
+            println_err( "sorted array lost key {u64}!", keys[i] );
+            break;
+        }
+        sum += *value;
+    }
+    f64 legacy_get = bench_time_seconds() - start;
+
+    start = bench_time_seconds();
+    for( usize i = 0; i < count; ++i ) {
+        legacy_hashmap_remove( &legacy, keys[i] );
+    }
+    f64 legacy_remove = bench_time_seconds() - start;
+
+    Hashmap hashmap = hashmap_create( capacity, sizeof(u64), buffer );
+
+    start = bench_time_seconds();
+    for( usize i = 0; i < count; ++i ) {
+        u64 value = i;
+        hashmap_insert( &hashmap, keys[i], &value );
+    }
+    f64 insert = bench_time_seconds() - start;
+
+    start = bench_time_seconds();
+    for( usize i = 0; i < count; ++i ) {
+        u64* value = hashmap_get( &hashmap, keys[i] );
+        if( !value ) {
+            println_err( "swiss table lost key {u64}!", keys[i] );
+            break;
+        }
+        sum += *value;
+    }
+    f64 get = bench_time_seconds() - start;
+
+    start = bench_time_seconds();
+    for( usize i = 0; i < count; ++i ) {
+        hashmap_remove( &hashmap, keys[i], NULL );
+    }
+    f64 remove = bench_time_seconds() - start;
+
+    bench_report( "sorted array insert", count, legacy_insert );
+    bench_report( "swiss table insert ", count, insert );
+    bench_report( "sorted array get   ", count, legacy_get );
+    bench_report( "swiss table get    ", count, get );
+    bench_report( "sorted array remove", count, legacy_remove );
+    bench_report( "swiss table remove ", count, remove );
+    println( "    checksum: {u64}", sum );
+
+    system_free( buffer, size );
+    system_free( legacy_buffer, legacy_size );
+    system_free( keys, keys_size );
+}
+
+void benchmark_hashmap(void) {
+    usize counts[] = { 1000, 10000, 50000 };
+    for( usize i = 0; i < static_array_count( counts ); ++i ) {
+        ___bench_hashmap( counts[i] );
+    }
+}
+
+#undef LEGACY_HASHMAP_MAX_LINEAR_SEARCH
@@ -0,0 +1,96 @@
+/**
+ * Description:  Liquid Engine Benchmarks.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "core/print.h"
+#include "core/string.h"
+#include "core/time.h"
+#include "core/system.h"
+
+#include "bench/bench.h"
+
+typedef struct Benchmark {
+    const char*  name;
+    const char*  description;
+    BenchmarkFN* proc;
+} Benchmark;
+
+global Benchmark global_benchmarks[] = {
+    { "block", "block allocator bitset vs byte free list", benchmark_block_allocator },
+    { "slab", "slab allocator vs system_alloc, 1/4/16 threads", benchmark_slab_allocator },
+    { "telemetry", "allocation telemetry record cost", benchmark_memory_telemetry },
+    { "memory", "simd memory primitives vs scalar", benchmark_memory_primitives },
+    { "hashmap", "open addressing hashmap vs sorted array", benchmark_hashmap },
+    { "hash", "string hash vs elf hash", benchmark_string_hash },
+    { "ring", "lock-free spsc/mpmc rings vs mutex ring", benchmark_ring },
+    { "sort", "pdqsort vs lomuto quicksort on 4 input patterns", benchmark_sort },
+    { "radix", "radix sort vs pdqsort on key index pairs", benchmark_radix_sort },
+    { "psort", "parallel quicksort on job system vs serial", benchmark_parallel_sort },
+    { "sync", "futex mutex/semaphore/event vs os primitives", benchmark_sync },
+    { "rwlock", "rw lock and seq lock vs mutex on read-mostly data", benchmark_read_mostly },
+};
+
+global const char* global_program_name = "bench";
+
+internal void print_help(void);
+
+int main( int argc, char** argv ) {
+    global_program_name = argv[0];
+
+    time_initialize();
+
+    SystemInfo system_info = {};
+    system_info_query( &system_info );
+
+    b32 run_all = argc <= 1;
+    for( int i = 1; i < argc; ++i ) {
+        StringSlice arg = string_slice_from_cstr( 0, argv[i] );
+        if( string_slice_cmp( arg, string_slice( "--help" ) ) ) {
+            print_help();
+            return 0;
+        }
+    }
+
+    println( "cpu:     {cc}", system_info.cpu_name );
+    println( "threads: {u32}", (u32)system_info.cpu_count );
+    println( "cores:   {u32}", (u32)system_info.physical_cpu_count );
+    println(
+        "caches:  L1 {f,.2,m} L2 {f,.2,m} L3 {f,.2,m} line {u32}",
+        (f64)system_info.l1_cache_size, (f64)system_info.l2_cache_size,
+        (f64)system_info.l3_cache_size, system_info.cache_line_size );
+
+    for( usize i = 0; i < static_array_count( global_benchmarks ); ++i ) {
+        Benchmark* benchmark = global_benchmarks + i;
+
+        b32 run = run_all;
+        for( int j = 1; j < argc && !run; ++j ) {
+            StringSlice arg  = string_slice_from_cstr( 0, argv[j] );
+            StringSlice name = string_slice_from_cstr( 0, benchmark->name );
+            run = string_slice_cmp( arg, name );
+        }
+
+        if( run ) {
+            bench_section( benchmark->description );
+            benchmark->proc();
+        }
+    }
+
+    return 0;
+}
+
+internal void print_help(void) {
+    println( "OVERVIEW: Liquid Engine Benchmarks\n" );
+    println( "USAGE: {cc} [<benchmark>...]\n", global_program_name );
+    println( "BENCHMARKS:" );
+    for( usize i = 0; i < static_array_count( global_benchmarks ); ++i ) {
+        println(
+            "    {cc}: {cc}",
+            global_benchmarks[i].name, global_benchmarks[i].description );
+    }
+    println( "" );
+    println( "Runs every benchmark if none are specified." );
+}
+
+#include "bench/generated_dependencies.inl"
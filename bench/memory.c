@@ -0,0 +1,168 @@
+/**
+ * Description:  Memory primitives benchmark.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "core/memory.h"
+#include "core/rand.h"
+
+#include "bench/bench.h"
+
+// NOTE(alicia): scalar versions of memory primitives,
+// only used for comparison.
+
+internal no_inline b32 legacy_memory_cmp( const void* a, const void* b, usize size ) {
+    usize size64 = size / sizeof(u64);
+    for( usize i = 0; i < size64; ++i ) {
+        if( *((u64*)a + i) != *((u64*)b + i) ) {
+            return false;
+        }
+    }
+    u8* a_remainder = (u8*)((u64*)a + size64);
+    u8* b_remainder = (u8*)((u64*)b + size64);
+    for( usize i = 0; i < size % sizeof(u64); ++i ) {
+        if( a_remainder[i] != b_remainder[i] ) {
+            return false;
+        }
+    }
+    return true;
+}
+internal no_inline void legacy_memory_set_chunks(
+    void* in_dst, usize chunk_size, void* chunk, usize chunk_count
+) {
+    u8* dst = in_dst;
+    for( usize i = 0; i < chunk_count; ++i ) {
+        memory_copy( dst, chunk, chunk_size );
+        dst += chunk_size;
+    }
+}
+internal no_inline b32 legacy_memory_find_byte(
+    const void* memory, usize size, u8 value, usize* out_index
+) {
+    const u8* bytes = memory;
+    for( usize i = 0; i < size; ++i ) {
+        if( bytes[i] == value ) {
+            *out_index = i;
+            return true;
+        }
+    }
+    return false;
+}
+internal no_inline usize legacy_memory_count_byte(
+    const void* memory, usize size, u8 value
+) {
+    const u8* bytes = memory;
+    usize result = 0;
+    for( usize i = 0; i < size; ++i ) {
+        result += bytes[i] == value;
+    }
+    return result;
+}
+internal no_inline b32 legacy_memory_is_zero( const void* memory, usize size ) {
+    const u8* bytes = memory;
+    for( usize i = 0; i < size; ++i ) {
+        if( bytes[i] ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#define BENCH_MEMORY_MAX_SIZE (megabytes(1))
+#define BENCH_MEMORY_BYTES_PER_SIZE (megabytes(256))
+
+/// Run expression enough times to touch BENCH_MEMORY_BYTES_PER_SIZE bytes
+/// and report old vs new.
+#define ___bench_memory_compare( name, size, old_expr, new_expr ) do {\
+    usize iterations = BENCH_MEMORY_BYTES_PER_SIZE / (size);\
+    volatile usize sink = 0;\
+    f64 start = bench_time_seconds();\
+    for( usize i = 0; i < iterations; ++i ) {\
+        sink += (usize)(old_expr);\
+    }\
+    f64 old_seconds = bench_time_seconds() - start;\
+    start = bench_time_seconds();\
+    for( usize i = 0; i < iterations; ++i ) {\
+        sink += (usize)(new_expr);\
+    }\
+    f64 new_seconds = bench_time_seconds() - start;\
+    unused(sink);\
+    println( "    {cc,-12} {usize,8}B: scalar {f,.2}ns/call simd {f,.2}ns/call ({f,.2}x)",\
+        name, (usize)(size),\
+        ( old_seconds * 1000000000.0 ) / (f64)iterations,\
+        ( new_seconds * 1000000000.0 ) / (f64)iterations,\
+        old_seconds / new_seconds );\
+} while(0)
+
+internal usize ___bench_set_chunks_legacy(
+    u8* dst, usize chunk_size, u8* chunk, usize size
+) {
+    legacy_memory_set_chunks( dst, chunk_size, chunk, size / chunk_size );
+    return dst[0];
+}
+internal usize ___bench_set_chunks(
+    u8* dst, usize chunk_size, u8* chunk, usize size
+) {
+    memory_set_chunks( dst, chunk_size, chunk, size / chunk_size );
+    return dst[0];
+}
+
+void benchmark_memory_primitives(void) {
+    usize sizes[] = { 64, kilobytes(4), BENCH_MEMORY_MAX_SIZE };
+
+    usize buffer_size = BENCH_MEMORY_MAX_SIZE;
+    u8* a = system_alloc( buffer_size );
+    u8* b = system_alloc( buffer_size );
+    if( !a || !b ) {
+        println_err( "failed to allocate benchmark memory!" );
+        return;
+    }
+
+    // NOTE(alicia): random bytes that never contain needle,
+    // so that find has to scan the whole buffer.
+    u8 needle = 0xFF;
+    RandState state = rand_init_state( 1234 );
+    for( usize i = 0; i < buffer_size; ++i ) {
+        a[i] = (u8)( rand_xor_u32_state( &state ) % 0xFF );
+    }
+
+    u8 chunk[24] = {};
+    for( usize i = 0; i < static_array_count( chunk ); ++i ) {
+        chunk[i] = (u8)i;
+    }
+
+    for( usize i = 0; i < static_array_count( sizes ); ++i ) {
+        usize size = sizes[i];
+        usize index = 0;
+        memory_copy( b, a, size );
+
+        ___bench_memory_compare( "cmp", size,
+            legacy_memory_cmp( a, b, size ),
+            memory_cmp( a, b, size ) );
+        ___bench_memory_compare( "find", size,
+            legacy_memory_find_byte( a, size, needle, &index ),
+            memory_find_byte( a, size, needle, &index ) );
+        ___bench_memory_compare( "count", size,
+            legacy_memory_count_byte( a, size, 7 ),
+            memory_count_byte( a, size, 7 ) );
+        ___bench_memory_compare( "set chunks 8", size,
+            ___bench_set_chunks_legacy( b, 8, chunk, size ),
+            ___bench_set_chunks( b, 8, chunk, size ) );
+        ___bench_memory_compare( "set chunks 24", size,
+            ___bench_set_chunks_legacy( b, 24, chunk, size ),
+            ___bench_set_chunks( b, 24, chunk, size ) );
+
+        memory_zero( b, size );
+        ___bench_memory_compare( "is zero", size,
+            legacy_memory_is_zero( b, size ),
+            memory_is_zero( b, size ) );
+    }
+
+    system_free( a, buffer_size );
+    system_free( b, buffer_size );
+}
+
+#undef ___bench_memory_compare
+#undef BENCH_MEMORY_MAX_SIZE
+#undef BENCH_MEMORY_BYTES_PER_SIZE
@@ -0,0 +1,247 @@
+/**
+ * Description:  Ring buffer benchmark.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "core/memory.h"
+#include "core/ring.h"
+#include "core/sync.h"
+#include "core/thread.h"
+
+#include "bench/bench.h"
+
+#define BENCH_RING_CAPACITY    (1024)
+#define BENCH_RING_ITEM_COUNT  (1000000)
+#define BENCH_RING_MAX_THREADS (4)
+
+/// Values of start flag that benchmark threads spin on.
+#define BENCH_RING_START_WAIT   (0)
+#define BENCH_RING_START_RUN    (1)
+#define BENCH_RING_START_CANCEL (2)
+
+typedef enum BenchRingKind : u32 {
+    BENCH_RING_KIND_SPSC,
+    BENCH_RING_KIND_MPMC,
+    BENCH_RING_KIND_MUTEX,
+} BenchRingKind;
+
+// NOTE(alicia): mutex guarded ring, only used for comparison.
+typedef struct BenchMutexRing {
+    Mutex lock;
+    u32   head;
+    u32   tail;
+    u64   items[BENCH_RING_CAPACITY];
+} BenchMutexRing;
+
+internal b32 ___bench_mutex_ring_push( BenchMutexRing* ring, u64 item ) {
+    b32 result = false;
+    mutex_lock( &ring->lock );
+    if( ring->head - ring->tail < BENCH_RING_CAPACITY ) {
+        ring->items[ring->head++ % BENCH_RING_CAPACITY] = item;
+        result = true;
+    }
+    mutex_unlock( &ring->lock );
+    return result;
+}
+internal b32 ___bench_mutex_ring_pop( BenchMutexRing* ring, u64* out_item ) {
+    b32 result = false;
+    mutex_lock( &ring->lock );
+    if( ring->head != ring->tail ) {
+        *out_item = ring->items[ring->tail++ % BENCH_RING_CAPACITY];
+        result = true;
+    }
+    mutex_unlock( &ring->lock );
+    return result;
+}
+
+typedef struct BenchRingThread {
+    BenchRingKind   kind;
+    void*           ring;
+    usize           count;
+    u64             sum;
+    volatile u32*   start;
+    volatile u32*   done;
+} BenchRingThread;
+
+internal b32 ___bench_ring_push( BenchRingKind kind, void* ring, u64 item ) {
+    switch( kind ) {
+        case BENCH_RING_KIND_SPSC:  return ring_spsc_push( ring, &item );
+        case BENCH_RING_KIND_MPMC:  return ring_mpmc_push( ring, &item );
+        case BENCH_RING_KIND_MUTEX: return ___bench_mutex_ring_push( ring, item );
+    }
+    return false;
+}
+internal b32 ___bench_ring_pop( BenchRingKind kind, void* ring, u64* out_item ) {
+    switch( kind ) {
+        case BENCH_RING_KIND_SPSC:  return ring_spsc_pop( ring, out_item );
+        case BENCH_RING_KIND_MPMC:  return ring_mpmc_pop( ring, out_item );
+        case BENCH_RING_KIND_MUTEX: return ___bench_mutex_ring_pop( ring, out_item );
+    }
+    return false;
+}
+
+/// Spin until benchmark starts.
+/// Returns false if benchmark was cancelled before starting.
+internal b32 ___bench_ring_wait_start( BenchRingThread* thread ) {
+    while( *thread->start == BENCH_RING_START_WAIT ) {
+        cpu_pause();
+    }
+    if( *thread->start == BENCH_RING_START_CANCEL ) {
+        interlocked_increment( thread->done );
+        return false;
+    }
+    return true;
+}
+internal int ___bench_ring_producer( void* params ) {
+    BenchRingThread* thread = params;
+    if( !___bench_ring_wait_start( thread ) ) {
+        return 0;
+    }
+    for( usize i = 0; i < thread->count; ++i ) {
+        while( !___bench_ring_push( thread->kind, thread->ring, i ) ) {
+            cpu_pause();
+        }
+    }
+    interlocked_increment( thread->done );
+    return 0;
+}
+internal int ___bench_ring_consumer( void* params ) {
+    BenchRingThread* thread = params;
+    if( !___bench_ring_wait_start( thread ) ) {
+        return 0;
+    }
+    u64 sum = 0;
+    for( usize i = 0; i < thread->count; ++i ) {
+        u64 item = 0;
+        while( !___bench_ring_pop( thread->kind, thread->ring, &item ) ) {
+            cpu_pause();
+        }
+        sum += item;
+    }
+    thread->sum = sum;
+    interlocked_increment( thread->done );
+    return 0;
+}
+
+internal f64 ___bench_ring_threads(
+    BenchRingKind kind, void* ring,
+    usize producer_count, usize consumer_count, u64* out_sum
+) {
+    BenchRingThread threads[BENCH_RING_MAX_THREADS * 2] = {};
+    volatile u32 start = BENCH_RING_START_WAIT;
+    volatile u32 done  = 0;
+
+    usize thread_count = producer_count + consumer_count;
+    for( usize i = 0; i < thread_count; ++i ) {
+        b32 is_producer = i < producer_count;
+
+        BenchRingThread* thread = threads + i;
+        thread->kind  = kind;
+        thread->ring  = ring;
+        thread->count = is_producer ?
+            BENCH_RING_ITEM_COUNT / producer_count :
+            BENCH_RING_ITEM_COUNT / consumer_count;
+        thread->start = &start;
+        thread->done  = &done;
+        if( !thread_create(
+            is_producer ? ___bench_ring_producer : ___bench_ring_consumer, thread
+        ) ) {
+            println_err( "failed to create benchmark thread!" );
+            // NOTE(alicia): threads that did start point at this
+            // stack frame, wait for them to leave before returning.
+            interlocked_exchange( &start, BENCH_RING_START_CANCEL );
+            while( done != i ) {
+                thread_sleep( 1 );
+            }
+            return 0.0;
+        }
+    }
+
+    f64 start_seconds = bench_time_seconds();
+    interlocked_exchange( &start, BENCH_RING_START_RUN );
+    while( done != thread_count ) {
+        thread_sleep( 1 );
+    }
+    f64 seconds = bench_time_seconds() - start_seconds;
+
+    u64 sum = 0;
+    for( usize i = producer_count; i < thread_count; ++i ) {
+        sum += threads[i].sum;
+    }
+    *out_sum = sum;
+    return seconds;
+}
+
+void benchmark_ring(void) {
+    struct { usize producers; usize consumers; } configs[] = {
+        { 1, 1 }, { 1, 4 }, { 4, 1 }, { 2, 2 }, { 4, 4 },
+    };
+
+    usize spsc_size = ring_spsc_memory_requirement( BENCH_RING_CAPACITY, sizeof(u64) );
+    usize mpmc_size = ring_mpmc_memory_requirement( BENCH_RING_CAPACITY, sizeof(u64) );
+
+    void* spsc_buffer = system_alloc( spsc_size );
+    void* mpmc_buffer = system_alloc( mpmc_size );
+    BenchMutexRing* mutex_ring = system_alloc( sizeof(BenchMutexRing) );
+    if( !spsc_buffer || !mpmc_buffer || !mutex_ring ) {
+        println_err( "failed to allocate benchmark memory!" );
+        return;
+    }
+    if( !mutex_create( &mutex_ring->lock ) ) {
+        println_err( "failed to create benchmark mutex!" );
+        return;
+    }
+
+    for( usize i = 0; i < static_array_count( configs ); ++i ) {
+        usize producers = configs[i].producers;
+        usize consumers = configs[i].consumers;
+        u64 sum = 0;
+
+        println( "  {usize} producer(s), {usize} consumer(s):", producers, consumers );
+
+        mutex_ring->head = mutex_ring->tail = 0;
+        f64 mutex_seconds = ___bench_ring_threads(
+            BENCH_RING_KIND_MUTEX, mutex_ring, producers, consumers, &sum );
+        if( mutex_seconds == 0.0 ) {
+            break;
+        }
+        bench_report( "mutex ring", BENCH_RING_ITEM_COUNT, mutex_seconds );
+
+        if( producers == 1 && consumers == 1 ) {
+            RingSPSC* spsc = ring_spsc_create(
+                BENCH_RING_CAPACITY, sizeof(u64), spsc_buffer );
+            f64 spsc_seconds = ___bench_ring_threads(
+                BENCH_RING_KIND_SPSC, spsc, producers, consumers, &sum );
+            if( spsc_seconds == 0.0 ) {
+                break;
+            }
+            bench_report( "spsc ring ", BENCH_RING_ITEM_COUNT, spsc_seconds );
+        }
+
+        RingMPMC* mpmc = ring_mpmc_create(
+            BENCH_RING_CAPACITY, sizeof(u64), mpmc_buffer );
+        f64 mpmc_seconds = ___bench_ring_threads(
+            BENCH_RING_KIND_MPMC, mpmc, producers, consumers, &sum );
+        if( mpmc_seconds == 0.0 ) {
+            break;
+        }
+        bench_report( "mpmc ring ", BENCH_RING_ITEM_COUNT, mpmc_seconds );
+
+        println(
+            "    mpmc speedup: {f,.2}x, checksum: {u64}",
+            mutex_seconds / mpmc_seconds, sum );
+    }
+
+    mutex_destroy( &mutex_ring->lock );
+    system_free( mutex_ring, sizeof(BenchMutexRing) );
+    system_free( mpmc_buffer, mpmc_size );
+    system_free( spsc_buffer, spsc_size );
+}
+
+#undef BENCH_RING_CAPACITY
+#undef BENCH_RING_ITEM_COUNT
+#undef BENCH_RING_MAX_THREADS
+#undef BENCH_RING_START_WAIT
+#undef BENCH_RING_START_RUN
+#undef BENCH_RING_START_CANCEL
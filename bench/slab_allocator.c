@@ -0,0 +1,142 @@
+/**
+ * Description:  Slab allocator benchmark.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "core/memory.h"
+#include "core/rand.h"
+#include "core/sync.h"
+#include "core/thread.h"
+
+#include "bench/bench.h"
+
+#define BENCH_SLAB_MAX_LIVE        (512)
+#define BENCH_SLAB_OPERATION_COUNT (400000)
+#define BENCH_SLAB_MAX_SIZE        (256)
+#define BENCH_SLAB_MAX_THREADS     (16)
+
+typedef struct BenchSlabLive {
+    void* memory;
+    usize size;
+} BenchSlabLive;
+
+typedef struct BenchSlabThread {
+    SlabAllocator* allocator;
+    usize          thread_index;
+    u32            seed;
+    volatile u32*  start;
+    volatile u32*  done;
+} BenchSlabThread;
+
+#define ___bench_slab_run( alloc_expr, free_expr ) do {\
+    BenchSlabLive slots[BENCH_SLAB_MAX_LIVE] = {};\
+    RandState state = rand_init_state( thread->seed );\
+    usize live = 0;\
+    while( !*thread->start ) {\
+        cpu_pause();\
+    }\
+    for( usize i = 0; i < BENCH_SLAB_OPERATION_COUNT; ++i ) {\
+        u32 roll = rand_xor_u32_state( &state );\
+        if( !live || ( ( roll & 1 ) && live < BENCH_SLAB_MAX_LIVE ) ) {\
+            usize size = ( ( roll >> 1 ) % BENCH_SLAB_MAX_SIZE ) + 1;\
+            BenchSlabLive* slot = slots + live++;\
+            slot->memory = alloc_expr;\
+            slot->size   = size;\
+        } else {\
+            BenchSlabLive* slot = slots + ( ( roll >> 1 ) % live );\
+            void* memory = slot->memory;\
+            usize size   = slot->size;\
+            free_expr;\
+            *slot = slots[--live];\
+        }\
+    }\
+    for( usize i = 0; i < live; ++i ) {\
+        void* memory = slots[i].memory;\
+        usize size   = slots[i].size;\
+        free_expr;\
+    }\
+    interlocked_increment( thread->done );\
+} while(0)
+
+internal int ___bench_slab_thread( void* params ) {
+    BenchSlabThread* thread = params;
+    ___bench_slab_run(
+        slab_allocator_alloc( thread->allocator, thread->thread_index, size ),
+        slab_allocator_free(
+            thread->allocator, thread->thread_index, memory, size ) );
+    return 0;
+}
+internal int ___bench_system_thread( void* params ) {
+    BenchSlabThread* thread = params;
+    ___bench_slab_run( system_alloc( size ), system_free( memory, size ) );
+    return 0;
+}
+
+internal f64 ___bench_slab_threads(
+    ThreadProcFN* proc, SlabAllocator* allocator, usize thread_count
+) {
+    BenchSlabThread threads[BENCH_SLAB_MAX_THREADS] = {};
+    volatile u32 start = 0;
+    volatile u32 done  = 0;
+
+    for( usize i = 0; i < thread_count; ++i ) {
+        BenchSlabThread* thread = threads + i;
+        thread->allocator    = allocator;
+        thread->thread_index = i;
+        thread->seed         = 1234 + (u32)i;
+        thread->start        = &start;
+        thread->done         = &done;
+        if( !thread_create( proc, thread ) ) {
+            println_err( "failed to create benchmark thread!" );
+            return 0.0;
+        }
+    }
+
+    f64 start_seconds = bench_time_seconds();
+    interlocked_exchange( &start, 1 );
+    while( done != thread_count ) {
+        thread_sleep( 1 );
+    }
+    return bench_time_seconds() - start_seconds;
+}
+
+void benchmark_slab_allocator(void) {
+    usize thread_counts[] = { 1, 4, BENCH_SLAB_MAX_THREADS };
+
+    usize buffer_size =
+        slab_allocator_memory_requirement( BENCH_SLAB_MAX_THREADS );
+    void* buffer = system_alloc( buffer_size );
+    if( !buffer ) {
+        println_err( "failed to allocate benchmark memory!" );
+        return;
+    }
+
+    for( usize i = 0; i < static_array_count( thread_counts ); ++i ) {
+        usize thread_count = thread_counts[i];
+        usize op_count     = thread_count * BENCH_SLAB_OPERATION_COUNT;
+
+        println( "  {usize} thread(s):", thread_count );
+
+        f64 system_seconds =
+            ___bench_slab_threads( ___bench_system_thread, NULL, thread_count );
+        bench_report( "system_alloc", op_count, system_seconds );
+
+        SlabAllocator* allocator =
+            slab_allocator_create( BENCH_SLAB_MAX_THREADS, buffer );
+        f64 slab_seconds =
+            ___bench_slab_threads( ___bench_slab_thread, allocator, thread_count );
+        bench_report( "slab_allocator", op_count, slab_seconds );
+        slab_allocator_destroy( allocator );
+
+        println( "    speedup: {f,.2}x", system_seconds / slab_seconds );
+    }
+
+    system_free( buffer, buffer_size );
+}
+
+#undef ___bench_slab_run
+#undef BENCH_SLAB_MAX_LIVE
+#undef BENCH_SLAB_OPERATION_COUNT
+#undef BENCH_SLAB_MAX_SIZE
+#undef BENCH_SLAB_MAX_THREADS
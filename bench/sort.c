@@ -0,0 +1,300 @@
+/**
+ * Description:  Sorting benchmark.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "core/memory.h"
+#include "core/sort.h"
+#include "core/rand.h"
+#include "core/jobs.h"
+#include "core/system.h"
+
+#include "bench/bench.h"
+
+#define BENCH_SORT_COUNT (20000)
+
+/// Element roughly the size of a small render command.
+typedef struct BenchSortItem {
+    u32 key;
+    u32 id;
+    u64 payload;
+} BenchSortItem;
+
+internal b32 ___bench_sort_lt( void* lhs, void* rhs, void* params ) {
+    unused(params);
+    return ((BenchSortItem*)lhs)->key < ((BenchSortItem*)rhs)->key;
+}
+internal void ___bench_sort_swap( void* lhs, void* rhs ) {
+    BenchSortItem* a = lhs;
+    BenchSortItem* b = rhs;
+    BenchSortItem  temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+// NOTE(alicia): copy of sorting_quicksort from before it was replaced
+// with pattern-defeating quicksort, only used for comparison.
+internal isize legacy_quicksort_partition(
+    isize low, isize high, usize element_size, void* buffer,
+    SortLTFN* lt, void* opt_lt_params, SortSwapFN* swap_
+) {
+    u8* buf = buffer;
+    void* pivot = buf + (high * element_size);
+
+    isize i = (isize)low - 1;
+
+    for( isize j = (isize)low; j <= (isize)high - 1; ++j ) {
+        void* at_j = buf + (j * element_size);
+
+        if( lt( at_j, pivot, opt_lt_params ) ) {
+            ++i;
+            void* at_i = buf + (i * element_size);
+            swap_( at_i, at_j );
+        }
+    }
+
+    swap_( buf + ((i + 1) * element_size), buf + (high * element_size) );
+    return i + 1;
+}
+internal void legacy_quicksort(
+    isize low, isize high, usize element_size, void* buffer,
+    SortLTFN* lt, void* opt_lt_params, SortSwapFN* swap_
+) {
+    while( low < high ) {
+        isize partition_index = legacy_quicksort_partition(
+            low, high, element_size,
+            buffer, lt, opt_lt_params, swap_ );
+        if( partition_index - low < high - partition_index ) {
+            legacy_quicksort(
+                low, partition_index - 1, element_size,
+                buffer, lt, opt_lt_params, swap_ );
+            low = partition_index + 1;
+        } else {
+            legacy_quicksort(
+                partition_index + 1, high, element_size,
+                buffer, lt, opt_lt_params, swap_ );
+            high = partition_index - 1;
+        }
+    }
+}
+
+typedef enum BenchSortPattern : u32 {
+    BENCH_SORT_PATTERN_RANDOM,
+    BENCH_SORT_PATTERN_SORTED,
+    BENCH_SORT_PATTERN_REVERSED,
+    BENCH_SORT_PATTERN_FEW_UNIQUE,
+
+    BENCH_SORT_PATTERN_COUNT
+} BenchSortPattern;
+
+internal const char* ___bench_sort_pattern_to_cstr( BenchSortPattern pattern ) {
+    switch( pattern ) {
+        case BENCH_SORT_PATTERN_RANDOM:     return "random";
+        case BENCH_SORT_PATTERN_SORTED:     return "sorted";
+        case BENCH_SORT_PATTERN_REVERSED:   return "reversed";
+        case BENCH_SORT_PATTERN_FEW_UNIQUE: return "few unique";
+        case BENCH_SORT_PATTERN_COUNT: break;
+    }
+    return "unknown";
+}
+
+internal void ___bench_sort_fill(
+    BenchSortPattern pattern, usize count, BenchSortItem* items
+) {
+    RandState state = rand_init_state( 1234 );
+    for( usize i = 0; i < count; ++i ) {
+        u32 key = 0;
+        switch( pattern ) {
+            case BENCH_SORT_PATTERN_RANDOM:
+                key = rand_xor_u32_state( &state );
+                break;
+            case BENCH_SORT_PATTERN_SORTED:
+                key = (u32)i;
+                break;
+            case BENCH_SORT_PATTERN_REVERSED:
+                key = (u32)( count - i );
+                break;
+            case BENCH_SORT_PATTERN_FEW_UNIQUE:
+                key = rand_xor_u32_state( &state ) % 8;
+                break;
+            case BENCH_SORT_PATTERN_COUNT: break;
+        }
+        items[i].key     = key;
+        items[i].id      = (u32)i;
+        items[i].payload = i;
+    }
+}
+internal b32 ___bench_sort_is_sorted( usize count, BenchSortItem* items ) {
+    for( usize i = 1; i < count; ++i ) {
+        if( items[i].key < items[i - 1].key ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void benchmark_sort(void) {
+    usize size = sizeof(BenchSortItem) * BENCH_SORT_COUNT;
+    BenchSortItem* items = system_alloc( size );
+    if( !items ) {
+        println_err( "failed to allocate benchmark memory!" );
+        return;
+    }
+
+    for( BenchSortPattern pattern = 0; pattern < BENCH_SORT_PATTERN_COUNT; ++pattern ) {
+        println( "  {usize} items, {cc}:",
+            (usize)BENCH_SORT_COUNT, ___bench_sort_pattern_to_cstr( pattern ) );
+
+        ___bench_sort_fill( pattern, BENCH_SORT_COUNT, items );
+        f64 start = bench_time_seconds();
+        legacy_quicksort(
+            0, BENCH_SORT_COUNT - 1, sizeof(BenchSortItem), items,
+            ___bench_sort_lt, NULL, ___bench_sort_swap );
+        f64 legacy_seconds = bench_time_seconds() - start;
+        b32 sorted = ___bench_sort_is_sorted( BENCH_SORT_COUNT, items );
+
+        ___bench_sort_fill( pattern, BENCH_SORT_COUNT, items );
+        start = bench_time_seconds();
+        sorting_quicksort(
+            0, BENCH_SORT_COUNT - 1, sizeof(BenchSortItem), items,
+            ___bench_sort_lt, NULL, ___bench_sort_swap );
+        f64 swap_seconds = bench_time_seconds() - start;
+        sorted = sorted && ___bench_sort_is_sorted( BENCH_SORT_COUNT, items );
+
+        ___bench_sort_fill( pattern, BENCH_SORT_COUNT, items );
+        start = bench_time_seconds();
+        sorting_quicksort(
+            0, BENCH_SORT_COUNT - 1, sizeof(BenchSortItem), items,
+            ___bench_sort_lt, NULL, NULL );
+        f64 seconds = bench_time_seconds() - start;
+        sorted = sorted && ___bench_sort_is_sorted( BENCH_SORT_COUNT, items );
+
+        bench_report( "lomuto quicksort  ", BENCH_SORT_COUNT, legacy_seconds );
+        bench_report( "pdqsort swap fn   ", BENCH_SORT_COUNT, swap_seconds );
+        bench_report( "pdqsort in place  ", BENCH_SORT_COUNT, seconds );
+        println(
+            "    speedup: {f,.2}x, sorted: {b}",
+            legacy_seconds / seconds, sorted );
+    }
+
+    system_free( items, size );
+}
+
+internal b32 ___bench_sort_key_lt( void* lhs, void* rhs, void* params ) {
+    unused(params);
+    return ((SortKeyU32*)lhs)->key < ((SortKeyU32*)rhs)->key;
+}
+
+void benchmark_radix_sort(void) {
+    usize counts[] = { 1000, 10000, 100000, 1000000 };
+    usize max_count = counts[static_array_count( counts ) - 1];
+
+    usize size = sizeof(SortKeyU32) * max_count;
+    SortKeyU32* pairs   = system_alloc( size );
+    SortKeyU32* scratch = system_alloc( size );
+    if( !pairs || !scratch ) {
+        println_err( "failed to allocate benchmark memory!" );
+        return;
+    }
+
+    for( usize i = 0; i < static_array_count( counts ); ++i ) {
+        usize count = counts[i];
+        println( "  {usize} random keys:", count );
+
+        RandState state = rand_init_state( 1234 );
+        for( usize j = 0; j < count; ++j ) {
+            pairs[j].key   = rand_xor_u32_state( &state );
+            pairs[j].index = (u32)j;
+        }
+        f64 start = bench_time_seconds();
+        sorting_quicksort(
+            0, count - 1, sizeof(SortKeyU32), pairs,
+            ___bench_sort_key_lt, NULL, NULL );
+        f64 quicksort_seconds = bench_time_seconds() - start;
+
+        state = rand_init_state( 1234 );
+        for( usize j = 0; j < count; ++j ) {
+            pairs[j].key   = rand_xor_u32_state( &state );
+            pairs[j].index = (u32)j;
+        }
+        start = bench_time_seconds();
+        sorting_radix_u32( count, pairs, scratch );
+        f64 radix_seconds = bench_time_seconds() - start;
+
+        b32 sorted = true;
+        for( usize j = 1; j < count; ++j ) {
+            if( pairs[j].key < pairs[j - 1].key ) {
+                sorted = false;
+                break;
+            }
+        }
+
+        bench_report( "pdqsort   ", count, quicksort_seconds );
+        bench_report( "radix sort", count, radix_seconds );
+        println(
+            "    speedup: {f,.2}x, sorted: {b}",
+            quicksort_seconds / radix_seconds, sorted );
+    }
+
+    system_free( scratch, size );
+    system_free( pairs, size );
+}
+
+void benchmark_parallel_sort(void) {
+    usize counts[] = { 100000, 1000000, 4000000 };
+    usize max_count = counts[static_array_count( counts ) - 1];
+
+    SystemInfo system_info = {};
+    system_info_query( &system_info );
+    u32 core_count   = system_info.physical_cpu_count ?
+        system_info.physical_cpu_count : system_info.cpu_count;
+    u32 thread_count = core_count > 1 ? core_count - 1 : 1;
+
+    usize jobs_size = job_system_query_memory_requirement( thread_count );
+    usize size      = sizeof(BenchSortItem) * max_count;
+
+    void*          jobs_buffer = system_alloc( jobs_size );
+    BenchSortItem* items       = system_alloc( size );
+    if( !jobs_buffer || !items ) {
+        println_err( "failed to allocate benchmark memory!" );
+        return;
+    }
+    if( !job_system_initialize( thread_count, jobs_buffer ) ) {
+        println_err( "failed to initialize job system!" );
+        return;
+    }
+
+    for( usize i = 0; i < static_array_count( counts ); ++i ) {
+        usize count = counts[i];
+        println( "  {usize} random items, {u32} worker(s):", count, thread_count );
+
+        ___bench_sort_fill( BENCH_SORT_PATTERN_RANDOM, count, items );
+        f64 start = bench_time_seconds();
+        sorting_quicksort(
+            0, count - 1, sizeof(BenchSortItem), items,
+            ___bench_sort_lt, NULL, NULL );
+        f64 serial_seconds = bench_time_seconds() - start;
+        b32 sorted = ___bench_sort_is_sorted( count, items );
+
+        ___bench_sort_fill( BENCH_SORT_PATTERN_RANDOM, count, items );
+        start = bench_time_seconds();
+        sorting_quicksort_parallel(
+            0, 0, count - 1, sizeof(BenchSortItem), items,
+            ___bench_sort_lt, NULL, NULL );
+        f64 parallel_seconds = bench_time_seconds() - start;
+        sorted = sorted && ___bench_sort_is_sorted( count, items );
+
+        bench_report( "serial  ", count, serial_seconds );
+        bench_report( "parallel", count, parallel_seconds );
+        println(
+            "    speedup: {f,.2}x, sorted: {b}",
+            serial_seconds / parallel_seconds, sorted );
+    }
+
+    job_system_shutdown();
+    system_free( items, size );
+    system_free( jobs_buffer, jobs_size );
+}
+
+#undef BENCH_SORT_COUNT
@@ -0,0 +1,285 @@
+/**
+ * Description:  Synchronization primitives benchmark.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "shared/constants.h"
+#include "core/memory.h"
+#include "core/sync.h"
+#include "core/thread.h"
+
+#include "bench/bench.h"
+
+#define BENCH_SYNC_LOCK_COUNT      (10000000)
+#define BENCH_SYNC_PING_PONG_COUNT (100000)
+
+// NOTE(alicia): copy of platform semaphores and mutexes from before
+// sync primitives were moved to futexes, only used for comparison.
+#if defined(LD_PLATFORM_LINUX)
+    #include <stdlib.h>
+    #include <pthread.h>
+    #include <semaphore.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+
+    #define BENCH_SYNC_HAS_LEGACY
+
+internal void* ___bench_legacy_semaphore_create( const char* name ) {
+    sem_unlink( name );
+    sem_t* result = sem_open( name, O_CREAT, S_IRWXU, 0 );
+    if( result == SEM_FAILED ) {
+        return NULL;
+    }
+    return result;
+}
+internal void ___bench_legacy_semaphore_destroy( const char* name, void* semaphore ) {
+    sem_close( semaphore );
+    sem_unlink( name );
+}
+internal void ___bench_legacy_semaphore_signal( void* semaphore ) {
+    sem_post( semaphore );
+}
+internal void ___bench_legacy_semaphore_wait( void* semaphore ) {
+    sem_wait( semaphore );
+}
+internal void* ___bench_legacy_mutex_create(void) {
+    pthread_mutex_t* result = malloc( sizeof(*result) );
+    if( !result ) {
+        return NULL;
+    }
+    if( pthread_mutex_init( result, NULL ) ) {
+        free( result );
+        return NULL;
+    }
+    return result;
+}
+internal void ___bench_legacy_mutex_destroy( void* mutex ) {
+    pthread_mutex_destroy( mutex );
+    free( mutex );
+}
+internal void ___bench_legacy_mutex_lock( void* mutex ) {
+    pthread_mutex_lock( mutex );
+}
+internal void ___bench_legacy_mutex_unlock( void* mutex ) {
+    pthread_mutex_unlock( mutex );
+}
+
+#elif defined(LD_PLATFORM_WINDOWS)
+    #if !defined(NOMINMAX)
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+
+    #define BENCH_SYNC_HAS_LEGACY
+
+internal void* ___bench_legacy_semaphore_create( const char* name ) {
+    return CreateSemaphoreExA( NULL, 0, I32_MAX, name, 0, SEMAPHORE_ALL_ACCESS );
+}
+internal void ___bench_legacy_semaphore_destroy( const char* name, void* semaphore ) {
+    unused(name);
+    CloseHandle( (HANDLE)semaphore );
+}
+internal void ___bench_legacy_semaphore_signal( void* semaphore ) {
+    ReleaseSemaphore( (HANDLE)semaphore, 1, NULL );
+}
+internal void ___bench_legacy_semaphore_wait( void* semaphore ) {
+    WaitForSingleObject( (HANDLE)semaphore, INFINITE );
+}
+internal void* ___bench_legacy_mutex_create(void) {
+    return CreateMutexA( NULL, false, NULL );
+}
+internal void ___bench_legacy_mutex_destroy( void* mutex ) {
+    CloseHandle( (HANDLE)mutex );
+}
+internal void ___bench_legacy_mutex_lock( void* mutex ) {
+    WaitForSingleObject( (HANDLE)mutex, INFINITE );
+}
+internal void ___bench_legacy_mutex_unlock( void* mutex ) {
+    ReleaseMutex( (HANDLE)mutex );
+}
+
+#endif
+
+typedef enum BenchSyncKind : u32 {
+    BENCH_SYNC_KIND_FUTEX,
+    BENCH_SYNC_KIND_EVENT,
+    BENCH_SYNC_KIND_LEGACY,
+} BenchSyncKind;
+
+/// Pair of primitives threads bounce between.
+typedef struct BenchPingPong {
+    BenchSyncKind kind;
+    Semaphore     semaphores[2];
+    Event         events[2];
+    void*         legacy[2];
+    volatile u32  done;
+} BenchPingPong;
+
+internal void ___bench_ping_pong_signal( BenchPingPong* ping_pong, usize index ) {
+    switch( ping_pong->kind ) {
+        case BENCH_SYNC_KIND_FUTEX:
+            semaphore_signal( ping_pong->semaphores + index );
+            break;
+        case BENCH_SYNC_KIND_EVENT:
+            event_signal( ping_pong->events + index );
+            break;
+        case BENCH_SYNC_KIND_LEGACY:
+#if defined(BENCH_SYNC_HAS_LEGACY)
+            ___bench_legacy_semaphore_signal( ping_pong->legacy[index] );
+#endif
+            break;
+    }
+}
+internal void ___bench_ping_pong_wait( BenchPingPong* ping_pong, usize index ) {
+    switch( ping_pong->kind ) {
+        case BENCH_SYNC_KIND_FUTEX:
+            semaphore_wait( ping_pong->semaphores + index );
+            break;
+        case BENCH_SYNC_KIND_EVENT:
+            event_wait( ping_pong->events + index );
+            event_reset( ping_pong->events + index );
+            break;
+        case BENCH_SYNC_KIND_LEGACY:
+#if defined(BENCH_SYNC_HAS_LEGACY)
+            ___bench_legacy_semaphore_wait( ping_pong->legacy[index] );
+#endif
+            break;
+    }
+}
+
+internal int ___bench_ping_pong_thread( void* params ) {
+    BenchPingPong* ping_pong = params;
+    for( usize i = 0; i < BENCH_SYNC_PING_PONG_COUNT; ++i ) {
+        ___bench_ping_pong_wait( ping_pong, 0 );
+        ___bench_ping_pong_signal( ping_pong, 1 );
+    }
+    interlocked_increment( &ping_pong->done );
+    return 0;
+}
+/// Measure round trips between calling thread and a second thread.
+internal f64 ___bench_ping_pong( BenchPingPong* ping_pong ) {
+    ping_pong->done = 0;
+    if( !thread_create( ___bench_ping_pong_thread, ping_pong ) ) {
+        println_err( "failed to create benchmark thread!" );
+        return 0.0;
+    }
+
+    f64 start = bench_time_seconds();
+    for( usize i = 0; i < BENCH_SYNC_PING_PONG_COUNT; ++i ) {
+        ___bench_ping_pong_signal( ping_pong, 0 );
+        ___bench_ping_pong_wait( ping_pong, 1 );
+    }
+    f64 seconds = bench_time_seconds() - start;
+
+    while( !ping_pong->done ) {
+        thread_sleep( 1 );
+    }
+    return seconds;
+}
+
+internal void ___bench_sync_uncontended(void) {
+    println( "  uncontended:" );
+
+    Mutex mutex = {};
+    mutex_create( &mutex );
+    f64 start = bench_time_seconds();
+    for( usize i = 0; i < BENCH_SYNC_LOCK_COUNT; ++i ) {
+        mutex_lock( &mutex );
+        mutex_unlock( &mutex );
+    }
+    f64 futex_seconds = bench_time_seconds() - start;
+    mutex_destroy( &mutex );
+    bench_report( "futex mutex lock/unlock     ", BENCH_SYNC_LOCK_COUNT, futex_seconds );
+
+    Semaphore semaphore = {};
+    semaphore_create( &semaphore );
+    start = bench_time_seconds();
+    for( usize i = 0; i < BENCH_SYNC_LOCK_COUNT; ++i ) {
+        semaphore_signal( &semaphore );
+        semaphore_wait( &semaphore );
+    }
+    f64 futex_semaphore_seconds = bench_time_seconds() - start;
+    semaphore_destroy( &semaphore );
+    bench_report(
+        "futex semaphore signal/wait ", BENCH_SYNC_LOCK_COUNT, futex_semaphore_seconds );
+
+#if defined(BENCH_SYNC_HAS_LEGACY)
+    void* legacy_mutex = ___bench_legacy_mutex_create();
+    void* legacy_semaphore = ___bench_legacy_semaphore_create( "/ld_bench_sem" );
+    if( !legacy_mutex || !legacy_semaphore ) {
+        println_err( "failed to create legacy primitives!" );
+        return;
+    }
+
+    start = bench_time_seconds();
+    for( usize i = 0; i < BENCH_SYNC_LOCK_COUNT; ++i ) {
+        ___bench_legacy_mutex_lock( legacy_mutex );
+        ___bench_legacy_mutex_unlock( legacy_mutex );
+    }
+    f64 legacy_seconds = bench_time_seconds() - start;
+    ___bench_legacy_mutex_destroy( legacy_mutex );
+
+    start = bench_time_seconds();
+    for( usize i = 0; i < BENCH_SYNC_LOCK_COUNT; ++i ) {
+        ___bench_legacy_semaphore_signal( legacy_semaphore );
+        ___bench_legacy_semaphore_wait( legacy_semaphore );
+    }
+    f64 legacy_semaphore_seconds = bench_time_seconds() - start;
+    ___bench_legacy_semaphore_destroy( "/ld_bench_sem", legacy_semaphore );
+
+    bench_report( "legacy mutex lock/unlock    ", BENCH_SYNC_LOCK_COUNT, legacy_seconds );
+    bench_report(
+        "legacy semaphore signal/wait", BENCH_SYNC_LOCK_COUNT, legacy_semaphore_seconds );
+    println(
+        "    mutex speedup: {f,.2}x, semaphore speedup: {f,.2}x",
+        legacy_seconds / futex_seconds,
+        legacy_semaphore_seconds / futex_semaphore_seconds );
+#endif
+}
+
+void benchmark_sync(void) {
+    ___bench_sync_uncontended();
+
+    BenchPingPong* ping_pong = system_alloc( sizeof(BenchPingPong) );
+    if( !ping_pong ) {
+        println_err( "failed to allocate benchmark memory!" );
+        return;
+    }
+
+    // NOTE(alicia): each round trip is two wakes.
+    println( "  wake latency, {u32} round trips:", (u32)BENCH_SYNC_PING_PONG_COUNT );
+
+    ping_pong->kind = BENCH_SYNC_KIND_FUTEX;
+    f64 futex_seconds = ___bench_ping_pong( ping_pong );
+    bench_report( "futex semaphore ", BENCH_SYNC_PING_PONG_COUNT * 2, futex_seconds );
+
+    ping_pong->kind = BENCH_SYNC_KIND_EVENT;
+    f64 event_seconds = ___bench_ping_pong( ping_pong );
+    bench_report( "futex event     ", BENCH_SYNC_PING_PONG_COUNT * 2, event_seconds );
+
+#if defined(BENCH_SYNC_HAS_LEGACY)
+    ping_pong->kind      = BENCH_SYNC_KIND_LEGACY;
+    ping_pong->legacy[0] = ___bench_legacy_semaphore_create( "/ld_bench_ping" );
+    ping_pong->legacy[1] = ___bench_legacy_semaphore_create( "/ld_bench_pong" );
+    if( !ping_pong->legacy[0] || !ping_pong->legacy[1] ) {
+        println_err( "failed to create legacy primitives!" );
+        system_free( ping_pong, sizeof(BenchPingPong) );
+        return;
+    }
+    f64 legacy_seconds = ___bench_ping_pong( ping_pong );
+    ___bench_legacy_semaphore_destroy( "/ld_bench_ping", ping_pong->legacy[0] );
+    ___bench_legacy_semaphore_destroy( "/ld_bench_pong", ping_pong->legacy[1] );
+
+    bench_report( "legacy semaphore", BENCH_SYNC_PING_PONG_COUNT * 2, legacy_seconds );
+    println( "    speedup: {f,.2}x", legacy_seconds / futex_seconds );
+#endif
+
+    system_free( ping_pong, sizeof(BenchPingPong) );
+}
+
+#if defined(BENCH_SYNC_HAS_LEGACY)
+    #undef BENCH_SYNC_HAS_LEGACY
+#endif
+#undef BENCH_SYNC_LOCK_COUNT
+#undef BENCH_SYNC_PING_PONG_COUNT
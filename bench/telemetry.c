@@ -0,0 +1,95 @@
+/**
+ * Description:  Allocation telemetry benchmark.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "core/memory.h"
+#include "core/telemetry.h"
+
+#include "bench/bench.h"
+
+#define BENCH_TELEMETRY_POINTER_COUNT (4096)
+#define BENCH_TELEMETRY_ITERATION_COUNT (256)
+#define BENCH_TELEMETRY_RANGE_COUNT (64)
+#define BENCH_TELEMETRY_RANGE_OWNER (1 << 20)
+
+void benchmark_memory_telemetry(void) {
+    if( !memory_telemetry_is_enabled() ) {
+        println( "  core was built without LD_PROFILING, telemetry is disabled." );
+        return;
+    }
+
+    usize pointers_size = sizeof(void*) * BENCH_TELEMETRY_POINTER_COUNT;
+    void** pointers = system_alloc( pointers_size );
+    if( !pointers ) {
+        println_err( "failed to allocate benchmark memory!" );
+        return;
+    }
+
+    // NOTE(alicia): pointers are never dereferenced,
+    // only used as keys for telemetry.
+    for( usize i = 0; i < BENCH_TELEMETRY_POINTER_COUNT; ++i ) {
+        pointers[i] = (void*)( ( i + 1 ) * 48 );
+    }
+
+    usize op_count =
+        BENCH_TELEMETRY_POINTER_COUNT * BENCH_TELEMETRY_ITERATION_COUNT;
+
+    f64 alloc_seconds = 0.0;
+    f64 free_seconds  = 0.0;
+    for( usize iteration = 0; iteration < BENCH_TELEMETRY_ITERATION_COUNT; ++iteration ) {
+        f64 start = bench_time_seconds();
+        for( usize i = 0; i < BENCH_TELEMETRY_POINTER_COUNT; ++i ) {
+            ___internal_memory_telemetry_record_alloc(
+                MEMORY_TAG_UNKNOWN, MEMORY_ALLOCATOR_SYSTEM, NULL,
+                pointers[i], 48, __FILE__, __LINE__ );
+        }
+        f64 middle = bench_time_seconds();
+        for( usize i = 0; i < BENCH_TELEMETRY_POINTER_COUNT; ++i ) {
+            ___internal_memory_telemetry_record_free( NULL, pointers[i] );
+        }
+        f64 end = bench_time_seconds();
+
+        alloc_seconds += middle - start;
+        free_seconds  += end - middle;
+    }
+
+    bench_report( "record alloc", op_count, alloc_seconds );
+    bench_report( "record free", op_count, free_seconds );
+
+    // NOTE(alicia): range frees only walk allocations made from
+    // owners inside of range, other live allocations are not touched.
+    for( usize i = 0; i < BENCH_TELEMETRY_POINTER_COUNT; ++i ) {
+        ___internal_memory_telemetry_record_alloc(
+            MEMORY_TAG_UNKNOWN, MEMORY_ALLOCATOR_SYSTEM, NULL,
+            pointers[i], 48, __FILE__, __LINE__ );
+    }
+    u8* owner = (u8*)BENCH_TELEMETRY_RANGE_OWNER;
+    f64 range_seconds = 0.0;
+    for( usize iteration = 0; iteration < BENCH_TELEMETRY_ITERATION_COUNT; ++iteration ) {
+        for( usize i = 0; i < BENCH_TELEMETRY_RANGE_COUNT; ++i ) {
+            ___internal_memory_telemetry_record_alloc(
+                MEMORY_TAG_UNKNOWN, MEMORY_ALLOCATOR_BLOCK, owner,
+                owner + ( i * 64 ), 64, __FILE__, __LINE__ );
+        }
+        f64 start = bench_time_seconds();
+        ___internal_memory_telemetry_record_free_range(
+            owner, BENCH_TELEMETRY_RANGE_COUNT * 64 );
+        range_seconds += bench_time_seconds() - start;
+    }
+    for( usize i = 0; i < BENCH_TELEMETRY_POINTER_COUNT; ++i ) {
+        ___internal_memory_telemetry_record_free( NULL, pointers[i] );
+    }
+
+    bench_report(
+        "record free range (64 allocations, 4096 live)",
+        BENCH_TELEMETRY_ITERATION_COUNT, range_seconds );
+
+    system_free( pointers, pointers_size );
+}
+
+#undef BENCH_TELEMETRY_POINTER_COUNT
+#undef BENCH_TELEMETRY_ITERATION_COUNT
+#undef BENCH_TELEMETRY_RANGE_COUNT
+#undef BENCH_TELEMETRY_RANGE_OWNER
@@ -0,0 +1,151 @@
+#if !defined(LD_CORE_ATOMIC_H)
+#define LD_CORE_ATOMIC_H
+/**
+ * Description:  Typed atomic operations with explicit memory ordering.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+
+/// Memory ordering constraint of an atomic operation.
+typedef enum MemoryOrder : u32 {
+    /// Only guarantees atomicity, no ordering with other memory operations.
+    MEMORY_ORDER_RELAXED = __ATOMIC_RELAXED,
+    /// Loads and stores after this can't move before it.
+    /// Pairs with a release operation on another thread.
+    MEMORY_ORDER_ACQUIRE = __ATOMIC_ACQUIRE,
+    /// Loads and stores before this can't move after it.
+    MEMORY_ORDER_RELEASE = __ATOMIC_RELEASE,
+    /// Acquire and release, read-modify-write operations only.
+    MEMORY_ORDER_ACQ_REL = __ATOMIC_ACQ_REL,
+    /// Acquire and release plus single total order
+    /// with every other sequentially consistent operation.
+    MEMORY_ORDER_SEQ_CST = __ATOMIC_SEQ_CST,
+} MemoryOrder;
+
+/// Order memory operations around fence.
+/// Sequentially consistent fence is a full barrier (mfence on x86),
+/// acquire and release fences only restrict compiler on x86.
+header_only force_inline void atomic_fence( MemoryOrder order ) {
+    __atomic_thread_fence( order );
+}
+
+// NOTE(alicia): every type gets the same set of operations:
+//
+// atomic_load_T( atomic, order )
+//     Load value.
+// atomic_store_T( atomic, value, order )
+//     Store value.
+// atomic_exchange_T( atomic, value, order )
+//     Store value, returns previous value.
+// atomic_compare_exchange_T( atomic, expected, desired, success, failure )
+//     Store desired if atomic holds *expected.
+//     Returns true if successful, otherwise writes current value to expected.
+// atomic_compare_exchange_weak_T( atomic, expected, desired, success, failure )
+//     Same as above but can fail spuriously, meant for use inside of loops.
+// atomic_fetch_add_T( atomic, value, order )
+// atomic_fetch_sub_T( atomic, value, order )
+// atomic_fetch_and_T( atomic, value, order )
+// atomic_fetch_or_T( atomic, value, order )
+//     Modify value, returns previous value.
+//
+// Order should always be a constant so that builtins
+// compile down to a single instruction.
+
+#define ___atomic_define_common( suffix, type )\
+    header_only force_inline type atomic_load_##suffix(\
+        volatile type* atomic, MemoryOrder order\
+    ) {\
+        return __atomic_load_n( atomic, order );\
+    }\
+    header_only force_inline void atomic_store_##suffix(\
+        volatile type* atomic, type value, MemoryOrder order\
+    ) {\
+        __atomic_store_n( atomic, value, order );\
+    }\
+    header_only force_inline type atomic_exchange_##suffix(\
+        volatile type* atomic, type value, MemoryOrder order\
+    ) {\
+        return __atomic_exchange_n( atomic, value, order );\
+    }\
+    header_only force_inline b32 atomic_compare_exchange_##suffix(\
+        volatile type* atomic, type* expected, type desired,\
+        MemoryOrder success, MemoryOrder failure\
+    ) {\
+        return __atomic_compare_exchange_n(\
+            atomic, expected, desired, false, success, failure );\
+    }\
+    header_only force_inline b32 atomic_compare_exchange_weak_##suffix(\
+        volatile type* atomic, type* expected, type desired,\
+        MemoryOrder success, MemoryOrder failure\
+    ) {\
+        return __atomic_compare_exchange_n(\
+            atomic, expected, desired, true, success, failure );\
+    }
+
+#define ___atomic_define_integer( suffix, type )\
+    ___atomic_define_common( suffix, type )\
+    header_only force_inline type atomic_fetch_add_##suffix(\
+        volatile type* atomic, type value, MemoryOrder order\
+    ) {\
+        return __atomic_fetch_add( atomic, value, order );\
+    }\
+    header_only force_inline type atomic_fetch_sub_##suffix(\
+        volatile type* atomic, type value, MemoryOrder order\
+    ) {\
+        return __atomic_fetch_sub( atomic, value, order );\
+    }\
+    header_only force_inline type atomic_fetch_and_##suffix(\
+        volatile type* atomic, type value, MemoryOrder order\
+    ) {\
+        return __atomic_fetch_and( atomic, value, order );\
+    }\
+    header_only force_inline type atomic_fetch_or_##suffix(\
+        volatile type* atomic, type value, MemoryOrder order\
+    ) {\
+        return __atomic_fetch_or( atomic, value, order );\
+    }
+
+___atomic_define_integer( u32, u32 )
+___atomic_define_integer( i32, i32 )
+___atomic_define_integer( u64, u64 )
+___atomic_define_integer( i64, i64 )
+___atomic_define_integer( usize, usize )
+
+#undef ___atomic_define_integer
+#undef ___atomic_define_common
+
+// NOTE(alicia): pointer variants take address of any pointer sized
+// variable so that typed pointers don't have to be cast,
+// function pointers have to be cast to and from void*.
+
+/// Load pointer.
+header_only force_inline void* atomic_load_ptr(
+    volatile void* atomic, MemoryOrder order
+) {
+    return __atomic_load_n( (void* volatile*)atomic, order );
+}
+/// Store pointer.
+header_only force_inline void atomic_store_ptr(
+    volatile void* atomic, void* value, MemoryOrder order
+) {
+    __atomic_store_n( (void* volatile*)atomic, value, order );
+}
+/// Store pointer, returns previous pointer.
+header_only force_inline void* atomic_exchange_ptr(
+    volatile void* atomic, void* value, MemoryOrder order
+) {
+    return __atomic_exchange_n( (void* volatile*)atomic, value, order );
+}
+/// Store desired pointer if atomic holds expected pointer.
+/// Returns true if successful, otherwise writes current pointer to expected.
+header_only force_inline b32 atomic_compare_exchange_ptr(
+    volatile void* atomic, void* expected, void* desired,
+    MemoryOrder success, MemoryOrder failure
+) {
+    return __atomic_compare_exchange_n(
+        (void* volatile*)atomic, (void**)expected, desired,
+        false, success, failure );
+}
+
+#endif /* header guard */
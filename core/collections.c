@@ -4,130 +4,587 @@
  * File Created: May 01, 2023
 */
 #include "shared/defines.h"
+#include "shared/constants.h"
 #include "core/collections.h"
 #include "core/memory.h"
 
-#define HASHMAP_MAX_LINEAR_SEARCH (32)
-CORE_API b32 hashmap_insert_key(
-    Hashmap* hashmap, Key key, KValue value, b32 check_for_duplicate
+#if defined(LD_ARCH_X86) && LD_SIMD_WIDTH != 1
+    #include <immintrin.h>
+#endif
+
+/// Control byte of an empty slot.
+/// Occupied slots store 7 bits of hash so high bit is only set when empty.
+#define HASHMAP_CONTROL_EMPTY (0x80)
+
+internal force_inline u64 ___hashmap_hash( Key key ) {
+    // NOTE(alicia): keys are not always hashes (ids, pointers)
+    // so murmur3 finalizer spreads their bits out.
+    u64 x = key;
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    x ^= x >> 33;
+    return x;
+}
+/// Slot that probing starts from.
+internal force_inline usize ___hashmap_home( Hashmap* hashmap, u64 hash ) {
+    return (usize)( hash >> 7 ) & ( hashmap->capacity - 1 );
+}
+/// 7 bits of hash stored in control byte.
+internal force_inline u8 ___hashmap_tag( u64 hash ) {
+    return (u8)( hash & 0x7F );
+}
+/// Match control bytes in group equal to value.
+/// Returns bitmask, bit n is set if control byte n matched.
+internal force_inline u32 ___hashmap_group_match( const u8* group, u8 value ) {
+#if defined(LD_ARCH_X86) && LD_SIMD_WIDTH != 1
+    __m128i control = _mm_loadu_si128( (const __m128i*)group );
+    return (u32)_mm_movemask_epi8(
+        _mm_cmpeq_epi8( control, _mm_set1_epi8( (char)value ) ) );
+#else
+    u32 result = 0;
+    for( u32 i = 0; i < HASHMAP_GROUP_WIDTH; ++i ) {
+        result |= (u32)( group[i] == value ) << i;
+    }
+    return result;
+#endif
+}
+/// Match empty control bytes in group.
+/// Returns bitmask, bit n is set if control byte n is empty.
+internal force_inline u32 ___hashmap_group_match_empty( const u8* group ) {
+#if defined(LD_ARCH_X86) && LD_SIMD_WIDTH != 1
+    return (u32)_mm_movemask_epi8( _mm_loadu_si128( (const __m128i*)group ) );
+#else
+    u32 result = 0;
+    for( u32 i = 0; i < HASHMAP_GROUP_WIDTH; ++i ) {
+        result |= (u32)( group[i] >> 7 ) << i;
+    }
+    return result;
+#endif
+}
+internal force_inline void ___hashmap_set_control(
+    Hashmap* hashmap, usize index, u8 control
 ) {
-    if( check_for_duplicate ) {
-        if( hashmap_contains_key( hashmap, key ) ) {
-            return true;
+    // NOTE(alicia): first group is mirrored after the last slot
+    // so that groups can be loaded without wrapping around.
+    // For index >= HASHMAP_GROUP_WIDTH this writes the same byte twice.
+    hashmap->control[index] = control;
+    hashmap->control[
+        ( ( index - HASHMAP_GROUP_WIDTH ) & ( hashmap->capacity - 1 ) ) +
+        HASHMAP_GROUP_WIDTH ] = control;
+}
+internal force_inline void* ___hashmap_value( Hashmap* hashmap, usize index ) {
+    return (u8*)hashmap->values + ( index * hashmap->value_size );
+}
+/// Find slot of key.
+/// Returns false if key is not in hashmap,
+/// out_index is then set to the first empty slot in key's probe sequence.
+internal b32 ___hashmap_find( Hashmap* hashmap, Key key, usize* out_index ) {
+    u64   hash     = ___hashmap_hash( key );
+    u8    tag      = ___hashmap_tag( hash );
+    usize mask     = hashmap->capacity - 1;
+    usize position = ___hashmap_home( hashmap, hash );
+
+    // NOTE(alicia): items are always placed in the first empty slot
+    // after their home slot and removal shifts items back
+    // so probing can stop at the first empty slot.
+    for( ;; ) {
+        const u8* group = hashmap->control + position;
+
+        u32 empty   = ___hashmap_group_match_empty( group );
+        u32 window  = empty ? ( ( empty & ( ~empty + 1 ) ) - 1 ) : 0xFFFF;
+        u32 matches = ___hashmap_group_match( group, tag ) & window;
+        while( matches ) {
+            usize index = ( position + (usize)__builtin_ctz( matches ) ) & mask;
+            if( hashmap->keys[index] == key ) {
+                *out_index = index;
+                return true;
+            }
+            matches &= matches - 1;
         }
-    }
 
-    if( hashmap->count == hashmap->capacity ) {
-        return false;
+        if( empty ) {
+            *out_index = ( position + (usize)__builtin_ctz( empty ) ) & mask;
+            return false;
+        }
+        position = ( position + HASHMAP_GROUP_WIDTH ) & mask;
     }
+}
 
-    if( !hashmap->count || key > hashmap->largest_key ) {
-        goto hashmap_insert_push;
-    }
+CORE_API usize hashmap_memory_requirement( usize capacity, usize value_size ) {
+    return
+        ( capacity + HASHMAP_GROUP_WIDTH ) +
+        ( capacity * sizeof(Key) ) +
+        ( capacity * value_size );
+}
+CORE_API Hashmap hashmap_create( usize capacity, usize value_size, void* buffer ) {
+    assert( capacity >= HASHMAP_GROUP_WIDTH );
+    assert( ( capacity & ( capacity - 1 ) ) == 0 );
+
+    // NOTE(alicia): capacity is a multiple of group width
+    // so keys and values stay aligned to 16 bytes if buffer is.
+    Hashmap result    = {};
+    result.control    = buffer;
+    result.keys       = (Key*)( result.control + capacity + HASHMAP_GROUP_WIDTH );
+    result.values     = result.keys + capacity;
+    result.value_size = value_size;
+    result.capacity   = capacity;
+
+    hashmap_clear( &result );
+    return result;
+}
+CORE_API Hashmap hashmap_resize(
+    Hashmap* hashmap, usize new_capacity, void* new_buffer
+) {
+    assert( hashmap->count <= hashmap_max_count( new_capacity ) );
+
+    Hashmap result = hashmap_create( new_capacity, hashmap->value_size, new_buffer );
+    for( usize i = 0; i < hashmap->capacity; ++i ) {
+        if( hashmap->control[i] & HASHMAP_CONTROL_EMPTY ) {
+            continue;
+        }
+        Key key = hashmap->keys[i];
 
+        // NOTE(alicia): keys are unique so only an empty slot is needed.
+        usize index = 0;
+        ___hashmap_find( &result, key, &index );
+
+        ___hashmap_set_control( &result, index, hashmap->control[i] );
+        result.keys[index] = key;
+        memory_copy(
+            ___hashmap_value( &result, index ),
+            ___hashmap_value( hashmap, i ), hashmap->value_size );
+        result.count++;
+    }
+    return result;
+}
+CORE_API b32 hashmap_insert( Hashmap* hashmap, Key key, const void* value ) {
     usize index = 0;
-    if( key > hashmap->keys[0] ) {
-        if( hashmap->count < HASHMAP_MAX_LINEAR_SEARCH ) {
-            usize i = hashmap->count;
-            do {
-                i--;
-                Key k = hashmap->keys[i];
-                if( key > k ) {
-                    index = i + 1;
-                    break;
-                }
-            } while( i );
-        } else {
-            // binary tree approach, maybe faster than linear lookup
-            usize low  = 0;
-            usize high = hashmap->count;
-            while( low < high ) {
-                usize mid = ( low + high ) >> 1;
-                if( hashmap->keys[mid] < key ) {
-                    low = mid + 1;
-                } else {
-                    high = mid;
-                }
-            }
-            index = low;
+    if( !___hashmap_find( hashmap, key, &index ) ) {
+        if( hashmap_is_full( hashmap ) ) {
+            return false;
         }
+        ___hashmap_set_control(
+            hashmap, index, ___hashmap_tag( ___hashmap_hash( key ) ) );
+        hashmap->keys[index] = key;
+        hashmap->count++;
     }
 
-    usize copy_count = hashmap->count - index;
-    if( copy_count ) {
-        usize copy_size  = copy_count * sizeof(Key);
-        memory_copy_overlapped(
-            hashmap->keys + index + 1, hashmap->keys + index, copy_size );
-        hashmap->keys[index] = key;
+    memory_copy( ___hashmap_value( hashmap, index ), value, hashmap->value_size );
+    return true;
+}
+CORE_API void* hashmap_get( Hashmap* hashmap, Key key ) {
+    usize index = 0;
+    if( !hashmap->count || !___hashmap_find( hashmap, key, &index ) ) {
+        return NULL;
+    }
+    return ___hashmap_value( hashmap, index );
+}
+CORE_API void hashmap_remove_by_index(
+    Hashmap* hashmap, usize index, void* opt_out_value
+) {
+    assert( index < hashmap->capacity );
+    assert( !( hashmap->control[index] & HASHMAP_CONTROL_EMPTY ) );
 
-        copy_size = copy_count * sizeof(KValue);
-        memory_copy_overlapped(
-            hashmap->values + index + 1, hashmap->values + index, copy_size );
-        hashmap->values[index] = value;
+    if( opt_out_value ) {
+        memory_copy(
+            opt_out_value, ___hashmap_value( hashmap, index ), hashmap->value_size );
+    }
 
-        hashmap->count++;
+    // NOTE(alicia): backward shift deletion.
+    // Items that follow the hole in the same probe run are moved
+    // into it if the hole is between their home slot and current slot,
+    // that way lookups never have to skip over tombstones.
+    usize mask = hashmap->capacity - 1;
+    usize hole = index;
+    usize next = ( hole + 1 ) & mask;
+    while( !( hashmap->control[next] & HASHMAP_CONTROL_EMPTY ) ) {
+        usize home = ___hashmap_home(
+            hashmap, ___hashmap_hash( hashmap->keys[next] ) );
+
+        if( ( ( next - home ) & mask ) >= ( ( next - hole ) & mask ) ) {
+            ___hashmap_set_control( hashmap, hole, hashmap->control[next] );
+            hashmap->keys[hole] = hashmap->keys[next];
+            memory_copy(
+                ___hashmap_value( hashmap, hole ),
+                ___hashmap_value( hashmap, next ), hashmap->value_size );
+            hole = next;
+        }
+        next = ( next + 1 ) & mask;
+    }
 
-        if( key > hashmap->largest_key ) {
-            hashmap->largest_key = key;
+    ___hashmap_set_control( hashmap, hole, HASHMAP_CONTROL_EMPTY );
+    hashmap->count--;
+}
+CORE_API b32 hashmap_next(
+    Hashmap* hashmap, usize* cursor, Key* out_key, void** out_value
+) {
+    for( usize i = *cursor; i < hashmap->capacity; ++i ) {
+        if( hashmap->control[i] & HASHMAP_CONTROL_EMPTY ) {
+            continue;
         }
+        *cursor    = i + 1;
+        *out_key   = hashmap->keys[i];
+        *out_value = ___hashmap_value( hashmap, i );
+        return true;
+    }
+    *cursor = hashmap->capacity;
+    return false;
+}
+CORE_API void hashmap_clear( Hashmap* hashmap ) {
+    memory_set(
+        hashmap->control, HASHMAP_CONTROL_EMPTY,
+        hashmap->capacity + HASHMAP_GROUP_WIDTH );
+    hashmap->count = 0;
+}
+
+#undef HASHMAP_CONTROL_EMPTY
+
+/// Marks the end of slot map free list.
+#define SLOT_MAP_FREE_END (U32_MAX)
+
+internal force_inline SlotHandle ___slot_map_handle( u32 index, u32 generation ) {
+    return ( generation << SLOT_MAP_INDEX_BITS ) | index;
+}
+internal force_inline u32 ___slot_map_next_generation( u32 generation ) {
+    // NOTE(alicia): generation 0 is skipped when it wraps
+    // so that SLOT_HANDLE_NULL is never handed out.
+    u32 result = ( generation + 1 ) & ( U32_MAX >> SLOT_MAP_INDEX_BITS );
+    return result ? result : 1;
+}
+internal force_inline usize ___slot_map_items_size( usize capacity, usize item_size ) {
+    // NOTE(alicia): keep slots aligned regardless of item size.
+    return ( ( capacity * item_size ) + 7 ) & ~(usize)7;
+}
+internal force_inline void* ___slot_map_item( SlotMap* map, u32 dense_index ) {
+    return (u8*)map->items + ( (usize)dense_index * map->item_size );
+}
+
+CORE_API usize slot_map_memory_requirement( usize capacity, usize item_size ) {
+    return
+        ___slot_map_items_size( capacity, item_size ) +
+        ( capacity * sizeof(SlotMapSlot) ) +
+        ( capacity * sizeof(u32) );
+}
+CORE_API SlotMap slot_map_create( usize capacity, usize item_size, void* buffer ) {
+    assert( capacity <= SLOT_MAP_MAX_CAPACITY );
+
+    SlotMap result     = {};
+    result.items       = buffer;
+    result.slots       = (SlotMapSlot*)(
+        (u8*)buffer + ___slot_map_items_size( capacity, item_size ) );
+    result.dense_slots = (u32*)( result.slots + capacity );
+    result.item_size   = item_size;
+    result.capacity    = (u32)capacity;
+    result.free_slot   = SLOT_MAP_FREE_END;
+    return result;
+}
+CORE_API SlotHandle slot_map_insert( SlotMap* map, const void* opt_item ) {
+    if( slot_map_is_full( map ) ) {
+        return SLOT_HANDLE_NULL;
+    }
+
+    // NOTE(alicia): slots are handed out in order until every slot
+    // has been used once, that way buffer doesn't have to be
+    // initialized up front.
+    u32 slot_index = 0;
+    if( map->free_slot != SLOT_MAP_FREE_END ) {
+        slot_index     = map->free_slot;
+        map->free_slot = map->slots[slot_index].index;
     } else {
-hashmap_insert_push:
-        hashmap->keys[hashmap->count]     = key;
-        hashmap->values[hashmap->count++] = value;
-        if( key > hashmap->largest_key ) {
-            hashmap->largest_key = key;
-        }
+        slot_index = map->slot_count++;
+        map->slots[slot_index].generation = 1;
     }
 
-    return true;
+    u32 dense_index = map->count++;
+
+    SlotMapSlot* slot = map->slots + slot_index;
+    slot->index = dense_index;
+    map->dense_slots[dense_index] = slot_index;
+
+    void* item = ___slot_map_item( map, dense_index );
+    if( opt_item ) {
+        memory_copy( item, opt_item, map->item_size );
+    } else {
+        memory_zero( item, map->item_size );
+    }
+
+    return ___slot_map_handle( slot_index, slot->generation );
 }
-CORE_API KValue* hashmap_get( Hashmap* hashmap, Key key ) {
-    if( !hashmap->count || key > hashmap->largest_key ) {
+CORE_API void* slot_map_get( SlotMap* map, SlotHandle handle ) {
+    u32 slot_index = slot_handle_index( handle );
+    if( slot_index >= map->slot_count ) {
+        return NULL;
+    }
+    SlotMapSlot* slot = map->slots + slot_index;
+    if( slot->generation != slot_handle_generation( handle ) ) {
         return NULL;
     }
+    return ___slot_map_item( map, slot->index );
+}
+CORE_API b32 slot_map_remove(
+    SlotMap* map, SlotHandle handle, void* opt_out_item
+) {
+    u32 slot_index = slot_handle_index( handle );
+    if( slot_index >= map->slot_count ) {
+        return false;
+    }
+    SlotMapSlot* slot = map->slots + slot_index;
+    if( slot->generation != slot_handle_generation( handle ) ) {
+        return false;
+    }
 
-    if( hashmap->count < HASHMAP_MAX_LINEAR_SEARCH ) {
-        for( usize i = 0; i < hashmap->count; ++i ) {
-            if( hashmap->keys[i] == key ) {
-                return hashmap->values + i;
-            }
+    void* item = ___slot_map_item( map, slot->index );
+    if( opt_out_item ) {
+        memory_copy( opt_out_item, item, map->item_size );
+    }
+
+    // NOTE(alicia): last item is moved into the hole
+    // so that items stay densely packed.
+    u32 last_index = --map->count;
+    if( slot->index != last_index ) {
+        u32 last_slot = map->dense_slots[last_index];
+        memory_copy( item, ___slot_map_item( map, last_index ), map->item_size );
+        map->dense_slots[slot->index] = last_slot;
+        map->slots[last_slot].index   = slot->index;
+    }
+
+    slot->generation = ___slot_map_next_generation( slot->generation );
+    slot->index      = map->free_slot;
+    map->free_slot   = slot_index;
+    return true;
+}
+CORE_API SlotHandle slot_map_handle_from_dense_index( SlotMap* map, usize index ) {
+    assert( index < map->count );
+    u32 slot_index = map->dense_slots[index];
+    return ___slot_map_handle( slot_index, map->slots[slot_index].generation );
+}
+CORE_API void slot_map_clear( SlotMap* map ) {
+    // NOTE(alicia): every used slot goes back to free list,
+    // live slots get a new generation to invalidate their handles.
+    for( u32 i = 0; i < map->count; ++i ) {
+        SlotMapSlot* slot = map->slots + map->dense_slots[i];
+        slot->generation = ___slot_map_next_generation( slot->generation );
+    }
+    map->free_slot = SLOT_MAP_FREE_END;
+    for( u32 i = map->slot_count; i-- > 0; ) {
+        map->slots[i].index = map->free_slot;
+        map->free_slot      = i;
+    }
+    map->count = 0;
+}
+
+#undef SLOT_MAP_FREE_END
+
+/// Marks the end of heap handle free list.
+#define HEAP_FREE_END (U32_MAX)
+
+internal force_inline void ___heap_place( Heap* heap, u32 position, u64 priority, u32 handle ) {
+    heap->priorities[position] = priority;
+    heap->handles[position]    = handle;
+    heap->positions[handle]    = position;
+}
+internal void ___heap_sift_up( Heap* heap, u32 position ) {
+    u64 priority = heap->priorities[position];
+    u32 handle   = heap->handles[position];
+    while( position ) {
+        u32 parent = ( position - 1 ) / HEAP_ARITY;
+        if( heap->priorities[parent] <= priority ) {
+            break;
         }
-    } else {
-        usize low  = 0;
-        usize high = hashmap->count;
-        while( low < high ) {
-            usize mid = (low + high) >> 1;
-            Key k = hashmap->keys[mid];
-            if( k == key ) {
-                return hashmap->values + mid;
-            } else if( k < key ) {
-                low = mid + 1;
-            } else {
-                high = mid;
+        ___heap_place( heap, position, heap->priorities[parent], heap->handles[parent] );
+        position = parent;
+    }
+    ___heap_place( heap, position, priority, handle );
+}
+internal void ___heap_sift_down( Heap* heap, u32 position ) {
+    u64 priority = heap->priorities[position];
+    u32 handle   = heap->handles[position];
+    loop {
+        u32 first = ( position * HEAP_ARITY ) + 1;
+        if( first >= heap->count ) {
+            break;
+        }
+        u32 last = first + HEAP_ARITY;
+        if( last > heap->count ) {
+            last = heap->count;
+        }
+
+        u32 smallest = first;
+        for( u32 child = first + 1; child < last; ++child ) {
+            if( heap->priorities[child] < heap->priorities[smallest] ) {
+                smallest = child;
             }
         }
+        if( priority <= heap->priorities[smallest] ) {
+            break;
+        }
+
+        ___heap_place( heap, position, heap->priorities[smallest], heap->handles[smallest] );
+        position = smallest;
     }
-    return NULL;
+    ___heap_place( heap, position, priority, handle );
 }
-CORE_API void hashmap_remove_by_index(
-    Hashmap* hashmap, usize index, KValue* opt_out_value
+internal u32 ___heap_handle_alloc( Heap* heap ) {
+    if( heap->free_handle != HEAP_FREE_END ) {
+        u32 result = heap->free_handle;
+        heap->free_handle = heap->positions[result];
+        return result;
+    }
+    return heap->handle_count++;
+}
+/// Remove entry at heap position and return its handle to free list.
+internal void ___heap_remove_at( Heap* heap, u32 position, void* opt_out_item ) {
+    u32 handle = heap->handles[position];
+    if( opt_out_item && heap->item_size ) {
+        memory_copy( opt_out_item, heap_get( heap, handle ), heap->item_size );
+    }
+
+    u32 last = --heap->count;
+    if( position != last ) {
+        u64 removed_priority = heap->priorities[position];
+        ___heap_place( heap, position, heap->priorities[last], heap->handles[last] );
+        if( heap->priorities[position] < removed_priority ) {
+            ___heap_sift_up( heap, position );
+        } else {
+            ___heap_sift_down( heap, position );
+        }
+    }
+
+    heap->positions[handle] = heap->free_handle;
+    heap->free_handle       = handle;
+}
+
+CORE_API usize heap_memory_requirement( usize capacity, usize item_size ) {
+    // NOTE(alicia): extra cache line for aligning buffer
+    // and padding slots in front of priorities.
+    return
+        CACHE_LINE_SIZE + ( HEAP_PRIORITY_PADDING * sizeof(u64) ) +
+        ( capacity * sizeof(u64) ) +
+        ( capacity * sizeof(u32) * 2 ) +
+        ( capacity * item_size );
+}
+CORE_API Heap heap_create( usize capacity, usize item_size, void* buffer ) {
+    assert( capacity < U32_MAX );
+
+    // NOTE(alicia): children of node i are 4i+1 to 4i+4,
+    // padding priorities by 3 slots from a cache line aligned
+    // start puts every group of siblings on a 32 byte boundary.
+    Heap result         = {};
+    result.priorities   =
+        (u64*)memory_align( buffer, CACHE_LINE_SIZE ) + HEAP_PRIORITY_PADDING;
+    result.handles      = (u32*)( result.priorities + capacity );
+    result.positions    = result.handles + capacity;
+    result.items        = result.positions + capacity;
+    result.item_size    = item_size;
+    result.capacity     = (u32)capacity;
+    result.free_handle  = HEAP_FREE_END;
+    return result;
+}
+CORE_API b32 heap_heapify(
+    Heap* heap, usize count, const u64* priorities, const void* opt_items
 ) {
-    if( opt_out_value ) {
-        *opt_out_value = hashmap->values[index];
+    assert( heap_is_empty( heap ) );
+    if( count > heap->capacity ) {
+        return false;
     }
 
-    usize copy_count = hashmap->count - index;
-    usize copy_size  = copy_count * sizeof(Key);
-    memory_copy_overlapped(
-        hashmap->keys + index, hashmap->keys + index + 1, copy_size );
-    copy_size = copy_count * sizeof(KValue);
-    memory_copy_overlapped(
-        hashmap->values + index, hashmap->values + index + 1, copy_size );
+    for( u32 i = 0; i < (u32)count; ++i ) {
+        ___heap_place( heap, i, priorities[i], i );
+    }
+    if( heap->item_size ) {
+        if( opt_items ) {
+            memory_copy( heap->items, opt_items, count * heap->item_size );
+        } else {
+            memory_zero( heap->items, count * heap->item_size );
+        }
+    }
+    heap->count        = (u32)count;
+    heap->handle_count = (u32)count;
+    heap->free_handle  = HEAP_FREE_END;
+
+    // NOTE(alicia): floyd's method, sift down every parent
+    // starting from the last one.
+    if( count > 1 ) {
+        for( u32 i = ( (u32)count - 2 ) / HEAP_ARITY + 1; i-- > 0; ) {
+            ___heap_sift_down( heap, i );
+        }
+    }
+    return true;
+}
+CORE_API b32 heap_push(
+    Heap* heap, u64 priority, const void* opt_item, HeapHandle* opt_out_handle
+) {
+    if( heap_is_full( heap ) ) {
+        return false;
+    }
 
-    hashmap->count--;
+    u32 handle = ___heap_handle_alloc( heap );
+    if( heap->item_size ) {
+        if( opt_item ) {
+            memory_copy( heap_get( heap, handle ), opt_item, heap->item_size );
+        } else {
+            memory_zero( heap_get( heap, handle ), heap->item_size );
+        }
+    }
+
+    u32 position = heap->count++;
+    ___heap_place( heap, position, priority, handle );
+    ___heap_sift_up( heap, position );
+
+    if( opt_out_handle ) {
+        *opt_out_handle = handle;
+    }
+    return true;
+}
+CORE_API b32 heap_peek(
+    Heap* heap, u64* opt_out_priority, HeapHandle* opt_out_handle
+) {
+    if( heap_is_empty( heap ) ) {
+        return false;
+    }
+    if( opt_out_priority ) {
+        *opt_out_priority = heap->priorities[0];
+    }
+    if( opt_out_handle ) {
+        *opt_out_handle = heap->handles[0];
+    }
+    return true;
+}
+CORE_API b32 heap_pop( Heap* heap, u64* opt_out_priority, void* opt_out_item ) {
+    if( heap_is_empty( heap ) ) {
+        return false;
+    }
+    if( opt_out_priority ) {
+        *opt_out_priority = heap->priorities[0];
+    }
+    ___heap_remove_at( heap, 0, opt_out_item );
+    return true;
+}
+CORE_API void heap_decrease_key( Heap* heap, HeapHandle handle, u64 new_priority ) {
+    assert( handle < heap->handle_count );
+    u32 position = heap->positions[handle];
+    assert( position < heap->count && heap->handles[position] == handle );
+    assert( new_priority <= heap->priorities[position] );
+
+    heap->priorities[position] = new_priority;
+    ___heap_sift_up( heap, position );
+}
+CORE_API void heap_remove( Heap* heap, HeapHandle handle, void* opt_out_item ) {
+    assert( handle < heap->handle_count );
+    u32 position = heap->positions[handle];
+    assert( position < heap->count && heap->handles[position] == handle );
+
+    ___heap_remove_at( heap, position, opt_out_item );
+}
+CORE_API void heap_clear( Heap* heap ) {
+    heap->count        = 0;
+    heap->handle_count = 0;
+    heap->free_handle  = HEAP_FREE_END;
 }
 
-#undef HASHMAP_MAX_LINEAR_SEARCH
+#undef HEAP_FREE_END
 
 CORE_API void* iterator_next_enumerate( Iterator* iter, usize* out_enumerator ) {
     if( iter->current == iter->count ) {
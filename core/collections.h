@@ -71,7 +71,7 @@ header_only const char* kvalue_type_to_cstr( KValueType type, usize* opt_out_len
 /// Hashmap key.
 typedef u64 Key;
 
-/// Hashmap value.
+/// Key value pair value.
 typedef struct KValue {
     KValueType type;
     union {
@@ -105,13 +105,22 @@ header_only b32 kvalue_cmp( KValue a, KValue b ) {
     return a.type == b.type && a.uint64 == b.uint64;
 }
 
+/// Number of control bytes probed at once.
+#define HASHMAP_GROUP_WIDTH (16)
+/// Hashmap can be filled up to capacity * 7 / 8 items.
+#define hashmap_max_count( capacity ) ( (capacity) - ( (capacity) / 8 ) )
+
 /// Hashmap.
+/// Open addressing hash table, each slot has a control byte that holds
+/// 7 bits of the key's hash. Control bytes are probed
+/// HASHMAP_GROUP_WIDTH at a time, keys and values are stored inline.
 typedef struct Hashmap {
-    Key*    keys;
-    KValue* values;
-    usize   count;
-    usize   capacity;
-    Key     largest_key;
+    u8*   control;
+    Key*  keys;
+    void* values;
+    usize value_size;
+    usize count;
+    usize capacity;
 } Hashmap;
 
 /// Create a hashmap key from null-terminated string.
@@ -121,75 +130,52 @@ typedef struct Hashmap {
 /// Create a hashmap key from pointer to string slice.
 #define hashmap_key_string_slice( s )    cstr_hash( (s)->len, (s)->buffer )
 
-/// Calculate memory requirement of a hashmap with given capcity.
-/// Result is enough to store n number of keys and values in the same buffer.
-header_only usize hashmap_memory_requirement( usize capacity ) {
-    return capacity * sizeof(Key) + (capacity * sizeof(KValue));
-}
-/// Calculate memory requirement of a hashmap with given capcity.
-/// out_key_buffer_size is enough to store n number of keys.
-/// out_value_buffer_size is enough to store n number of values.
-/// If you want to resize the hashmap buffer,
-/// the key and value buffers need to be separate unless you manually
-/// relocate values after reallocating.
-header_only void hashmap_memory_requirement_separate(
-    usize capacity, usize* out_key_buffer_size, usize* out_value_buffer_size
-) {
-    *out_key_buffer_size   = capacity * sizeof(Key);
-    *out_value_buffer_size = capacity * sizeof(KValue);
-}
-/// Create a hashmap with a shared buffer.
-header_only Hashmap hashmap_create( usize capacity, void* buffer ) {
-    Hashmap result = {};
-    result.capacity = capacity;
-    result.keys     = (Key*)buffer;
-    result.values   = (KValue*)((u8*)buffer + (capacity * sizeof(Key)));
-    return result;
-}
-/// Create a hashmap with separate buffers for keys and values.
-header_only Hashmap hashmap_create_separate(
-    usize capacity, void* key_buffer, void* value_buffer
-) {
-    Hashmap result  = {};
-    result.capacity = capacity;
-    result.keys     = (Key*)key_buffer;
-    result.values   = (KValue*)value_buffer;
-    return result;
-}
+/// Calculate memory requirement of a hashmap.
+/// Capacity must be a power of two and at least HASHMAP_GROUP_WIDTH.
+CORE_API usize hashmap_memory_requirement( usize capacity, usize value_size );
+/// Create a hashmap.
+/// Capacity must be a power of two and at least HASHMAP_GROUP_WIDTH.
+/// Buffer must be able to hold result from hashmap_memory_requirement.
+CORE_API Hashmap hashmap_create( usize capacity, usize value_size, void* buffer );
+/// Move every item from hashmap into a new buffer.
+/// New capacity must be a power of two and large enough to hold every item.
+/// Old buffer can be freed once this function returns.
+CORE_API Hashmap hashmap_resize(
+    Hashmap* hashmap, usize new_capacity, void* new_buffer );
 /// Insert a value into hashmap using a key.
-/// Returns true if there is enough space in hashmap.
-/// If check_for_duplicate, also returns true if key already exists.
-CORE_API b32 hashmap_insert_key(
-    Hashmap* hashmap, Key key, KValue value, b32 check_for_duplicate );
-
+/// Value is copied into hashmap, if key already exists its value is overwritten.
+/// Returns false if hashmap is full.
+CORE_API b32 hashmap_insert( Hashmap* hashmap, Key key, const void* value );
 /// Get value of given key.
 /// Returns NULL if KV pair with given key doesn't exist.
-CORE_API KValue* hashmap_get( Hashmap* hashmap, Key key );
+CORE_API void* hashmap_get( Hashmap* hashmap, Key key );
 /// Get the index of the item with given key.
 header_only b32 hashmap_get_index( Hashmap* hashmap, Key key, usize* out_index ) {
-    KValue* value = hashmap_get( hashmap, key );
+    u8* value = (u8*)hashmap_get( hashmap, key );
     if( !value ) {
         return false;
     }
 
-    *out_index = value - hashmap->values;
+    assert( hashmap->value_size );
+    *out_index = (usize)( value - (u8*)hashmap->values ) / hashmap->value_size;
     return true;
 }
 /// Check if key exists in hashmap.
-/// This is the same as hashmap_get_key except it doesn't
+/// This is the same as hashmap_get except it doesn't
 /// return a pointer to the key's value.
 header_only b32 hashmap_contains_key( Hashmap* hashmap, Key key ) {
     return hashmap_get( hashmap, key ) != NULL;
 }
 /// Remove an item by its index.
-/// If opt_out_value is not null, the value at the given key is copied to it.
+/// If opt_out_value is not null, the value at the given index is copied to it.
+/// Items that follow the removed item may be moved to a different index.
 CORE_API void hashmap_remove_by_index(
-    Hashmap* hashmap, usize index, KValue* opt_out_value );
+    Hashmap* hashmap, usize index, void* opt_out_value );
 /// Attempt to remove an item by its key.
 /// Returns true if key exists in hashmap.
 /// If opt_out_value is not null, the value at the given key is copied to it.
 header_only b32 hashmap_remove(
-    Hashmap* hashmap, Key key, KValue* opt_out_value
+    Hashmap* hashmap, Key key, void* opt_out_value
 ) {
     usize index = 0;
     if( !hashmap_get_index( hashmap, key, &index ) ) {
@@ -199,19 +185,198 @@ header_only b32 hashmap_remove(
     hashmap_remove_by_index( hashmap, index, opt_out_value );
     return true;
 }
+/// Get next item in hashmap.
+/// Cursor should start at zero.
+/// Returns false if there are no more items.
+/// Inserting or removing items while iterating invalidates cursor.
+CORE_API b32 hashmap_next(
+    Hashmap* hashmap, usize* cursor, Key* out_key, void** out_value );
 /// Returns true if hashmap is full.
 header_only b32 hashmap_is_full( Hashmap* hashmap ) {
-    return hashmap->count == hashmap->capacity;
+    return hashmap->count >= hashmap_max_count( hashmap->capacity );
 }
 /// Returns true if hashmap is empty.
 header_only b32 hashmap_is_empty( Hashmap* hashmap ) {
     return hashmap->count == 0;
 }
 /// Clear a hashmap.
-/// Does not deallocate memory, just sets hashmap count to zero.
-header_only void hashmap_clear( Hashmap* hashmap ) {
-    hashmap->count = 0;
+/// Does not deallocate memory, marks every slot as empty.
+CORE_API void hashmap_clear( Hashmap* hashmap );
+
+/// Slot map handle.
+/// Low SLOT_MAP_INDEX_BITS bits are slot index,
+/// remaining bits are slot generation.
+typedef u32 SlotHandle;
+/// Handle that never refers to an item.
+#define SLOT_HANDLE_NULL    (0)
+/// Number of bits in slot handle used for slot index.
+#define SLOT_MAP_INDEX_BITS (20)
+/// Largest capacity a slot map can have.
+#define SLOT_MAP_MAX_CAPACITY (1u << SLOT_MAP_INDEX_BITS)
+/// Get slot index from slot handle.
+#define slot_handle_index( handle )\
+    ( (handle) & ( SLOT_MAP_MAX_CAPACITY - 1 ) )
+/// Get generation from slot handle.
+#define slot_handle_generation( handle )\
+    ( (handle) >> SLOT_MAP_INDEX_BITS )
+
+/// Slot in slot map.
+/// Index is into dense items when slot is occupied,
+/// otherwise it's the next free slot.
+typedef struct SlotMapSlot {
+    u32 index;
+    u32 generation;
+} SlotMapSlot;
+/// Slot map.
+/// Items are stored densely and addressed through handles that
+/// stay valid until their item is removed.
+/// Handles to removed items are rejected because slot generation
+/// is incremented every time an item is removed from it.
+typedef struct SlotMap {
+    void*        items;
+    SlotMapSlot* slots;
+    /// Slot that each dense item belongs to.
+    u32*         dense_slots;
+    usize        item_size;
+    u32          count;
+    u32          capacity;
+    /// Number of slots that have ever been occupied.
+    u32          slot_count;
+    u32          free_slot;
+} SlotMap;
+
+/// Calculate memory requirement of a slot map.
+/// Capacity must be less than or equal to SLOT_MAP_MAX_CAPACITY.
+CORE_API usize slot_map_memory_requirement( usize capacity, usize item_size );
+/// Create a slot map.
+/// Capacity must be less than or equal to SLOT_MAP_MAX_CAPACITY.
+/// Buffer must be able to hold result from slot_map_memory_requirement.
+CORE_API SlotMap slot_map_create( usize capacity, usize item_size, void* buffer );
+/// Insert an item into slot map.
+/// Item is copied into slot map, if opt_item is NULL, item is zeroed.
+/// Returns SLOT_HANDLE_NULL if slot map is full.
+CORE_API SlotHandle slot_map_insert( SlotMap* map, const void* opt_item );
+/// Get a pointer to item that handle refers to.
+/// Returns NULL if item has been removed.
+/// Pointer is only valid until next insert or remove.
+CORE_API void* slot_map_get( SlotMap* map, SlotHandle handle );
+/// Check if handle refers to an item in slot map.
+header_only b32 slot_map_contains( SlotMap* map, SlotHandle handle ) {
+    return slot_map_get( map, handle ) != NULL;
+}
+/// Remove item that handle refers to.
+/// Optionally takes in a pointer to write the value of the removed item to.
+/// Returns false if item had already been removed.
+CORE_API b32 slot_map_remove(
+    SlotMap* map, SlotHandle handle, void* opt_out_item );
+/// Get handle of item at dense index.
+/// Index MUST be less than slot map count.
+CORE_API SlotHandle slot_map_handle_from_dense_index( SlotMap* map, usize index );
+/// Create an iterator over slot map items.
+/// Items are densely packed but not in insertion order.
+header_only Iterator slot_map_iterator( SlotMap* map ) {
+    Iterator result;
+    result.buffer    = map->items;
+    result.item_size = map->item_size;
+    result.count     = map->count;
+    result.current   = 0;
+    return result;
+}
+/// Returns true if slot map is full.
+header_only b32 slot_map_is_full( SlotMap* map ) {
+    return map->count == map->capacity;
+}
+/// Returns true if slot map is empty.
+header_only b32 slot_map_is_empty( SlotMap* map ) {
+    return map->count == 0;
+}
+/// Clear a slot map.
+/// Every handle given out before clearing becomes invalid.
+CORE_API void slot_map_clear( SlotMap* map );
+
+/// Number of children each heap node has.
+#define HEAP_ARITY (4)
+/// Number of unused slots in front of heap priorities.
+#define HEAP_PRIORITY_PADDING (HEAP_ARITY - 1)
+
+/// Heap handle.
+/// Refers to the same item until it is popped or removed,
+/// after that handle may be reused by another item.
+typedef u32 HeapHandle;
+
+/// Min heap priority queue.
+/// 4-ary heap ordered by u64 priority, lowest priority is popped first.
+/// Floats can be used as priorities with sort_key_from_f32/f64.
+/// Priorities are stored contiguously in heap order and offset
+/// so that all children of a node share a cache line,
+/// items stay where they were pushed and are looked up through handles.
+typedef struct Heap {
+    /// Priorities in heap order.
+    u64*  priorities;
+    /// Handles in heap order.
+    u32*  handles;
+    /// Heap position of each handle, next free handle if handle is not in use.
+    u32*  positions;
+    /// Items indexed by handle.
+    void* items;
+    usize item_size;
+    u32   count;
+    u32   capacity;
+    /// Number of handles that have ever been used.
+    u32   handle_count;
+    u32   free_handle;
+} Heap;
+
+/// Calculate memory requirement of a heap.
+CORE_API usize heap_memory_requirement( usize capacity, usize item_size );
+/// Create a heap.
+/// Item size can be zero if only priorities and handles are needed.
+/// Buffer must be able to hold result from heap_memory_requirement.
+CORE_API Heap heap_create( usize capacity, usize item_size, void* buffer );
+/// Build heap from arrays of priorities and items in O(n).
+/// Heap must be empty, items get handles 0 to count - 1 in order.
+/// If opt_items is NULL, items are zeroed.
+/// Returns false if count is larger than heap capacity.
+CORE_API b32 heap_heapify(
+    Heap* heap, usize count, const u64* priorities, const void* opt_items );
+/// Push an item into heap.
+/// If opt_item is NULL, item is zeroed.
+/// Returns false if heap is full.
+CORE_API b32 heap_push(
+    Heap* heap, u64 priority, const void* opt_item, HeapHandle* opt_out_handle );
+/// Get item with lowest priority without removing it.
+/// Returns false if heap is empty.
+CORE_API b32 heap_peek(
+    Heap* heap, u64* opt_out_priority, HeapHandle* opt_out_handle );
+/// Pop item with lowest priority.
+/// Optionally takes in a pointer to write the value of the popped item to.
+/// Returns false if heap is empty.
+CORE_API b32 heap_pop( Heap* heap, u64* opt_out_priority, void* opt_out_item );
+/// Lower priority of item that handle refers to.
+/// New priority MUST be less than or equal to current priority.
+CORE_API void heap_decrease_key( Heap* heap, HeapHandle handle, u64 new_priority );
+/// Remove item that handle refers to.
+/// Optionally takes in a pointer to write the value of the removed item to.
+CORE_API void heap_remove( Heap* heap, HeapHandle handle, void* opt_out_item );
+/// Get a pointer to item that handle refers to.
+header_only void* heap_get( Heap* heap, HeapHandle handle ) {
+    return (u8*)heap->items + ( (usize)handle * heap->item_size );
+}
+/// Get priority of item that handle refers to.
+header_only u64 heap_get_priority( Heap* heap, HeapHandle handle ) {
+    return heap->priorities[heap->positions[handle]];
+}
+/// Returns true if heap is full.
+header_only b32 heap_is_full( Heap* heap ) {
+    return heap->count == heap->capacity;
+}
+/// Returns true if heap is empty.
+header_only b32 heap_is_empty( Heap* heap ) {
+    return heap->count == 0;
 }
+/// Clear a heap.
+/// Every handle given out before clearing becomes invalid.
+CORE_API void heap_clear( Heap* heap );
 
 /// Create an iterator for a buffer.
 header_only Iterator iterator_create( usize item_size, usize count, void* buffer ) {
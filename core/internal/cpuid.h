@@ -0,0 +1,130 @@
+#if !defined(LD_CORE_INTERNAL_CPUID_H)
+#define LD_CORE_INTERNAL_CPUID_H
+/**
+ * Description:  x86 cpu identification shared by platform layers.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "core/system.h"
+#include "core/memory.h"
+
+#if defined(LD_ARCH_X86)
+
+/// Execute cpuid for given leaf and subleaf.
+/// Registers are written in order eax, ebx, ecx, edx.
+header_only force_inline void ___cpuid( u32 leaf, u32 subleaf, u32 out_registers[4] ) {
+    __asm__ volatile (
+        "cpuid"
+        : "=a"(out_registers[0]), "=b"(out_registers[1]),
+          "=c"(out_registers[2]), "=d"(out_registers[3])
+        : "a"(leaf), "c"(subleaf) );
+}
+/// Read extended control register.
+/// Only valid if cpuid reports OSXSAVE.
+header_only force_inline u64 ___xgetbv( u32 index ) {
+    u32 eax = 0, edx = 0;
+    __asm__ volatile ( "xgetbv" : "=a"(eax), "=d"(edx) : "c"(index) );
+    return ( (u64)edx << 32 ) | eax;
+}
+
+/// Query instruction set extensions.
+/// AVX and AVX-512 are only reported if OS saves their registers.
+header_only CPUFeatureFlags ___cpuid_query_features(void) {
+    #define ___check( reg, bit, flag )\
+        if( (reg) & ( 1u << (bit) ) ) { result |= (flag); }
+
+    CPUFeatureFlags result = 0;
+    u32 registers[4] = {};
+
+    ___cpuid( 0, 0, registers );
+    u32 max_leaf = registers[0];
+    ___cpuid( 0x80000000, 0, registers );
+    u32 max_extended_leaf = registers[0];
+
+    ___cpuid( 1, 0, registers );
+    u32 ecx = registers[2];
+    u32 edx = registers[3];
+
+    ___check( edx, 25, CPU_FEATURE_SSE );
+    ___check( edx, 26, CPU_FEATURE_SSE2 );
+    ___check( ecx, 0,  CPU_FEATURE_SSE3 );
+    ___check( ecx, 9,  CPU_FEATURE_SSSE3 );
+    ___check( ecx, 19, CPU_FEATURE_SSE4_1 );
+    ___check( ecx, 20, CPU_FEATURE_SSE4_2 );
+    ___check( ecx, 23, CPU_FEATURE_POPCNT );
+
+    // NOTE(alicia): XCR0 bits 1-2 are SSE/AVX state,
+    // bits 5-7 are opmask and upper ZMM state.
+    b32 os_avx     = false;
+    b32 os_avx_512 = false;
+    if( ecx & ( 1u << 27 ) ) {
+        u64 xcr0   = ___xgetbv( 0 );
+        os_avx     = ( xcr0 & 0x6 ) == 0x6;
+        os_avx_512 = os_avx && ( xcr0 & 0xE0 ) == 0xE0;
+    }
+
+    if( os_avx ) {
+        ___check( ecx, 28, CPU_FEATURE_AVX );
+        ___check( ecx, 12, CPU_FEATURE_FMA );
+        ___check( ecx, 29, CPU_FEATURE_F16C );
+    }
+
+    if( max_leaf >= 7 ) {
+        ___cpuid( 7, 0, registers );
+        u32 ebx = registers[1];
+        ecx     = registers[2];
+
+        ___check( ebx, 3, CPU_FEATURE_BMI1 );
+        ___check( ebx, 8, CPU_FEATURE_BMI2 );
+        if( os_avx ) {
+            ___check( ebx, 5, CPU_FEATURE_AVX2 );
+        }
+        if( os_avx_512 ) {
+            ___check( ebx, 16, CPU_FEATURE_AVX_512 );
+            ___check( ebx, 17, CPU_FEATURE_AVX_512_DQ );
+            ___check( ebx, 21, CPU_FEATURE_AVX_512_IFMA );
+            ___check( ebx, 28, CPU_FEATURE_AVX_512_CD );
+            ___check( ebx, 30, CPU_FEATURE_AVX_512_BW );
+            ___check( ebx, 31, CPU_FEATURE_AVX_512_VL );
+            ___check( ecx, 1,  CPU_FEATURE_AVX_512_VBMI );
+            ___check( ecx, 11, CPU_FEATURE_AVX_512_VNNI );
+        }
+    }
+
+    if( max_extended_leaf >= 0x80000001 ) {
+        ___cpuid( 0x80000001, 0, registers );
+        ___check( registers[2], 5, CPU_FEATURE_LZCNT );
+    }
+
+    #undef ___check
+    return result;
+}
+/// Query cpu brand string.
+/// Buffer must be able to hold at least 49 bytes.
+/// Returns false if cpu does not report brand string.
+header_only b32 ___cpuid_query_name( char* buffer ) {
+    u32 registers[4] = {};
+    ___cpuid( 0x80000000, 0, registers );
+    if( registers[0] < 0x80000004 ) {
+        return false;
+    }
+
+    for( u32 i = 0; i < 3; ++i ) {
+        ___cpuid( 0x80000002 + i, 0, registers );
+        memory_copy( buffer + ( i * sizeof(registers) ), registers, sizeof(registers) );
+    }
+    buffer[3 * sizeof(registers)] = 0;
+    return true;
+}
+/// Query cache line size from clflush line size.
+/// Returns 0 if unknown.
+header_only u32 ___cpuid_query_cache_line_size(void) {
+    u32 registers[4] = {};
+    ___cpuid( 1, 0, registers );
+    return ( ( registers[1] >> 8 ) & 0xFF ) * 8;
+}
+
+#endif /* Arch x86 */
+
+#endif /* header guard */
@@ -10,6 +10,7 @@
 
 #include "core/system.h"
 #include "core/path.h"
+#include "core/memory.h"
 
 struct TimeRecord;
 
@@ -21,10 +22,11 @@ typedef void PlatformFile;
 typedef void PlatformThread;
 /// Platform thread function.
 typedef int PlatformThreadProc( void* user_params );
-/// Opaque handle to a semaphore.
-typedef void PlatformSemaphore;
-/// Opaque handle to a mutex.
-typedef void PlatformMutex;
+/// Opaque handle to a fiber.
+typedef void PlatformFiber;
+/// Platform fiber function.
+/// Must never return, fiber has to switch to another fiber instead.
+typedef void PlatformFiberProc( void* user_params );
 
 #define PLATFORM_INFINITE_TIMEOUT (U32_MAX)
 
@@ -90,28 +92,48 @@ void* platform_shared_object_load(
     PlatformSharedObject* object, const char* function_name );
 
 /// Create a thread.
+/// Thread must be released with either platform_thread_join
+/// or platform_thread_detach.
 PlatformThread* platform_thread_create(
     PlatformThreadProc* thread_proc, void* thread_proc_params, usize stack_size );
-
-/// Create a semaphore.
-PlatformSemaphore* platform_semaphore_create( const char* name, u32 initial_count );
-/// Destroy a semaphore.
-void platform_semaphore_destroy( PlatformSemaphore* semaphore );
-/// Signal a semaphore.
-void platform_semaphore_signal( PlatformSemaphore* semaphore );
-/// Wait for a semaphore to be signaled for specified milliseconds.
-/// Returns false if timed out.
-b32 platform_semaphore_wait( PlatformSemaphore* semaphore, u32 timeout_ms );
-
-/// Create a mutex.
-PlatformMutex* platform_mutex_create( const char* name );
-/// Destroy a mutex.
-void platform_mutex_destroy( PlatformMutex* mutex );
-/// Try to lock a mutex.
+/// Wait for thread to exit and release it.
+/// Writes value returned by thread proc to opt_out_return_code.
+void platform_thread_join( PlatformThread* thread, int* opt_out_return_code );
+/// Release thread without waiting for it,
+/// thread cleans up after itself once it exits.
+void platform_thread_detach( PlatformThread* thread );
+/// Restrict calling thread to run only on given logical processor.
+/// Returns false if failed.
+b32 platform_thread_set_affinity( u32 logical_cpu );
+/// Set name of calling thread.
+void platform_thread_set_name( const char* name );
+
+/// Convert calling thread into a fiber so that it can switch to other fibers.
+/// Returns NULL if there was an error.
+PlatformFiber* platform_fiber_from_thread(void);
+/// Convert fiber created with platform_fiber_from_thread back into a thread.
+/// Must be called from the same thread, while it's running its own fiber.
+void platform_fiber_to_thread( PlatformFiber* fiber );
+/// Create a fiber with its own stack.
+/// Fiber does not run until another fiber switches to it.
+/// Returns NULL if there was an error.
+PlatformFiber* platform_fiber_create(
+    PlatformFiberProc* fiber_proc, void* fiber_proc_params, usize stack_size );
+/// Destroy a fiber, fiber must not be running.
+void platform_fiber_destroy( PlatformFiber* fiber );
+/// Switch from fiber running on calling thread to next fiber.
+/// Returns once another fiber switches back to current.
+void platform_fiber_switch( PlatformFiber* current, PlatformFiber* next );
+
+/// Put calling thread to sleep if value at address equals expected value.
+/// Sleeps until woken by platform_futex_wake or for specified milliseconds.
+/// Can return without being woken, caller has to check value again.
 /// Returns false if timed out.
-b32 platform_mutex_lock( PlatformMutex* mutex, u32 timeout_ms );
-/// Unlock a mutex.
-void platform_mutex_unlock( PlatformMutex* mutex );
+b32 platform_futex_wait( volatile u32* address, u32 expected, u32 timeout_ms );
+/// Wake one thread sleeping on address.
+void platform_futex_wake( volatile u32* address );
+/// Wake all threads sleeping on address.
+void platform_futex_wake_all( volatile u32* address );
 
 /// Sleep thread for given milliseconds.
 void platform_sleep( u32 ms );
@@ -125,6 +147,36 @@ void* platform_heap_realloc( void* memory, usize old_size, usize new_size );
 /// Free memory allocated from the heap.
 void platform_heap_free( void* memory, usize size );
 
+/// Allocate pages directly from the system.
+/// Memory acquired is always zeroed and aligned to page size.
+void* platform_page_alloc( usize size );
+/// Free pages allocated with platform_page_alloc.
+void platform_page_free( void* memory, usize size );
+
+/// Reserve address space.
+/// Memory cannot be accessed until it has been committed.
+void* platform_virtual_reserve( usize size );
+/// Commit reserved pages.
+/// Memory committed is always zeroed.
+b32 platform_virtual_commit( void* memory, usize size );
+/// Decommit pages.
+/// Contents are discarded but address space stays reserved.
+void platform_virtual_decommit( void* memory, usize size );
+/// Release address space acquired with platform_virtual_reserve.
+void platform_virtual_release( void* memory, usize size );
+/// Ask system to back reserved pages with transparent huge pages.
+/// Returns kind of huge pages that will be used.
+MemoryHugePageKind platform_virtual_advise_huge_pages( void* memory, usize size );
+
+/// Query size of a huge page.
+usize platform_huge_page_size(void);
+/// Allocate memory backed by huge pages.
+/// Size must be a multiple of platform_huge_page_size.
+/// Memory is aligned to huge page size and always zeroed.
+void* platform_huge_page_alloc( usize size, MemoryHugePageKind* out_kind );
+/// Free memory allocated with platform_huge_page_alloc.
+void platform_huge_page_free( void* memory, usize size );
+
 /// Initialize time keeping.
 void platform_time_initialize(void);
 /// Get time record.
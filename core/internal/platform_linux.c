@@ -7,6 +7,7 @@
 
 #if defined(LD_PLATFORM_LINUX)
 
+#include "shared/constants.h"
 #include "core/internal/logging.h"
 #include "core/internal/platform.h"
 #include "core/string.h"
@@ -16,6 +17,7 @@
 #include "core/time.h"
 #include "core/system.h"
 #include "core/print.h"
+#include "core/internal/cpuid.h"
 
 // TODO(alicia): replace malloc/free with mmap/munmap
 #include <stdlib.h>
@@ -28,9 +30,12 @@
 #include <errno.h>
 #include <dlfcn.h>
 #include <pthread.h>
-#include <semaphore.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 #include <time.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
 
 #define FD_STDIN  ((PlatformFile*)0)
 #define FD_STDOUT ((PlatformFile*)1)
@@ -303,14 +308,24 @@ struct PosixThread {
     PlatformThreadProc* proc;
     void* params;
     pthread_t thread_id;
+    /// Released by thread once it has started
+    /// and by whoever joins or detaches it.
+    volatile u32 ref_count;
 };
 
+internal void ___posix_thread_release( struct PosixThread* thread ) {
+    if( atomic_fetch_sub_u32( &thread->ref_count, 1, MEMORY_ORDER_ACQ_REL ) == 1 ) {
+        free( thread );
+    }
+}
+
 void* start_routine(void* params) {
     struct PosixThread* posix_thread = params;
-    int ret = posix_thread->proc( posix_thread->params );
-    read_write_fence();
+    PlatformThreadProc* proc        = posix_thread->proc;
+    void*               proc_params = posix_thread->params;
+    ___posix_thread_release( posix_thread );
 
-    free( posix_thread );
+    int ret = proc( proc_params );
     return (void*)((isize)ret);
 }
 
@@ -338,10 +353,9 @@ PlatformThread* platform_thread_create(
         return NULL;
     }
 
-    thread->proc   = thread_proc;
-    thread->params = thread_proc_params;
-
-    read_write_fence();
+    thread->proc      = thread_proc;
+    thread->params    = thread_proc_params;
+    thread->ref_count = 2;
 
     result = pthread_create(
         &thread->thread_id, &attributes, start_routine, thread );
@@ -354,87 +368,309 @@ PlatformThread* platform_thread_create(
 
     return (PlatformThread*)thread;
 }
+void platform_thread_join( PlatformThread* thread, int* opt_out_return_code ) {
+    struct PosixThread* posix_thread = thread;
 
-struct timespec ms_to_timespec( u32 ms ) {
-    struct timespec result = {};
-    result.tv_sec  = ms / 1000;
-    result.tv_nsec = (ms % 1000) * 1000 * 1000;
-    return result;
-}
-
-PlatformSemaphore* platform_semaphore_create( const char* name, u32 initial_count ) {
-    mode_t mode  = S_IRWXU;
-    int    oflag = O_CREAT;
-    errno = 0;
-    sem_t* result = sem_open( name, oflag, mode, initial_count );
+    void* ret = NULL;
+    pthread_join( posix_thread->thread_id, &ret );
+    ___posix_thread_release( posix_thread );
 
-    if( result == SEM_FAILED ) {
-        core_log_error( "failed to create semaphore {cc}!", name );
+    if( opt_out_return_code ) {
+        *opt_out_return_code = (int)((isize)ret);
     }
-
-    return result;
-}
-void platform_semaphore_destroy( PlatformSemaphore* semaphore ) {
-    sem_close( semaphore );
 }
-void platform_semaphore_signal( PlatformSemaphore* semaphore ) {
-    sem_post( semaphore );
+void platform_thread_detach( PlatformThread* thread ) {
+    struct PosixThread* posix_thread = thread;
+    pthread_detach( posix_thread->thread_id );
+    ___posix_thread_release( posix_thread );
 }
-b32 platform_semaphore_wait( PlatformSemaphore* semaphore, u32 timeout_ms ) {
-    if( timeout_ms == PLATFORM_INFINITE_TIMEOUT ) {
-        struct timespec ts = ms_to_timespec( timeout_ms );
-        errno = 0;
-        sem_timedwait( semaphore, &ts );
-        return errno != ETIMEDOUT;
-    } else {
-        sem_wait( semaphore );
-        return true;
+b32 platform_thread_set_affinity( u32 logical_cpu ) {
+    // NOTE(alicia): raw syscall so that cpu_set_t and _GNU_SOURCE
+    // aren't needed, mask is same layout as cpu_set_t.
+    u64 mask[16] = {};
+    if( logical_cpu >= sizeof(mask) * 8 ) {
+        return false;
     }
+    mask[logical_cpu / 64] = 1ull << ( logical_cpu % 64 );
+
+    if( syscall( SYS_sched_setaffinity, 0, sizeof(mask), mask ) ) {
+        core_log_warn( "failed to set thread affinity to cpu {u}!", logical_cpu );
+        return false;
+    }
+    return true;
+}
+void platform_thread_set_name( const char* name ) {
+    // NOTE(alicia): kernel truncates name to 15 characters.
+    prctl( PR_SET_NAME, (unsigned long)name, 0, 0, 0 );
 }
 
-PlatformMutex* platform_mutex_create( const char* name ) {
-    pthread_mutex_t* result = malloc( sizeof(*result) );
-    if( !result ) {
-        core_log_error( "failed to allocate mutex!" );
+#if defined(LD_ARCH_64_BIT) && ( defined(LD_ARCH_X86) || defined(LD_ARCH_ARM) )
+    #define LINUX_FIBER_ASM
+#else
+    #include <ucontext.h>
+#endif
+
+struct PosixFiber {
+    /// Saved stack pointer while fiber is not running.
+    void* stack_pointer;
+    /// Stack mapping including guard page, NULL for thread fibers.
+    void* stack;
+    usize stack_size;
+    PlatformFiberProc* proc;
+    void* params;
+#if !defined(LINUX_FIBER_ASM)
+    ucontext_t context;
+#endif
+};
+
+internal no_inline void ___linux_fiber_start( struct PosixFiber* fiber ) {
+    fiber->proc( fiber->params );
+    core_log_fatal( "fiber proc returned!" );
+    abort();
+}
+
+#if defined(LINUX_FIBER_ASM)
+
+// NOTE(alicia): switch pushes callee-saved registers onto current stack,
+// stores stack pointer in first argument, loads stack pointer from
+// second argument and pops next fiber's registers off of its stack.
+// New fibers start with a frame that returns into entry,
+// which calls ___linux_fiber_start with the fiber.
+__attribute__((visibility("hidden")))
+void ___linux_fiber_switch( void** out_stack_pointer, void* stack_pointer )
+    __asm__( "ld_linux_fiber_switch" );
+__attribute__((visibility("hidden")))
+void ___linux_fiber_entry(void) __asm__( "ld_linux_fiber_entry" );
+
+#if defined(LD_ARCH_X86)
+
+/// Size of frame pushed by fiber switch.
+#define LINUX_FIBER_FRAME_SIZE (80)
+
+// NOTE(alicia): x86 builds pass -masm=intel so syntax is switched
+// to AT&T for this block and back to intel at the end of it.
+__asm__(
+    ".att_syntax prefix\n"
+    ".text\n"
+    ".p2align 4\n"
+    "ld_linux_fiber_switch:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr (%rsp)\n"
+    "    fnstcw 4(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr (%rsp)\n"
+    "    fldcw 4(%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".p2align 4\n"
+    "ld_linux_fiber_entry:\n"
+    "    movq %rbx, %rdi\n"
+    "    callq *%r12\n"
+    "    ud2\n"
+    ".intel_syntax noprefix\n"
+);
+
+internal void* ___linux_fiber_frame( struct PosixFiber* fiber, u8* stack_top ) {
+    // NOTE(alicia): return address sits 24 bytes below top so that
+    // stack is 16 byte aligned when entry calls ___linux_fiber_start.
+    u64* frame = (u64*)( stack_top - LINUX_FIBER_FRAME_SIZE );
+    frame[0] = 0x1F80 | ( (u64)0x037F << 32 ); // default mxcsr and x87 control word
+    frame[1] = 0;                                   // r15
+    frame[2] = 0;                                   // r14
+    frame[3] = 0;                                   // r13
+    frame[4] = (u64)___linux_fiber_start;           // r12
+    frame[5] = (u64)fiber;                          // rbx
+    frame[6] = 0;                                   // rbp
+    frame[7] = (u64)___linux_fiber_entry;           // return address
+    return frame;
+}
+
+#else /* arch arm */
+
+/// Size of frame pushed by fiber switch.
+#define LINUX_FIBER_FRAME_SIZE (160)
+
+__asm__(
+    ".text\n"
+    ".p2align 4\n"
+    "ld_linux_fiber_switch:\n"
+    "    sub sp, sp, #160\n"
+    "    stp x19, x20, [sp, #0]\n"
+    "    stp x21, x22, [sp, #16]\n"
+    "    stp x23, x24, [sp, #32]\n"
+    "    stp x25, x26, [sp, #48]\n"
+    "    stp x27, x28, [sp, #64]\n"
+    "    stp x29, x30, [sp, #80]\n"
+    "    stp d8,  d9,  [sp, #96]\n"
+    "    stp d10, d11, [sp, #112]\n"
+    "    stp d12, d13, [sp, #128]\n"
+    "    stp d14, d15, [sp, #144]\n"
+    "    mov x9, sp\n"
+    "    str x9, [x0]\n"
+    "    mov sp, x1\n"
+    "    ldp x19, x20, [sp, #0]\n"
+    "    ldp x21, x22, [sp, #16]\n"
+    "    ldp x23, x24, [sp, #32]\n"
+    "    ldp x25, x26, [sp, #48]\n"
+    "    ldp x27, x28, [sp, #64]\n"
+    "    ldp x29, x30, [sp, #80]\n"
+    "    ldp d8,  d9,  [sp, #96]\n"
+    "    ldp d10, d11, [sp, #112]\n"
+    "    ldp d12, d13, [sp, #128]\n"
+    "    ldp d14, d15, [sp, #144]\n"
+    "    add sp, sp, #160\n"
+    "    ret\n"
+    ".p2align 4\n"
+    "ld_linux_fiber_entry:\n"
+    "    mov x0, x19\n"
+    "    blr x20\n"
+    "    brk #0\n"
+);
+
+internal void* ___linux_fiber_frame( struct PosixFiber* fiber, u8* stack_top ) {
+    u64* frame = (u64*)( stack_top - LINUX_FIBER_FRAME_SIZE );
+    memory_zero( frame, LINUX_FIBER_FRAME_SIZE );
+    frame[0]  = (u64)fiber;                 // x19
+    frame[1]  = (u64)___linux_fiber_start;  // x20
+    frame[11] = (u64)___linux_fiber_entry;  // x30
+    return frame;
+}
+
+#endif /* arch */
+
+#else /* LINUX_FIBER_ASM */
+
+internal void ___linux_fiber_context_start( unsigned int low, unsigned int high ) {
+    // NOTE(alicia): makecontext only passes ints,
+    // fiber pointer is split in two.
+    u64 address = ( (u64)high << 32 ) | (u64)low;
+    ___linux_fiber_start( (struct PosixFiber*)(usize)address );
+}
+
+#endif /* LINUX_FIBER_ASM */
+
+PlatformFiber* platform_fiber_from_thread(void) {
+    struct PosixFiber* fiber = calloc( 1, sizeof( *fiber ) );
+    if( !fiber ) {
+        core_log_error( "failed to allocate PosixFiber!" );
         return NULL;
     }
-
-    pthread_mutexattr_t attributes = {};
-    int error = pthread_mutexattr_init( &attributes );
-    if( error ) {
-        core_log_error( "failed to create mutex attributes!" );
-        free( result );
+    return fiber;
+}
+void platform_fiber_to_thread( PlatformFiber* fiber ) {
+    free( fiber );
+}
+PlatformFiber* platform_fiber_create(
+    PlatformFiberProc* fiber_proc, void* fiber_proc_params, usize stack_size
+) {
+    struct PosixFiber* fiber = calloc( 1, sizeof( *fiber ) );
+    if( !fiber ) {
+        core_log_error( "failed to allocate PosixFiber!" );
         return NULL;
     }
 
-    error = pthread_mutex_init( result, &attributes );
-    pthread_mutexattr_destroy( &attributes );
-
-    if( error ) {
-        free( result );
+    usize page_size = (usize)sysconf( _SC_PAGESIZE );
+    stack_size = ( stack_size + page_size - 1 ) & ~( page_size - 1 );
+
+    // NOTE(alicia): lowest page is left inaccessible
+    // so that overflowing fiber stack faults.
+    usize mapping_size = stack_size + page_size;
+    u8* stack = mmap(
+        NULL, mapping_size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0 );
+    if( stack == MAP_FAILED ) {
+        core_log_error( "failed to map fiber stack! size: {usize}", mapping_size );
+        free( fiber );
         return NULL;
     }
+    mprotect( stack, page_size, PROT_NONE );
+
+    fiber->stack      = stack;
+    fiber->stack_size = mapping_size;
+    fiber->proc       = fiber_proc;
+    fiber->params     = fiber_proc_params;
+
+#if defined(LINUX_FIBER_ASM)
+    fiber->stack_pointer = ___linux_fiber_frame( fiber, stack + mapping_size );
+#else
+    getcontext( &fiber->context );
+    fiber->context.uc_stack.ss_sp   = stack + page_size;
+    fiber->context.uc_stack.ss_size = stack_size;
+    fiber->context.uc_link          = NULL;
+
+    u64 address = (u64)(usize)fiber;
+    makecontext(
+        &fiber->context, (void(*)(void))___linux_fiber_context_start, 2,
+        (unsigned int)( address & U32_MAX ), (unsigned int)( address >> 32 ) );
+#endif
+
+    return fiber;
+}
+void platform_fiber_destroy( PlatformFiber* fiber ) {
+    struct PosixFiber* posix_fiber = fiber;
+    if( posix_fiber->stack ) {
+        munmap( posix_fiber->stack, posix_fiber->stack_size );
+    }
+    free( posix_fiber );
+}
+void platform_fiber_switch( PlatformFiber* current, PlatformFiber* next ) {
+    struct PosixFiber* current_fiber = current;
+    struct PosixFiber* next_fiber    = next;
+#if defined(LINUX_FIBER_ASM)
+    ___linux_fiber_switch( &current_fiber->stack_pointer, next_fiber->stack_pointer );
+#else
+    swapcontext( &current_fiber->context, &next_fiber->context );
+#endif
+}
 
-    unused(name);
+#if defined(LINUX_FIBER_ASM)
+    #undef LINUX_FIBER_ASM
+#endif
+#if defined(LINUX_FIBER_FRAME_SIZE)
+    #undef LINUX_FIBER_FRAME_SIZE
+#endif
+
+struct timespec ms_to_timespec( u32 ms ) {
+    struct timespec result = {};
+    result.tv_sec  = ms / 1000;
+    result.tv_nsec = (ms % 1000) * 1000 * 1000;
     return result;
 }
-void platform_mutex_destroy( PlatformMutex* mutex ) {
-    pthread_mutex_destroy( mutex );
-    free( mutex );
-}
-b32 platform_mutex_lock( PlatformMutex* mutex, u32 timeout_ms ) {
-    if( timeout_ms == PLATFORM_INFINITE_TIMEOUT ) {
-        struct timespec ts = ms_to_timespec( timeout_ms );
-        errno = 0;
-        pthread_mutex_timedlock( mutex, &ts );
-        return errno != ETIMEDOUT;
-    } else {
-        pthread_mutex_lock( mutex );
-        return true;
+
+b32 platform_futex_wait( volatile u32* address, u32 expected, u32 timeout_ms ) {
+    struct timespec  ts      = {};
+    struct timespec* timeout = NULL;
+    if( timeout_ms != PLATFORM_INFINITE_TIMEOUT ) {
+        ts      = ms_to_timespec( timeout_ms );
+        timeout = &ts;
     }
+
+    // NOTE(alicia): futex timeout is relative for FUTEX_WAIT.
+    long result = syscall(
+        SYS_futex, address, FUTEX_WAIT_PRIVATE, expected, timeout, NULL, 0 );
+    if( result == -1 && errno == ETIMEDOUT ) {
+        return false;
+    }
+    return true;
+}
+void platform_futex_wake( volatile u32* address ) {
+    syscall( SYS_futex, address, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 );
 }
-void platform_mutex_unlock( PlatformMutex* mutex ) {
-    pthread_mutex_unlock( mutex );
+void platform_futex_wake_all( volatile u32* address ) {
+    syscall( SYS_futex, address, FUTEX_WAKE_PRIVATE, I32_MAX, NULL, NULL, 0 );
 }
 
 void platform_sleep( u32 ms ) {
@@ -454,6 +690,150 @@ void platform_heap_free( void* memory, usize size ) {
     free( memory );
 }
 
+void* platform_page_alloc( usize size ) {
+    void* result = mmap(
+        NULL, size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if( result == MAP_FAILED ) {
+        return NULL;
+    }
+    return result;
+}
+void platform_page_free( void* memory, usize size ) {
+    munmap( memory, size );
+}
+
+void* platform_virtual_reserve( usize size ) {
+    void* result = mmap(
+        NULL, size, PROT_NONE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+    if( result == MAP_FAILED ) {
+        return NULL;
+    }
+    return result;
+}
+b32 platform_virtual_commit( void* memory, usize size ) {
+    return mprotect( memory, size, PROT_READ | PROT_WRITE ) == 0;
+}
+void platform_virtual_decommit( void* memory, usize size ) {
+    madvise( memory, size, MADV_DONTNEED );
+    mprotect( memory, size, PROT_NONE );
+}
+void platform_virtual_release( void* memory, usize size ) {
+    munmap( memory, size );
+}
+
+/// Read a small file like sysfs entries into buffer.
+/// Returns number of bytes read.
+internal usize ___linux_read_small_file(
+    const char* path, usize capacity, char* buffer
+) {
+    int fd = open( path, O_RDONLY );
+    if( fd < 0 ) {
+        return 0;
+    }
+    ssize_t result = read( fd, buffer, capacity );
+    close( fd );
+    return result > 0 ? (usize)result : 0;
+}
+internal b32 ___linux_transparent_huge_pages_enabled(void) {
+    char buffer[64] = {};
+    usize len = ___linux_read_small_file(
+        "/sys/kernel/mm/transparent_hugepage/enabled",
+        sizeof(buffer) - 1, buffer );
+    // NOTE(alicia): file looks like "always [madvise] never",
+    // selected mode is in brackets.
+    for( usize i = 0; i + 1 < len; ++i ) {
+        if( buffer[i] == '[' ) {
+            return buffer[i + 1] != 'n';
+        }
+    }
+    return false;
+}
+
+global usize global_linux_huge_page_size = 0;
+
+usize platform_huge_page_size(void) {
+    if( global_linux_huge_page_size ) {
+        return global_linux_huge_page_size;
+    }
+    char buffer[32] = {};
+    usize len = ___linux_read_small_file(
+        "/sys/kernel/mm/transparent_hugepage/hpage_pmd_size",
+        sizeof(buffer) - 1, buffer );
+
+    usize result = 0;
+    for( usize i = 0; i < len; ++i ) {
+        if( buffer[i] < '0' || buffer[i] > '9' ) {
+            break;
+        }
+        result = ( result * 10 ) + (usize)( buffer[i] - '0' );
+    }
+    if( !result ) {
+        // NOTE(alicia): 2MB is the huge page size of
+        // both x86-64 and AArch64 with 4K pages.
+        result = megabytes(2);
+    }
+
+    global_linux_huge_page_size = result;
+    return result;
+}
+MemoryHugePageKind platform_virtual_advise_huge_pages( void* memory, usize size ) {
+#if defined(MADV_HUGEPAGE)
+    if(
+        ___linux_transparent_huge_pages_enabled() &&
+        madvise( memory, size, MADV_HUGEPAGE ) == 0
+    ) {
+        return MEMORY_HUGE_PAGE_TRANSPARENT;
+    }
+#else
+    unused( memory, size );
+#endif
+    return MEMORY_HUGE_PAGE_NONE;
+}
+void* platform_huge_page_alloc( usize size, MemoryHugePageKind* out_kind ) {
+#if defined(MAP_HUGETLB)
+    // NOTE(alicia): only succeeds if huge page pool
+    // has been configured (vm.nr_hugepages).
+    void* explicit_pages = mmap(
+        NULL, size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+    if( explicit_pages != MAP_FAILED ) {
+        *out_kind = MEMORY_HUGE_PAGE_EXPLICIT;
+        return explicit_pages;
+    }
+#endif
+
+    // NOTE(alicia): transparent huge pages are only used for
+    // aligned ranges so map an extra huge page and trim
+    // mapping down to a huge page boundary.
+    usize huge_page_size = platform_huge_page_size();
+    usize mapping_size   = size + huge_page_size;
+    u8* mapping = mmap(
+        NULL, mapping_size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if( mapping == MAP_FAILED ) {
+        return NULL;
+    }
+
+    u8* result = (u8*)(
+        ( (usize)mapping + ( huge_page_size - 1 ) ) & ~( huge_page_size - 1 ) );
+    usize head = (usize)( result - mapping );
+    usize tail = mapping_size - head - size;
+    if( head ) {
+        munmap( mapping, head );
+    }
+    if( tail ) {
+        munmap( result + size, tail );
+    }
+
+    *out_kind = platform_virtual_advise_huge_pages( result, size );
+    return result;
+}
+void platform_huge_page_free( void* memory, usize size ) {
+    munmap( memory, size );
+}
+
 global struct timespec global_start_time = {};
 
 void platform_time_initialize(void) {
@@ -480,13 +860,147 @@ void platform_time_record( struct TimeRecord* out_record ) {
     out_record->second = time->tm_sec;
 }
 
+/// Parse decimal number in text starting at given position.
+/// Position is advanced past the last digit.
+internal usize ___linux_parse_number( usize len, const char* text, usize* at ) {
+    usize result = 0;
+    while( *at < len && text[*at] >= '0' && text[*at] <= '9' ) {
+        result = ( result * 10 ) + (usize)( text[*at] - '0' );
+        (*at)++;
+    }
+    return result;
+}
+/// Parse sysfs number, with optional K/M/G suffix.
+internal usize ___linux_parse_sysfs_size( usize len, const char* text ) {
+    usize at     = 0;
+    usize result = ___linux_parse_number( len, text, &at );
+    if( at >= len ) {
+        return result;
+    }
+    switch( text[at] ) {
+        case 'K': return kilobytes( result );
+        case 'M': return megabytes( result );
+        case 'G': return gigabytes( result );
+        default:  return result;
+    }
+}
+internal void ___linux_query_cache( SystemInfo* out_info ) {
+    char path[128] = {};
+    char text[32]  = {};
+    usize len = 0;
+    for( u32 index = 0; ; ++index ) {
+        snprintf( path, sizeof(path),
+            "/sys/devices/system/cpu/cpu0/cache/index%u/level", index );
+        len = ___linux_read_small_file( path, sizeof(text), text );
+        if( !len ) {
+            break;
+        }
+        usize level = ___linux_parse_sysfs_size( len, text );
+
+        snprintf( path, sizeof(path),
+            "/sys/devices/system/cpu/cpu0/cache/index%u/type", index );
+        len = ___linux_read_small_file( path, sizeof(text), text );
+        if( !len || text[0] == 'I' ) {
+            // NOTE(alicia): skip instruction caches.
+            continue;
+        }
+
+        snprintf( path, sizeof(path),
+            "/sys/devices/system/cpu/cpu0/cache/index%u/size", index );
+        len = ___linux_read_small_file( path, sizeof(text), text );
+        usize size = ___linux_parse_sysfs_size( len, text );
+
+        switch( level ) {
+            case 1: {
+                out_info->l1_cache_size = size;
+                snprintf( path, sizeof(path),
+                    "/sys/devices/system/cpu/cpu0/cache/index%u/coherency_line_size",
+                    index );
+                len = ___linux_read_small_file( path, sizeof(text), text );
+                if( len ) {
+                    out_info->cache_line_size =
+                        (u32)___linux_parse_sysfs_size( len, text );
+                }
+            } break;
+            case 2:
+                out_info->l2_cache_size = size;
+                break;
+            case 3:
+                out_info->l3_cache_size = size;
+                break;
+            default: break;
+        }
+    }
+}
+internal void ___linux_query_topology( SystemInfo* out_info ) {
+    char path[128]   = {};
+    char text[64]    = {};
+    char online[256] = {};
+
+    // NOTE(alicia): online cpu ids can have holes,
+    // list looks like "0-3,5,7-8".
+    usize online_len = ___linux_read_small_file(
+        "/sys/devices/system/cpu/online", sizeof(online), online );
+    if( !online_len ) {
+        online_len = (usize)snprintf(
+            online, sizeof(online), "0-%u", (u32)out_info->cpu_count - 1 );
+    }
+
+    out_info->physical_cpu_count = 0;
+    usize at = 0;
+    while( at < online_len ) {
+        u32 first = (u32)___linux_parse_number( online_len, online, &at );
+        u32 last  = first;
+        if( at < online_len && online[at] == '-' ) {
+            at++;
+            last = (u32)___linux_parse_number( online_len, online, &at );
+        }
+        // NOTE(alicia): skip separator or trailing newline.
+        at++;
+
+        for( u32 cpu = first; cpu <= last; ++cpu ) {
+            // NOTE(alicia): first sibling of every core is the one
+            // that starts its thread siblings list.
+            snprintf( path, sizeof(path),
+                "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list", cpu );
+            usize len = ___linux_read_small_file( path, sizeof(text), text );
+            if( len && ___linux_parse_sysfs_size( len, text ) != cpu ) {
+                continue;
+            }
+
+            if( out_info->physical_cpu_count < SYSTEM_INFO_MAX_CORE_COUNT ) {
+                out_info->core_logical_cpu[out_info->physical_cpu_count] = (u16)cpu;
+            }
+            out_info->physical_cpu_count++;
+        }
+    }
+}
+
 void platform_system_info_query( SystemInfo* out_info ) {
-    // TODO(alicia): 
     memory_copy( out_info->cpu_name, "unknown", sizeof("unknown") );
-    out_info->total_memory  = gigabytes(30);
-    out_info->page_size     = kilobytes(4);
-    out_info->cpu_count     = 16;
-    out_info->feature_flags = CPU_FEATURE_SSE_MASK | CPU_FEATURE_AVX_MASK;
+
+    long page_size  = sysconf( _SC_PAGESIZE );
+    long page_count = sysconf( _SC_PHYS_PAGES );
+    long cpu_count  = sysconf( _SC_NPROCESSORS_ONLN );
+
+    out_info->page_size    = page_size > 0 ? (usize)page_size : kilobytes(4);
+    out_info->total_memory = page_count > 0 ? (usize)page_count * out_info->page_size : 0;
+    out_info->cpu_count    = cpu_count > 0 ? (u16)cpu_count : 1;
+
+    ___linux_query_topology( out_info );
+    ___linux_query_cache( out_info );
+
+#if defined(LD_ARCH_X86)
+    ___cpuid_query_name( out_info->cpu_name );
+    out_info->feature_flags = ___cpuid_query_features();
+    if( !out_info->cache_line_size ) {
+        out_info->cache_line_size = ___cpuid_query_cache_line_size();
+    }
+#endif /* Arch x86 */
+
+    if( !out_info->cache_line_size ) {
+        out_info->cache_line_size = CACHE_LINE_SIZE;
+    }
 }
 
 #endif /* Platform Linux */
@@ -15,6 +15,8 @@
 #include "core/path.h"
 #include "core/fs.h"
 #include "core/string.h"
+#include "core/atomic.h"
+#include "core/internal/cpuid.h"
 
 #define win32_log_note( format, ... )\
     core_log_note( "[WIN32] " format, ##__VA_ARGS__ )
@@ -48,6 +50,9 @@ struct Win32Thread {
     HANDLE handle;
     DWORD  id;
     struct Win32ThreadParams params;
+    /// Released by thread once it has started
+    /// and by whoever joins or detaches it.
+    volatile u32 ref_count;
 };
 
 b32 platform_get_current_process_path(
@@ -623,12 +628,18 @@ void* platform_shared_object_load(
     return function;
 }
 
+internal void ___win32_thread_release( struct Win32Thread* thread ) {
+    if( atomic_fetch_sub_u32( &thread->ref_count, 1, MEMORY_ORDER_ACQ_REL ) == 1 ) {
+        HeapFree( GetProcessHeap(), 0, thread );
+    }
+}
+
 internal DWORD ___internal_win32_thread_proc( void* in ) {
     struct Win32Thread* thread = in;
+    struct Win32ThreadParams params = thread->params;
+    ___win32_thread_release( thread );
 
-    _ReadWriteBarrier();
-
-    int return_code = thread->params.thread_proc( thread->params.user_params );
+    int return_code = params.thread_proc( params.user_params );
 
     ExitThread( return_code );
 }
@@ -644,8 +655,7 @@ PlatformThread* platform_thread_create(
 
     thread->params.thread_proc = thread_proc;
     thread->params.user_params = thread_proc_params;
-
-    _ReadWriteBarrier();
+    thread->ref_count          = 2;
 
     DWORD id = 0;
     HANDLE thread_handle = CreateThread(
@@ -655,52 +665,134 @@ PlatformThread* platform_thread_create(
         return NULL;
     }
 
-    _ReadWriteBarrier();
-
     thread->handle = thread_handle;
     thread->id     = id;
 
     return thread;
 }
+void platform_thread_join( PlatformThread* thread, int* opt_out_return_code ) {
+    struct Win32Thread* win32_thread = thread;
 
-PlatformSemaphore* platform_semaphore_create( const char* name, u32 initial_count ) {
-    HANDLE result = CreateSemaphoreEx(
-        NULL, initial_count, I32_MAX, name, 0, SEMAPHORE_ALL_ACCESS );
-    return (PlatformSemaphore*)result;
-}
-void platform_semaphore_destroy( PlatformSemaphore* semaphore ) {
-    CloseHandle( (PlatformSemaphore*)semaphore );
+    WaitForSingleObject( win32_thread->handle, INFINITE );
+    DWORD return_code = 0;
+    GetExitCodeThread( win32_thread->handle, &return_code );
+    CloseHandle( win32_thread->handle );
+    ___win32_thread_release( win32_thread );
+
+    if( opt_out_return_code ) {
+        *opt_out_return_code = (int)return_code;
+    }
 }
-void platform_semaphore_signal( PlatformSemaphore* semaphore ) {
-    ReleaseSemaphore( (HANDLE)semaphore, 1, NULL );
+void platform_thread_detach( PlatformThread* thread ) {
+    struct Win32Thread* win32_thread = thread;
+    CloseHandle( win32_thread->handle );
+    ___win32_thread_release( win32_thread );
 }
-b32 platform_semaphore_wait( PlatformSemaphore* semaphore, u32 ms ) {
-    DWORD milliseconds = ms == PLATFORM_INFINITE_TIMEOUT ? INFINITE : ms;
-    DWORD result = WaitForSingleObject( (HANDLE)semaphore, milliseconds );
-
-    if( ms != PLATFORM_INFINITE_TIMEOUT ) {
-        return result != WAIT_TIMEOUT;
+b32 platform_thread_set_affinity( u32 logical_cpu ) {
+    // TODO(alicia): processor groups, only first 64 processors can be used.
+    if( logical_cpu >= sizeof(DWORD_PTR) * 8 ) {
+        return false;
+    }
+    if( !SetThreadAffinityMask( GetCurrentThread(), (DWORD_PTR)1 << logical_cpu ) ) {
+        win32_log_warn( "failed to set thread affinity to cpu {u}!", logical_cpu );
+        return false;
     }
     return true;
 }
+typedef HRESULT ___win32_SetThreadDescriptionFN( HANDLE thread, PCWSTR description );
+void platform_thread_set_name( const char* name ) {
+    // NOTE(alicia): SetThreadDescription was added in windows 10 1607,
+    // loaded at runtime so that older versions can still run.
+    ___win32_SetThreadDescriptionFN* set_thread_description =
+        (___win32_SetThreadDescriptionFN*)(void*)GetProcAddress(
+            GetModuleHandleA( "kernel32.dll" ), "SetThreadDescription" );
+    if( !set_thread_description ) {
+        return;
+    }
 
-PlatformMutex* platform_mutex_create( const char* opt_name ) {
-    return (PlatformMutex*)CreateMutexA( NULL, false, opt_name );
+    WCHAR wide_name[64] = {};
+    MultiByteToWideChar(
+        CP_UTF8, 0, name, -1, wide_name, static_array_count( wide_name ) - 1 );
+    set_thread_description( GetCurrentThread(), wide_name );
 }
-void platform_mutex_destroy( PlatformMutex* mutex ) {
-    CloseHandle( (HANDLE)mutex );
+
+struct Win32Fiber {
+    void* handle;
+    PlatformFiberProc* proc;
+    void* params;
+};
+
+internal VOID ___internal_win32_fiber_proc( void* in ) {
+    struct Win32Fiber* fiber = in;
+    fiber->proc( fiber->params );
+    win32_log_fatal( "fiber proc returned!" );
+    ExitThread( 1 );
 }
-b32 platform_mutex_lock( PlatformMutex* mutex, u32 ms ) {
-    DWORD milliseconds = ms == PLATFORM_INFINITE_TIMEOUT ? INFINITE : ms;
-    DWORD result = WaitForSingleObject( (HANDLE)mutex, milliseconds );
-    if( ms != PLATFORM_INFINITE_TIMEOUT ) {
-        return result != WAIT_TIMEOUT;
+
+PlatformFiber* platform_fiber_from_thread(void) {
+    struct Win32Fiber* fiber = HeapAlloc(
+        GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(*fiber) );
+    if( !fiber ) {
+        return NULL;
     }
 
+    fiber->handle = ConvertThreadToFiberEx( NULL, FIBER_FLAG_FLOAT_SWITCH );
+    if( !fiber->handle ) {
+        HeapFree( GetProcessHeap(), 0, fiber );
+        return NULL;
+    }
+    return fiber;
+}
+void platform_fiber_to_thread( PlatformFiber* fiber ) {
+    ConvertFiberToThread();
+    HeapFree( GetProcessHeap(), 0, fiber );
+}
+PlatformFiber* platform_fiber_create(
+    PlatformFiberProc* fiber_proc, void* fiber_proc_params, usize stack_size
+) {
+    struct Win32Fiber* fiber = HeapAlloc(
+        GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(*fiber) );
+    if( !fiber ) {
+        return NULL;
+    }
+
+    fiber->proc   = fiber_proc;
+    fiber->params = fiber_proc_params;
+
+    _ReadWriteBarrier();
+
+    fiber->handle = CreateFiberEx(
+        stack_size, stack_size, FIBER_FLAG_FLOAT_SWITCH,
+        ___internal_win32_fiber_proc, fiber );
+    if( !fiber->handle ) {
+        HeapFree( GetProcessHeap(), 0, fiber );
+        return NULL;
+    }
+    return fiber;
+}
+void platform_fiber_destroy( PlatformFiber* fiber ) {
+    struct Win32Fiber* win32_fiber = fiber;
+    DeleteFiber( win32_fiber->handle );
+    HeapFree( GetProcessHeap(), 0, win32_fiber );
+}
+void platform_fiber_switch( PlatformFiber* current, PlatformFiber* next ) {
+    unused(current);
+    SwitchToFiber( ((struct Win32Fiber*)next)->handle );
+}
+
+b32 platform_futex_wait( volatile u32* address, u32 expected, u32 timeout_ms ) {
+    DWORD milliseconds =
+        timeout_ms == PLATFORM_INFINITE_TIMEOUT ? INFINITE : timeout_ms;
+    if( !WaitOnAddress( address, &expected, sizeof(expected), milliseconds ) ) {
+        return GetLastError() != ERROR_TIMEOUT;
+    }
     return true;
 }
-void platform_mutex_unlock( PlatformMutex* mutex ) {
-    ReleaseMutex( (HANDLE)mutex );
+void platform_futex_wake( volatile u32* address ) {
+    WakeByAddressSingle( (PVOID)address );
+}
+void platform_futex_wake_all( volatile u32* address ) {
+    WakeByAddressAll( (PVOID)address );
 }
 
 void* platform_heap_alloc( usize size ) {
@@ -714,6 +806,54 @@ void platform_heap_free( void* memory, usize size ) {
     unused(size);
     HeapFree( GetProcessHeap(), 0, memory );
 }
+void* platform_page_alloc( usize size ) {
+    return VirtualAlloc( NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE );
+}
+void platform_page_free( void* memory, usize size ) {
+    unused(size);
+    VirtualFree( memory, 0, MEM_RELEASE );
+}
+void* platform_virtual_reserve( usize size ) {
+    return VirtualAlloc( NULL, size, MEM_RESERVE, PAGE_NOACCESS );
+}
+b32 platform_virtual_commit( void* memory, usize size ) {
+    return VirtualAlloc( memory, size, MEM_COMMIT, PAGE_READWRITE ) != NULL;
+}
+void platform_virtual_decommit( void* memory, usize size ) {
+    VirtualFree( memory, size, MEM_DECOMMIT );
+}
+void platform_virtual_release( void* memory, usize size ) {
+    unused(size);
+    VirtualFree( memory, 0, MEM_RELEASE );
+}
+MemoryHugePageKind platform_virtual_advise_huge_pages( void* memory, usize size ) {
+    // NOTE(alicia): windows has no transparent huge pages.
+    unused(memory);
+    unused(size);
+    return MEMORY_HUGE_PAGE_NONE;
+}
+usize platform_huge_page_size(void) {
+    usize result = GetLargePageMinimum();
+    return result ? result : megabytes(2);
+}
+void* platform_huge_page_alloc( usize size, MemoryHugePageKind* out_kind ) {
+    // NOTE(alicia): large pages require SeLockMemoryPrivilege,
+    // without it allocation always fails.
+    if( GetLargePageMinimum() ) {
+        void* result = VirtualAlloc(
+            NULL, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE );
+        if( result ) {
+            *out_kind = MEMORY_HUGE_PAGE_EXPLICIT;
+            return result;
+        }
+    }
+    *out_kind = MEMORY_HUGE_PAGE_NONE;
+    return VirtualAlloc( NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE );
+}
+void platform_huge_page_free( void* memory, usize size ) {
+    unused(size);
+    VirtualFree( memory, 0, MEM_RELEASE );
+}
 void platform_sleep( u32 ms ) {
     Sleep( (DWORD)ms );
 }
@@ -741,6 +881,63 @@ void platform_time_record( struct TimeRecord* out_record ) {
     out_record->second = (u32)system_time.wSecond;
 }
 
+internal void ___win32_query_topology( SystemInfo* out_info ) {
+    out_info->physical_cpu_count = 0;
+
+    DWORD size = 0;
+    GetLogicalProcessorInformation( NULL, &size );
+    if( !size ) {
+        return;
+    }
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION* info_buffer =
+        HeapAlloc( GetProcessHeap(), 0, size );
+    if( !info_buffer ) {
+        return;
+    }
+    if( !GetLogicalProcessorInformation( info_buffer, &size ) ) {
+        HeapFree( GetProcessHeap(), 0, info_buffer );
+        return;
+    }
+
+    usize count = size / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+    for( usize i = 0; i < count; ++i ) {
+        SYSTEM_LOGICAL_PROCESSOR_INFORMATION* info = info_buffer + i;
+        switch( info->Relationship ) {
+            case RelationProcessorCore: {
+                if( out_info->physical_cpu_count < SYSTEM_INFO_MAX_CORE_COUNT ) {
+                    out_info->core_logical_cpu[out_info->physical_cpu_count] =
+                        (u16)__builtin_ctzll( (u64)info->ProcessorMask );
+                }
+                out_info->physical_cpu_count++;
+            } break;
+            case RelationCache: {
+                CACHE_DESCRIPTOR* cache = &info->Cache;
+                if( cache->Type == CacheInstruction ) {
+                    break;
+                }
+                // NOTE(alicia): every core lists its own caches,
+                // they're all the same size so last one wins.
+                switch( cache->Level ) {
+                    case 1:
+                        out_info->l1_cache_size   = cache->Size;
+                        out_info->cache_line_size = cache->LineSize;
+                        break;
+                    case 2:
+                        out_info->l2_cache_size = cache->Size;
+                        break;
+                    case 3:
+                        out_info->l3_cache_size = cache->Size;
+                        break;
+                    default: break;
+                }
+            } break;
+            default: break;
+        }
+    }
+
+    HeapFree( GetProcessHeap(), 0, info_buffer );
+}
+
 void platform_system_info_query( SystemInfo* out_info ) {
     SYSTEM_INFO info = {};
     GetSystemInfo( &info );
@@ -748,50 +945,12 @@ void platform_system_info_query( SystemInfo* out_info ) {
     out_info->page_size = info.dwPageSize;
     out_info->cpu_count = info.dwNumberOfProcessors;
 
-    if( IsProcessorFeaturePresent(
-        PF_XMMI_INSTRUCTIONS_AVAILABLE
-    ) ) {
-        out_info->feature_flags |= CPU_FEATURE_SSE;
-    }
-    if( IsProcessorFeaturePresent(
-        PF_XMMI64_INSTRUCTIONS_AVAILABLE
-    ) ) {
-        out_info->feature_flags |= CPU_FEATURE_SSE2;
-    }
-    if( IsProcessorFeaturePresent(
-        PF_SSE3_INSTRUCTIONS_AVAILABLE
-    ) ) {
-        out_info->feature_flags |= CPU_FEATURE_SSE3;
-    }
-    if( IsProcessorFeaturePresent(
-        PF_SSSE3_INSTRUCTIONS_AVAILABLE
-    ) ) {
-        out_info->feature_flags |= CPU_FEATURE_SSSE3;
-    }
-    if( IsProcessorFeaturePresent(
-        PF_SSE4_1_INSTRUCTIONS_AVAILABLE
-    ) ) {
-        out_info->feature_flags |= CPU_FEATURE_SSE4_1;
-    }
-    if( IsProcessorFeaturePresent(
-        PF_SSE4_2_INSTRUCTIONS_AVAILABLE
-    ) ) {
-        out_info->feature_flags |= CPU_FEATURE_SSE4_2;
-    }
-    if( IsProcessorFeaturePresent(
-        PF_AVX_INSTRUCTIONS_AVAILABLE
-    ) ) {
-        out_info->feature_flags |= CPU_FEATURE_AVX;
-    }
-    if( IsProcessorFeaturePresent(
-        PF_AVX2_INSTRUCTIONS_AVAILABLE
-    ) ) {
-        out_info->feature_flags |= CPU_FEATURE_AVX2;
-    }
-    if( IsProcessorFeaturePresent(
-        PF_AVX512F_INSTRUCTIONS_AVAILABLE
-    ) ) {
-        out_info->feature_flags |= CPU_FEATURE_AVX_512;
+    ___win32_query_topology( out_info );
+    if( !out_info->physical_cpu_count ) {
+        out_info->physical_cpu_count = out_info->cpu_count;
+        for( u16 i = 0; i < out_info->cpu_count && i < SYSTEM_INFO_MAX_CORE_COUNT; ++i ) {
+            out_info->core_logical_cpu[i] = i;
+        }
     }
 
     MEMORYSTATUSEX memory_status = {};
@@ -801,25 +960,22 @@ void platform_system_info_query( SystemInfo* out_info ) {
     out_info->total_memory = memory_status.ullTotalPhys;
 
 #if defined(LD_ARCH_X86)
-    {
-        memory_set( out_info->cpu_name, ' ', SYSTEM_INFO_CPU_NAME_CAPACITY - 1 );
-
-        int cpu_info[4] = {};
-        char* chunk = out_info->cpu_name;
-
-        __cpuid( cpu_info, 0x80000002 );
-        memory_copy( chunk, cpu_info, sizeof(cpu_info) );
-        chunk += sizeof(cpu_info);
-
-        __cpuid( cpu_info, 0x80000003 );
-        memory_copy( chunk, cpu_info, sizeof(cpu_info) );
-        chunk += sizeof(cpu_info);
-
-        __cpuid( cpu_info, 0x80000004 );
-        memory_copy( chunk, cpu_info, sizeof(cpu_info) );
+    // NOTE(alicia): IsProcessorFeaturePresent has no flags for
+    // FMA, BMI or AVX-512 subsets so cpuid is used instead.
+    out_info->feature_flags = ___cpuid_query_features();
+    if( !___cpuid_query_name( out_info->cpu_name ) ) {
+        memory_copy( out_info->cpu_name, "unknown", sizeof("unknown") );
     }
+    if( !out_info->cache_line_size ) {
+        out_info->cache_line_size = ___cpuid_query_cache_line_size();
+    }
+#else
+    memory_copy( out_info->cpu_name, "unknown", sizeof("unknown") );
 #endif /* Arch x86 */
 
+    if( !out_info->cache_line_size ) {
+        out_info->cache_line_size = CACHE_LINE_SIZE;
+    }
 }
 
 void ___format_message( char* buffer, usize buffer_size, DWORD error_code ) {
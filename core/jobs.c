@@ -4,163 +4,1190 @@
  * File Created: December 05, 2023
 */
 #include "shared/defines.h"
+#include "shared/constants.h"
 #include "core/jobs.h"
+#include "core/atomic.h"
 #include "core/sync.h"
 #include "core/memory.h"
+#include "core/ring.h"
+#include "core/rand.h"
+#include "core/collections.h"
+#include "core/system.h"
 #include "core/internal/logging.h"
 #include "core/internal/platform.h"
 
-/// Entry in job stack.
+/// Entry in job queues.
 typedef struct JobEntry {
-    JobProcFN* proc;
-    void*      user_params;
+    JobProcFN*  proc;
+    void*       user_params;
+    JobCounter* counter;
 } JobEntry;
 
-#define JOB_STACK_MAX_ENTRY_COUNT (64)
-typedef struct JobStack {
-    u32 size;
-    u32 thread_count;
-    volatile u32 write_index;
-    volatile u32 read_index;
-    volatile u32 remaining_entries;
-    volatile u32 end_count;
-    volatile b32 end_signal;
+/// Bounds of number of entries in each thread's deque.
+/// Capacity is sized from L2 cache size, see ___job_system_query_deque_capacity.
+#define JOB_DEQUE_MIN_CAPACITY     (256)
+#define JOB_DEQUE_MAX_CAPACITY     (4096)
+/// Deque capacity used when L2 cache size is unknown.
+#define JOB_DEQUE_DEFAULT_CAPACITY (1024)
+/// Fraction of L2 cache that a thread's deques can take up.
+#define JOB_DEQUE_L2_FRACTION      (8)
+/// Number of entries in submission queue, must be a power of two.
+#define JOB_SUBMIT_CAPACITY (1024)
+/// Number of times an idle worker looks for work before sleeping.
+#define JOB_IDLE_SPIN_COUNT (64)
+/// Number of chunks per thread parallel for aims for.
+#define JOB_PARALLEL_FOR_CHUNKS_PER_THREAD (4)
+/// Maximum number of ranges handed out to job system per parallel for.
+#define JOB_PARALLEL_FOR_MAX_TASKS (256)
+/// Number of fibers each job thread owns in fiber mode.
+#define JOB_FIBERS_PER_THREAD (16)
+/// Fiber stack size used when none is provided.
+#define JOB_FIBER_DEFAULT_STACK_SIZE (kilobytes(64))
 
-    JobEntry entries[JOB_STACK_MAX_ENTRY_COUNT];
+/// Chase-Lev work-stealing deque.
+/// Owning thread pushes and pops at bottom,
+/// other threads steal from top.
+/// Entries follow header, capacity is stored in JobSystem.
+typedef struct JobDeque {
+    union {
+        volatile i64 top;
+        u8 ___padding_top[CACHE_LINE_SIZE];
+    };
+    union {
+        volatile i64 bottom;
+        u8 ___padding_bottom[CACHE_LINE_SIZE];
+    };
+    JobEntry entries[];
+} JobDeque;
+static_assert(
+    sizeof(JobDeque) % CACHE_LINE_SIZE == 0,
+    "JobDeque header must be a multiple of cache line size!" );
 
-    Semaphore wake;
-    Semaphore entry_completed;
-    PlatformThread* threads[];
-} JobStack;
+/// Node in overflow list.
+typedef struct JobOverflowNode {
+    struct JobOverflowNode* next;
+    JobEntry entry;
+} JobOverflowNode;
 
-global JobStack* global_job_stack = NULL;
+/// Unbounded list for jobs that did not fit in queues.
+/// Nodes are allocated from job system's slab allocator.
+typedef union JobOverflow {
+    struct {
+        volatile u32     lock;
+        volatile u32     count;
+        JobOverflowNode* head;
+        JobOverflowNode* tail;
+    };
+    u8 ___padding[CACHE_LINE_SIZE];
+} JobOverflow;
+
+/// Job running on its own stack.
+typedef struct JobFiber {
+    PlatformFiber* fiber;
+    /// Entry fiber is running, proc is NULL once entry has completed.
+    JobEntry       entry;
+    /// Counter fiber is suspended on.
+    JobCounter*    wait_counter;
+    usize          thread_index;
+} JobFiber;
+
+/// Fiber state of a job thread, only ever touched by owning thread.
+/// Fibers never move between threads so jobs
+/// keep the same thread index after waiting.
+typedef struct JobWorker {
+    /// Fiber that job thread itself was converted into.
+    PlatformFiber* thread_fiber;
+    /// Fiber currently running, NULL while thread runs on its own stack.
+    JobFiber*      current;
+    u32            free_count;
+    u32            waiting_count;
+    JobFiber*      free[JOB_FIBERS_PER_THREAD];
+    JobFiber*      waiting[JOB_FIBERS_PER_THREAD];
+    JobFiber       fibers[JOB_FIBERS_PER_THREAD];
+} JobWorker;
+
+/// Job thread handle.
+typedef struct JobThread {
+    PlatformThread* handle;
+    /// Logical processor thread pins itself to, U32_MAX if not pinned.
+    u32             logical_cpu;
+} JobThread;
+
+/// Workers are placed on separate cache lines.
+#define JOB_WORKER_STRIDE\
+    ( ( sizeof(JobWorker) + CACHE_LINE_SIZE - 1 ) & ~(usize)( CACHE_LINE_SIZE - 1 ) )
+
+typedef struct JobSystem {
+    union {
+        struct {
+            usize     size;
+            u32       thread_count;
+            /// Number of deques per priority,
+            /// one for each worker plus main thread.
+            u32       deque_count;
+            /// Number of entries in each deque, power of two.
+            u32       deque_capacity;
+            /// Distance in bytes between deques of the same priority.
+            usize     deque_stride;
+            u8*       deques[JOB_PRIORITY_COUNT];
+            RingMPMC* submit[JOB_PRIORITY_COUNT];
+            JobThread*       threads;
+            SlabAllocator*   overflow_allocator;
+            /// Worker fiber state, NULL if fiber mode is disabled.
+            u8*              workers;
+            usize            fiber_stack_size;
+            Semaphore wake;
+            Semaphore entry_completed;
+            Semaphore submit_space;
+        };
+        u8 ___padding_shared[CACHE_LINE_SIZE * 3];
+    };
+    union {
+        struct {
+            volatile u32 remaining_entries;
+            volatile u32 sleeping;
+            volatile u32 push_waiting;
+            volatile u32 end_count;
+            volatile b32 end_signal;
+        };
+        u8 ___padding_counters[CACHE_LINE_SIZE];
+    };
+    JobOverflow overflow[JOB_PRIORITY_COUNT];
+} JobSystem;
+static_assert(
+    sizeof(JobSystem) % CACHE_LINE_SIZE == 0,
+    "JobSystem must be a multiple of cache line size!" );
+
+global JobSystem* global_job_system = NULL;
+/// Deque capacity, 0 until first queried.
+global u32 global_job_deque_capacity = 0;
+
+/// Slab allocator has a cache for each deque
+/// plus one per priority shared by external threads.
+#define JOB_OVERFLOW_ALLOCATOR_THREAD_COUNT( thread_count )\
+    ( (thread_count) + 1 + JOB_PRIORITY_COUNT )
+
+/// Get number of entries in each deque.
+/// Deques of one thread (one per priority) take up at most
+/// 1/JOB_DEQUE_L2_FRACTION of L2 cache so that a thread working
+/// through its own deque does not evict data its jobs are working on.
+internal u32 ___job_system_query_deque_capacity(void) {
+    if( global_job_deque_capacity ) {
+        return global_job_deque_capacity;
+    }
+
+    SystemInfo system_info = {};
+    platform_system_info_query( &system_info );
+
+    u32 capacity = JOB_DEQUE_DEFAULT_CAPACITY;
+    if( system_info.l2_cache_size ) {
+        usize budget =
+            system_info.l2_cache_size /
+            ( JOB_DEQUE_L2_FRACTION * JOB_PRIORITY_COUNT * sizeof(JobEntry) );
+
+        capacity = JOB_DEQUE_MAX_CAPACITY;
+        while( capacity > JOB_DEQUE_MIN_CAPACITY && capacity > budget ) {
+            capacity /= 2;
+        }
+    }
+
+    global_job_deque_capacity = capacity;
+    return capacity;
+}
+/// Get size of deque header plus entries, rounded up to cache line size.
+internal usize ___job_system_query_deque_stride( u32 capacity ) {
+    usize size = sizeof(JobDeque) + ( sizeof(JobEntry) * capacity );
+    return ( size + CACHE_LINE_SIZE - 1 ) & ~(usize)( CACHE_LINE_SIZE - 1 );
+}
 
 CORE_API usize job_system_query_memory_requirement( u32 thread_count ) {
-    return sizeof( JobStack ) + (sizeof( PlatformThread* ) * thread_count);
+    usize deque_stride =
+        ___job_system_query_deque_stride( ___job_system_query_deque_capacity() );
+    // NOTE(alicia): extra cache line for aligning buffer.
+    return
+        sizeof(JobSystem) +
+        ( deque_stride * ( thread_count + 1 ) * JOB_PRIORITY_COUNT ) +
+        ( ring_mpmc_memory_requirement(
+            JOB_SUBMIT_CAPACITY, sizeof(JobEntry) ) * JOB_PRIORITY_COUNT ) +
+        ( sizeof(JobThread) * thread_count ) +
+        ( JOB_WORKER_STRIDE * ( thread_count + 1 ) ) +
+        slab_allocator_memory_requirement(
+            JOB_OVERFLOW_ALLOCATOR_THREAD_COUNT( thread_count ) ) +
+        CACHE_LINE_SIZE;
+}
+
+/// Get deque of given priority owned by thread.
+internal force_inline JobDeque* ___job_system_deque(
+    JobPriority priority, usize thread_index
+) {
+    return (JobDeque*)(
+        global_job_system->deques[priority] +
+        ( global_job_system->deque_stride * thread_index ) );
+}
+
+internal force_inline void ___job_entry_store( JobEntry* dst, JobEntry entry ) {
+    atomic_store_ptr( &dst->proc, (void*)entry.proc, MEMORY_ORDER_RELAXED );
+    atomic_store_ptr( &dst->user_params, entry.user_params, MEMORY_ORDER_RELAXED );
+    atomic_store_ptr( &dst->counter, entry.counter, MEMORY_ORDER_RELAXED );
+}
+internal force_inline JobEntry ___job_entry_load( JobEntry* src ) {
+    JobEntry result;
+    result.proc        = (JobProcFN*)atomic_load_ptr( &src->proc, MEMORY_ORDER_RELAXED );
+    result.user_params = atomic_load_ptr( &src->user_params, MEMORY_ORDER_RELAXED );
+    result.counter     = atomic_load_ptr( &src->counter, MEMORY_ORDER_RELAXED );
+    return result;
 }
 
-internal b32 ___internal_job_system_pop( JobEntry* out_entry ) {
+/// Push onto bottom of deque, only called by owning thread.
+internal b32 ___job_deque_push( JobDeque* deque, JobEntry entry ) {
+    i64 bottom = atomic_load_i64( &deque->bottom, MEMORY_ORDER_RELAXED );
+    i64 top    = atomic_load_i64( &deque->top, MEMORY_ORDER_ACQUIRE );
+    u32 capacity = global_job_system->deque_capacity;
+    if( bottom - top >= capacity ) {
+        return false;
+    }
+    ___job_entry_store(
+        deque->entries + ( bottom & ( capacity - 1 ) ), entry );
+    atomic_store_i64( &deque->bottom, bottom + 1, MEMORY_ORDER_RELEASE );
+    return true;
+}
+/// Pop from bottom of deque, only called by owning thread.
+internal b32 ___job_deque_pop( JobDeque* deque, JobEntry* out_entry ) {
+    // NOTE(alicia): bottom store and top load are sequentially consistent
+    // instead of being separated by a full fence, store compiles to xchg
+    // on x86 and thieves get away with plain loads.
+    i64 bottom = atomic_load_i64( &deque->bottom, MEMORY_ORDER_RELAXED ) - 1;
+    atomic_store_i64( &deque->bottom, bottom, MEMORY_ORDER_SEQ_CST );
+    i64 top = atomic_load_i64( &deque->top, MEMORY_ORDER_SEQ_CST );
+
+    if( top > bottom ) {
+        atomic_store_i64( &deque->bottom, bottom + 1, MEMORY_ORDER_RELAXED );
+        return false;
+    }
+
+    *out_entry = ___job_entry_load(
+        deque->entries + ( bottom & ( global_job_system->deque_capacity - 1 ) ) );
+    if( top != bottom ) {
+        return true;
+    }
+
+    // NOTE(alicia): last entry, race thieves for it.
+    b32 won = atomic_compare_exchange_i64(
+        &deque->top, &top, top + 1,
+        MEMORY_ORDER_SEQ_CST, MEMORY_ORDER_RELAXED );
+    atomic_store_i64( &deque->bottom, bottom + 1, MEMORY_ORDER_RELAXED );
+    return won;
+}
+/// Steal from top of deque, called by any thread.
+internal b32 ___job_deque_steal( JobDeque* deque, JobEntry* out_entry ) {
+    i64 top    = atomic_load_i64( &deque->top, MEMORY_ORDER_SEQ_CST );
+    i64 bottom = atomic_load_i64( &deque->bottom, MEMORY_ORDER_SEQ_CST );
+    if( top >= bottom ) {
+        return false;
+    }
+
+    // NOTE(alicia): entry may be overwritten by owner once another thief
+    // takes it, in that case compare exchange fails and entry is discarded.
+    JobEntry entry = ___job_entry_load(
+        deque->entries + ( top & ( global_job_system->deque_capacity - 1 ) ) );
+    if( !atomic_compare_exchange_i64(
+        &deque->top, &top, top + 1,
+        MEMORY_ORDER_SEQ_CST, MEMORY_ORDER_RELAXED
+    ) ) {
+        return false;
+    }
+    *out_entry = entry;
+    return true;
+}
+internal b32 ___job_deque_is_empty( JobDeque* deque ) {
+    i64 top    = atomic_load_i64( &deque->top, MEMORY_ORDER_ACQUIRE );
+    i64 bottom = atomic_load_i64( &deque->bottom, MEMORY_ORDER_ACQUIRE );
+    return top >= bottom;
+}
+
+internal force_inline void ___job_overflow_lock( volatile u32* lock ) {
+    u32 expected = 0;
+    while( !atomic_compare_exchange_weak_u32(
+        lock, &expected, 1, MEMORY_ORDER_ACQUIRE, MEMORY_ORDER_RELAXED
+    ) ) {
+        while( atomic_load_u32( lock, MEMORY_ORDER_RELAXED ) ) {
+            cpu_pause();
+        }
+        expected = 0;
+    }
+}
+internal force_inline void ___job_overflow_unlock( volatile u32* lock ) {
+    atomic_store_u32( lock, 0, MEMORY_ORDER_RELEASE );
+}
+/// Slab allocator cache index for thread.
+/// External threads use the cache of given priority,
+/// it must only be touched while holding that priority's overflow lock.
+internal force_inline usize ___job_overflow_cache_index(
+    usize thread_index, JobPriority priority
+) {
+    if( thread_index == JOB_THREAD_INDEX_EXTERNAL ) {
+        return global_job_system->deque_count + priority;
+    }
+    return thread_index;
+}
+/// Append entry to overflow list.
+/// Only fails if slab allocator runs out of memory.
+internal b32 ___job_overflow_push(
+    usize thread_index, JobPriority priority, JobEntry entry
+) {
+    JobOverflow* overflow = global_job_system->overflow + priority;
+
+    // NOTE(alicia): external threads share an allocator cache
+    // per priority so allocation happens while holding this
+    // priority's overflow lock.
+    ___job_overflow_lock( &overflow->lock );
+    JobOverflowNode* node = slab_allocator_alloc(
+        global_job_system->overflow_allocator,
+        ___job_overflow_cache_index( thread_index, priority ),
+        sizeof(JobOverflowNode) );
+    if( !node ) {
+        ___job_overflow_unlock( &overflow->lock );
+        core_log_fatal( "job system failed to allocate overflow node!" );
+        return false;
+    }
+    node->entry = entry;
+    if( overflow->tail ) {
+        overflow->tail->next = node;
+    } else {
+        overflow->head = node;
+    }
+    overflow->tail = node;
+    atomic_fetch_add_u32( &overflow->count, 1, MEMORY_ORDER_RELAXED );
+    ___job_overflow_unlock( &overflow->lock );
+    return true;
+}
+internal b32 ___job_overflow_pop(
+    usize thread_index, JobPriority priority, JobEntry* out_entry
+) {
+    JobOverflow* overflow = global_job_system->overflow + priority;
+    if( !atomic_load_u32( &overflow->count, MEMORY_ORDER_RELAXED ) ) {
+        return false;
+    }
+
+    ___job_overflow_lock( &overflow->lock );
+    JobOverflowNode* node = overflow->head;
+    if( node ) {
+        overflow->head = node->next;
+        if( !overflow->head ) {
+            overflow->tail = NULL;
+        }
+        atomic_fetch_sub_u32( &overflow->count, 1, MEMORY_ORDER_RELAXED );
+
+        *out_entry = node->entry;
+        slab_allocator_free(
+            global_job_system->overflow_allocator,
+            ___job_overflow_cache_index( thread_index, priority ),
+            node, sizeof(JobOverflowNode) );
+    }
+    ___job_overflow_unlock( &overflow->lock );
+    return node != NULL;
+}
+
+/// Check if any queue has entries.
+internal b32 ___job_system_has_work(void) {
+    JobSystem* system = global_job_system;
+    for( JobPriority priority = 0; priority < JOB_PRIORITY_COUNT; ++priority ) {
+        if(
+            ring_mpmc_count( system->submit[priority] ) ||
+            atomic_load_u32( &system->overflow[priority].count, MEMORY_ORDER_RELAXED )
+        ) {
+            return true;
+        }
+        for( u32 i = 0; i < system->deque_count; ++i ) {
+            if( !___job_deque_is_empty( ___job_system_deque( priority, i ) ) ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+/// Pop from submission queue and wake a thread blocked on pushing.
+internal b32 ___job_system_pop_submit( JobPriority priority, JobEntry* out_entry ) {
+    if( !ring_mpmc_pop( global_job_system->submit[priority], out_entry ) ) {
+        return false;
+    }
+    if( priority == JOB_PRIORITY_NORMAL ) {
+        // NOTE(alicia): pairs with push_waiting increment in job_system_push_wait.
+        atomic_fence( MEMORY_ORDER_SEQ_CST );
+        if( atomic_load_u32( &global_job_system->push_waiting, MEMORY_ORDER_RELAXED ) ) {
+            semaphore_signal( &global_job_system->submit_space );
+        }
+    }
+    return true;
+}
+/// Find next job of given priority for thread.
+/// Own deque first, then submission queue, then overflow list,
+/// then steal from other threads starting at a random one.
+internal b32 ___job_system_next_priority(
+    usize thread_index, JobPriority priority,
+    RandState* rand_state, JobEntry* out_entry
+) {
+    JobSystem* system = global_job_system;
+    if(
+        thread_index != JOB_THREAD_INDEX_EXTERNAL &&
+        ___job_deque_pop( ___job_system_deque( priority, thread_index ), out_entry )
+    ) {
+        return true;
+    }
+    if( ___job_system_pop_submit( priority, out_entry ) ) {
+        return true;
+    }
+    if( ___job_overflow_pop( thread_index, priority, out_entry ) ) {
+        return true;
+    }
+
+    u32 start = rand_xor_u32_state( rand_state ) % system->deque_count;
+    for( u32 i = 0; i < system->deque_count; ++i ) {
+        u32 victim = ( start + i ) % system->deque_count;
+        if( victim == thread_index ) {
+            continue;
+        }
+        if( ___job_deque_steal( ___job_system_deque( priority, victim ), out_entry ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+/// Find next job for thread.
+/// Higher priority queues are always drained first.
+internal b32 ___job_system_next(
+    usize thread_index, RandState* rand_state, JobEntry* out_entry
+) {
+    for( JobPriority priority = 0; priority < JOB_PRIORITY_COUNT; ++priority ) {
+        if( ___job_system_next_priority(
+            thread_index, priority, rand_state, out_entry
+        ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+/// Mark that a job is about to be added.
+/// Must happen before job is visible to workers
+/// so that remaining entries never drops below zero.
+internal force_inline void ___job_system_begin_entry(void) {
+    // NOTE(alicia): publishing job is a release, so any thread that
+    // ends entry is guaranteed to see this increment.
+    atomic_fetch_add_u32(
+        &global_job_system->remaining_entries, 1, MEMORY_ORDER_RELAXED );
+}
+/// Mark that a job has completed or could not be added.
+internal force_inline void ___job_system_end_entry(void) {
+    if( atomic_fetch_sub_u32(
+        &global_job_system->remaining_entries, 1, MEMORY_ORDER_ACQ_REL ) == 1
+    ) {
+        semaphore_signal( &global_job_system->entry_completed );
+    }
+}
+/// Wake a sleeping worker after a job was added.
+internal void ___job_system_wake(void) {
+    // NOTE(alicia): full barrier so that either a worker going to sleep
+    // sees the new job or this sees that it's going to sleep.
+    // This is the only fence on push path.
+    atomic_fence( MEMORY_ORDER_SEQ_CST );
+    if( atomic_load_u32( &global_job_system->sleeping, MEMORY_ORDER_RELAXED ) ) {
+        semaphore_signal( &global_job_system->wake );
+    }
+}
+/// Add entry to thread's deque or to submission queue
+/// for external threads and when thread's deque is full.
+internal b32 ___job_system_push_entry(
+    usize thread_index, JobPriority priority, JobEntry entry
+) {
+    ___job_system_begin_entry();
     if(
-        global_job_stack->read_index == global_job_stack->write_index ||
-        global_job_stack->end_signal
+        thread_index == JOB_THREAD_INDEX_EXTERNAL ||
+        !___job_deque_push( ___job_system_deque( priority, thread_index ), entry )
     ) {
+        if( !ring_mpmc_push( global_job_system->submit[priority], &entry ) ) {
+            ___job_system_end_entry();
+            return false;
+        }
+    }
+    ___job_system_wake();
+    return true;
+}
+/// Add entry to queues or to overflow list if queues are saturated.
+internal b32 ___job_system_push_entry_unbounded(
+    usize thread_index, JobPriority priority, JobEntry entry
+) {
+    if( ___job_system_push_entry( thread_index, priority, entry ) ) {
+        return true;
+    }
+    ___job_system_begin_entry();
+    if( !___job_overflow_push( thread_index, priority, entry ) ) {
+        ___job_system_end_entry();
         return false;
     }
+    ___job_system_wake();
+    return true;
+}
 
-    usize read_index = interlocked_increment( &global_job_stack->read_index );
-    read_write_fence();
+internal void ___job_counter_release( usize thread_index, JobCounter* counter );
 
-    read_index %= JOB_STACK_MAX_ENTRY_COUNT;
+internal void ___job_system_run( usize thread_index, JobEntry* entry ) {
+    entry->proc( thread_index, entry->user_params );
+    // NOTE(alicia): counter is released before entry is ended so that
+    // continuation is counted before remaining entries can reach zero.
+    if( entry->counter ) {
+        ___job_counter_release( thread_index, entry->counter );
+    }
+    ___job_system_end_entry();
+}
+internal void ___job_counter_release( usize thread_index, JobCounter* counter ) {
+    // NOTE(alicia): waiting thread is free to discard counter as soon as
+    // it reaches zero so continuation has to be taken out of counter
+    // before last decrement instead of after it.
+    u32 value = atomic_load_u32( &counter->value, MEMORY_ORDER_RELAXED );
+    loop {
+        if( value != 1 ) {
+            if( atomic_compare_exchange_weak_u32(
+                &counter->value, &value, value - 1,
+                MEMORY_ORDER_ACQ_REL, MEMORY_ORDER_RELAXED
+            ) ) {
+                return;
+            }
+            continue;
+        }
 
-    *out_entry = global_job_stack->entries[read_index];
-    return true;
+        JobEntry entry    = {};
+        entry.proc        = (JobProcFN*)atomic_exchange_ptr(
+            &counter->continuation, NULL, MEMORY_ORDER_ACQ_REL );
+        entry.user_params = counter->continuation_params;
+        entry.counter     = counter->continuation_counter;
+        JobPriority priority = counter->continuation_priority;
+
+        if( atomic_compare_exchange_u32(
+            &counter->value, &value, 0,
+            MEMORY_ORDER_ACQ_REL, MEMORY_ORDER_RELAXED
+        ) ) {
+            if( entry.proc ) {
+                ___job_system_push_entry_unbounded( thread_index, priority, entry );
+            }
+            return;
+        }
+
+        // NOTE(alicia): more jobs were pushed, this is no longer last one.
+        if( entry.proc ) {
+            atomic_store_ptr(
+                &counter->continuation, (void*)entry.proc, MEMORY_ORDER_RELEASE );
+        }
+    }
+}
+
+/// Get fiber state of a job thread.
+/// Returns NULL if fiber mode is disabled or thread has no fibers.
+internal force_inline JobWorker* ___job_system_worker( usize thread_index ) {
+    if(
+        !global_job_system->workers || !thread_index ||
+        thread_index == JOB_THREAD_INDEX_EXTERNAL
+    ) {
+        return NULL;
+    }
+    JobWorker* worker = (JobWorker*)(
+        global_job_system->workers + ( JOB_WORKER_STRIDE * thread_index ) );
+    return worker->thread_fiber ? worker : NULL;
+}
+internal void ___job_fiber_proc( void* user_params ) {
+    JobFiber*  fiber  = user_params;
+    JobWorker* worker = ___job_system_worker( fiber->thread_index );
+    loop {
+        ___job_system_run( fiber->thread_index, &fiber->entry );
+        fiber->entry.proc = NULL;
+        platform_fiber_switch( fiber->fiber, worker->thread_fiber );
+    }
+}
+/// Switch from thread's own stack to fiber.
+/// Once fiber switches back it either completed its job
+/// or suspended itself waiting on a counter.
+internal void ___job_worker_switch( JobWorker* worker, JobFiber* fiber ) {
+    worker->current = fiber;
+    platform_fiber_switch( worker->thread_fiber, fiber->fiber );
+    worker->current = NULL;
+
+    if( fiber->entry.proc ) {
+        worker->waiting[worker->waiting_count++] = fiber;
+    } else {
+        worker->free[worker->free_count++] = fiber;
+    }
+}
+/// Resume a suspended fiber whose counter has reached zero.
+internal b32 ___job_worker_resume( JobWorker* worker ) {
+    for( u32 i = 0; i < worker->waiting_count; ++i ) {
+        JobFiber* fiber = worker->waiting[i];
+        // NOTE(alicia): counter lives at least as long as
+        // fiber waiting on it, so it's safe to read here.
+        if( atomic_load_u32( &fiber->wait_counter->value, MEMORY_ORDER_ACQUIRE ) ) {
+            continue;
+        }
+        worker->waiting[i]  = worker->waiting[--worker->waiting_count];
+        fiber->wait_counter = NULL;
+
+        ___job_worker_switch( worker, fiber );
+        return true;
+    }
+    return false;
+}
+/// Run entry on a free fiber if thread has one,
+/// otherwise run it on calling thread's stack.
+internal void ___job_system_execute( usize thread_index, JobEntry* entry ) {
+    JobWorker* worker = ___job_system_worker( thread_index );
+    if( worker && !worker->current && worker->free_count ) {
+        JobFiber* fiber = worker->free[--worker->free_count];
+        fiber->entry    = *entry;
+        ___job_worker_switch( worker, fiber );
+        return;
+    }
+    ___job_system_run( thread_index, entry );
+}
+/// Convert job thread to a fiber and create its fiber pool.
+internal void ___job_worker_initialize( usize thread_index ) {
+    JobWorker* worker = (JobWorker*)(
+        global_job_system->workers + ( JOB_WORKER_STRIDE * thread_index ) );
+
+    worker->thread_fiber = platform_fiber_from_thread();
+    if( !worker->thread_fiber ) {
+        core_log_error(
+            "job system failed to convert thread {usize} to fiber, "
+            "jobs will run on thread stack!", thread_index );
+        return;
+    }
+
+    for( u32 i = 0; i < JOB_FIBERS_PER_THREAD; ++i ) {
+        JobFiber* fiber     = worker->fibers + i;
+        fiber->thread_index = thread_index;
+        fiber->fiber        = platform_fiber_create(
+            ___job_fiber_proc, fiber, global_job_system->fiber_stack_size );
+        if( !fiber->fiber ) {
+            core_log_error(
+                "job system failed to create fiber {u} for thread {usize}!",
+                i, thread_index );
+            break;
+        }
+        worker->free[worker->free_count++] = fiber;
+    }
+}
+internal void ___job_worker_shutdown( usize thread_index ) {
+    JobWorker* worker = ___job_system_worker( thread_index );
+    if( !worker ) {
+        return;
+    }
+    // NOTE(alicia): fibers still suspended on counters are discarded.
+    for( u32 i = 0; i < JOB_FIBERS_PER_THREAD; ++i ) {
+        if( worker->fibers[i].fiber ) {
+            platform_fiber_destroy( worker->fibers[i].fiber );
+        }
+    }
+    platform_fiber_to_thread( worker->thread_fiber );
+    memory_zero( worker, sizeof(JobWorker) );
 }
 
 internal int ___internal_job_system_proc( void* user_params ) {
     usize thread_index = (usize)user_params;
+    RandState rand_state = rand_init_state( (i32)( thread_index * 7919 ) + 1 );
+
+    // NOTE(alicia): name is "job N", digits are written back to front.
+    char name[16] = "job ";
+    usize name_len = 4;
+    for( usize digits = thread_index; digits >= 10; digits /= 10 ) {
+        name_len++;
+    }
+    for( usize digits = thread_index, i = name_len; ; digits /= 10 ) {
+        name[i--] = '0' + (char)( digits % 10 );
+        if( digits < 10 ) {
+            break;
+        }
+    }
+    platform_thread_set_name( name );
+
+    u32 logical_cpu = global_job_system->threads[thread_index - 1].logical_cpu;
+    if(
+        logical_cpu != U32_MAX &&
+        !platform_thread_set_affinity( logical_cpu )
+    ) {
+        core_log_warn(
+            "job system failed to pin thread {usize} to cpu {u32}!",
+            thread_index, logical_cpu );
+    }
+
+    if( global_job_system->workers ) {
+        ___job_worker_initialize( thread_index );
+    }
+    JobWorker* worker = ___job_system_worker( thread_index );
+
+    u32 idle_count = 0;
     loop {
+        if( atomic_load_u32( &global_job_system->end_signal, MEMORY_ORDER_ACQUIRE ) ) {
+            break;
+        }
+
+        if( worker && ___job_worker_resume( worker ) ) {
+            idle_count = 0;
+            continue;
+        }
+
         JobEntry entry = {};
-        semaphore_wait( &global_job_stack->wake );
-        read_write_fence();
+        if( ___job_system_next( thread_index, &rand_state, &entry ) ) {
+            ___job_system_execute( thread_index, &entry );
+            idle_count = 0;
+            continue;
+        }
 
-        if( global_job_stack->end_signal ) {
-            interlocked_increment( &global_job_stack->end_count );
-            break;
+        if( idle_count++ < JOB_IDLE_SPIN_COUNT ) {
+            cpu_pause();
+            continue;
         }
+        idle_count = 0;
 
-        if( ___internal_job_system_pop( &entry ) ) {
-            read_write_fence();
-            entry.proc( thread_index, entry.user_params );
-            read_write_fence();
-            interlocked_decrement( &global_job_stack->remaining_entries );
-            semaphore_signal( &global_job_stack->entry_completed );
+        // NOTE(alicia): pairs with fence in ___job_system_wake.
+        atomic_fetch_add_u32( &global_job_system->sleeping, 1, MEMORY_ORDER_SEQ_CST );
+        atomic_fence( MEMORY_ORDER_SEQ_CST );
+        if(
+            !___job_system_has_work() &&
+            !atomic_load_u32( &global_job_system->end_signal, MEMORY_ORDER_ACQUIRE )
+        ) {
+            // NOTE(alicia): nothing signals a thread when counters
+            // of its suspended fibers complete, so it checks back regularly.
+            if( worker && worker->waiting_count ) {
+                semaphore_wait_timed( &global_job_system->wake, 1 );
+            } else {
+                semaphore_wait( &global_job_system->wake );
+            }
         }
+        atomic_fetch_sub_u32( &global_job_system->sleeping, 1, MEMORY_ORDER_RELAXED );
     }
 
+    ___job_worker_shutdown( thread_index );
+    atomic_fetch_add_u32( &global_job_system->end_count, 1, MEMORY_ORDER_RELEASE );
     return 0;
 }
-CORE_API b32 job_system_initialize( u32 thread_count, void* buffer ) {
-    global_job_stack       = buffer;
-    global_job_stack->size = job_system_query_memory_requirement( thread_count );
+internal b32 ___job_system_initialize(
+    u32 thread_count, b32 use_fibers, usize fiber_stack_size, void* buffer
+) {
+    JobSystem* system = memory_align( buffer, CACHE_LINE_SIZE );
+    memory_zero( system, sizeof(JobSystem) );
+
+    system->size           = job_system_query_memory_requirement( thread_count );
+    system->deque_count    = thread_count + 1;
+    system->deque_capacity = ___job_system_query_deque_capacity();
+    system->deque_stride   = ___job_system_query_deque_stride( system->deque_capacity );
+
+    usize submit_size =
+        ring_mpmc_memory_requirement( JOB_SUBMIT_CAPACITY, sizeof(JobEntry) );
+    u8* at = (u8*)( system + 1 );
+    for( JobPriority priority = 0; priority < JOB_PRIORITY_COUNT; ++priority ) {
+        system->deques[priority] = at;
+        memory_zero( at, system->deque_stride * system->deque_count );
+        at += system->deque_stride * system->deque_count;
+    }
+    for( JobPriority priority = 0; priority < JOB_PRIORITY_COUNT; ++priority ) {
+        system->submit[priority] = ring_mpmc_create(
+            JOB_SUBMIT_CAPACITY, sizeof(JobEntry), at );
+        at += submit_size;
+    }
+    system->threads = (JobThread*)at;
+    at += sizeof(JobThread) * thread_count;
+    if( use_fibers ) {
+        system->workers          = at;
+        system->fiber_stack_size = fiber_stack_size ?
+            fiber_stack_size : JOB_FIBER_DEFAULT_STACK_SIZE;
+        memory_zero( at, JOB_WORKER_STRIDE * system->deque_count );
+    }
+    at += JOB_WORKER_STRIDE * system->deque_count;
+    system->overflow_allocator = slab_allocator_create(
+        JOB_OVERFLOW_ALLOCATOR_THREAD_COUNT( thread_count ), at );
+
+    global_job_system = system;
 
-    if( !semaphore_create( &global_job_stack->wake ) ) {
+    if( !semaphore_create( &system->wake ) ) {
         core_log_fatal( "failed to create job system wake semaphore!" );
+        global_job_system = NULL;
         return false;
     }
-    if( !semaphore_create( &global_job_stack->entry_completed ) ) {
+    if( !semaphore_create( &system->entry_completed ) ) {
         core_log_fatal( "failed to create job system entry completed semaphore!" );
-        semaphore_destroy( &global_job_stack->wake );
+        semaphore_destroy( &system->wake );
+        global_job_system = NULL;
+        return false;
+    }
+    if( !semaphore_create( &system->submit_space ) ) {
+        core_log_fatal( "failed to create job system submit space semaphore!" );
+        semaphore_destroy( &system->entry_completed );
+        semaphore_destroy( &system->wake );
+        global_job_system = NULL;
         return false;
     }
 
-    read_write_fence();
+    // NOTE(alicia): threads are only pinned when each one, including
+    // main thread, gets a physical core to itself. Main thread is left
+    // to scheduler, it ends up on first core since others are taken.
+    // With more threads than cores pinning only gets in scheduler's way.
+    SystemInfo system_info = {};
+    platform_system_info_query( &system_info );
+    b32 pin_threads =
+        ( thread_count + 1 ) <= system_info.physical_cpu_count &&
+        ( thread_count + 1 ) <= SYSTEM_INFO_MAX_CORE_COUNT;
 
+    // NOTE(alicia): creating a thread publishes everything written
+    // before it to new thread, no fence needed.
     for( u32 i = 0; i < thread_count; ++i ) {
         usize thread_index = i + 1;
 
-        global_job_stack->threads[i] = platform_thread_create(
+        system->threads[i].logical_cpu = pin_threads ?
+            system_info.core_logical_cpu[thread_index] : U32_MAX;
+        system->threads[i].handle = platform_thread_create(
             ___internal_job_system_proc, (void*)thread_index, STACK_SIZE );
 
-        if( !global_job_stack->threads[i] ) {
+        if( !system->threads[i].handle ) {
             core_log_fatal( "job system failed to create thread {u}!", i );
             job_system_shutdown();
             return false;
         }
 
-        global_job_stack->thread_count++;
+        system->thread_count++;
     }
 
-    read_write_fence();
     return true;
 }
+CORE_API b32 job_system_initialize( u32 thread_count, void* buffer ) {
+    return ___job_system_initialize( thread_count, false, 0, buffer );
+}
+CORE_API b32 job_system_initialize_fibers(
+    u32 thread_count, usize fiber_stack_size, void* buffer
+) {
+    return ___job_system_initialize( thread_count, true, fiber_stack_size, buffer );
+}
 CORE_API void job_system_shutdown(void) {
-    if( !global_job_stack ) {
+    if( !global_job_system ) {
         return;
     }
-    global_job_stack->end_signal = true;
-    read_write_fence();
+    atomic_store_u32( &global_job_system->end_signal, true, MEMORY_ORDER_RELEASE );
 
-    do {
-        semaphore_signal( &global_job_stack->wake );
-    } while( global_job_stack->end_count < global_job_stack->thread_count );
+    while(
+        atomic_load_u32( &global_job_system->end_count, MEMORY_ORDER_ACQUIRE ) <
+        global_job_system->thread_count
+    ) {
+        semaphore_signal( &global_job_system->wake );
+        cpu_pause();
+    }
+    for( u32 i = 0; i < global_job_system->thread_count; ++i ) {
+        platform_thread_join( global_job_system->threads[i].handle, NULL );
+    }
 
-    read_write_fence();
-    semaphore_destroy( &global_job_stack->wake );
-    semaphore_destroy( &global_job_stack->entry_completed );
+    semaphore_destroy( &global_job_system->wake );
+    semaphore_destroy( &global_job_system->entry_completed );
+    semaphore_destroy( &global_job_system->submit_space );
+    // NOTE(alicia): entries left in overflow lists are discarded
+    // along with their nodes.
+    slab_allocator_destroy( global_job_system->overflow_allocator );
 
-    memory_zero( global_job_stack, global_job_stack->size );
+    memory_zero( global_job_system, sizeof(JobSystem) );
+    global_job_system = NULL;
+}
+CORE_API u32 job_system_query_thread_count(void) {
+    if( !global_job_system ) {
+        return 0;
+    }
+    return global_job_system->thread_count;
 }
 
 CORE_API b32 job_system_push( JobProcFN* job, void* user_params ) {
-    read_write_fence();
-    if( global_job_stack->remaining_entries >= JOB_STACK_MAX_ENTRY_COUNT ) {
+    JobEntry entry = { job, user_params, NULL };
+    return ___job_system_push_entry(
+        JOB_THREAD_INDEX_EXTERNAL, JOB_PRIORITY_NORMAL, entry );
+}
+CORE_API void job_system_push_wait( JobProcFN* job, void* user_params ) {
+    while( !job_system_push( job, user_params ) ) {
+        atomic_fetch_add_u32(
+            &global_job_system->push_waiting, 1, MEMORY_ORDER_SEQ_CST );
+        // NOTE(alicia): recheck after announcing that this thread is waiting,
+        // queue may have drained before workers could see it.
+        if(
+            ring_mpmc_count( global_job_system->submit[JOB_PRIORITY_NORMAL] ) >=
+            JOB_SUBMIT_CAPACITY
+        ) {
+            semaphore_wait( &global_job_system->submit_space );
+        }
+        atomic_fetch_sub_u32(
+            &global_job_system->push_waiting, 1, MEMORY_ORDER_RELAXED );
+    }
+}
+CORE_API b32 job_system_push_wait_timed( JobProcFN* job, void* user_params, u32 ms ) {
+    f64 end = platform_time_query_elapsed_seconds() + ( (f64)ms / 1000.0 );
+    while( !job_system_push( job, user_params ) ) {
+        f64 remaining = end - platform_time_query_elapsed_seconds();
+        if( remaining <= 0.0 ) {
+            return false;
+        }
+
+        b32 timed_out = false;
+        atomic_fetch_add_u32(
+            &global_job_system->push_waiting, 1, MEMORY_ORDER_SEQ_CST );
+        if(
+            ring_mpmc_count( global_job_system->submit[JOB_PRIORITY_NORMAL] ) >=
+            JOB_SUBMIT_CAPACITY
+        ) {
+            timed_out = !semaphore_wait_timed(
+                &global_job_system->submit_space, (u32)( remaining * 1000.0 ) + 1 );
+        }
+        atomic_fetch_sub_u32(
+            &global_job_system->push_waiting, 1, MEMORY_ORDER_RELAXED );
+
+        if( timed_out ) {
+            return job_system_push( job, user_params );
+        }
+    }
+    return true;
+}
+CORE_API b32 job_system_push_priority(
+    usize thread_index, JobPriority priority,
+    JobProcFN* job, void* user_params, JobCounter* opt_counter
+) {
+    assert( priority < JOB_PRIORITY_COUNT );
+    assert(
+        thread_index == JOB_THREAD_INDEX_EXTERNAL ||
+        thread_index < global_job_system->deque_count );
+    JobEntry entry = { job, user_params, opt_counter };
+
+    if( opt_counter ) {
+        atomic_fetch_add_u32( &opt_counter->value, 1, MEMORY_ORDER_RELAXED );
+    }
+    if( !___job_system_push_entry_unbounded( thread_index, priority, entry ) ) {
+        if( opt_counter ) {
+            atomic_fetch_sub_u32( &opt_counter->value, 1, MEMORY_ORDER_RELEASE );
+        }
+        return false;
+    }
+    return true;
+}
+CORE_API b32 job_system_push_local(
+    usize thread_index, JobProcFN* job, void* user_params
+) {
+    assert(
+        thread_index == JOB_THREAD_INDEX_EXTERNAL ||
+        thread_index < global_job_system->deque_count );
+    JobEntry entry = { job, user_params, NULL };
+    return ___job_system_push_entry( thread_index, JOB_PRIORITY_NORMAL, entry );
+}
+CORE_API b32 job_system_push_counter(
+    usize thread_index, JobProcFN* job, void* user_params, JobCounter* counter
+) {
+    assert(
+        thread_index == JOB_THREAD_INDEX_EXTERNAL ||
+        thread_index < global_job_system->deque_count );
+    JobEntry entry = { job, user_params, counter };
+
+    atomic_fetch_add_u32( &counter->value, 1, MEMORY_ORDER_RELAXED );
+    if( !___job_system_push_entry( thread_index, JOB_PRIORITY_NORMAL, entry ) ) {
+        atomic_fetch_sub_u32( &counter->value, 1, MEMORY_ORDER_RELEASE );
         return false;
     }
+    return true;
+}
 
-    usize write_index = interlocked_increment( &global_job_stack->write_index );
-    interlocked_increment( &global_job_stack->remaining_entries );
-    read_write_fence();
+CORE_API void job_counter_set_continuation(
+    usize thread_index, JobCounter* counter, JobPriority priority,
+    JobProcFN* job, void* user_params, JobCounter* opt_continuation_counter
+) {
+    assert( priority < JOB_PRIORITY_COUNT );
+    // NOTE(alicia): counter is held while continuation is set, that way
+    // if every job already completed releasing it pushes continuation.
+    atomic_fetch_add_u32( &counter->value, 1, MEMORY_ORDER_RELAXED );
+    if( opt_continuation_counter ) {
+        atomic_fetch_add_u32(
+            &opt_continuation_counter->value, 1, MEMORY_ORDER_RELAXED );
+    }
+    counter->continuation_params   = user_params;
+    counter->continuation_counter  = opt_continuation_counter;
+    counter->continuation_priority = priority;
+    atomic_store_ptr( &counter->continuation, (void*)job, MEMORY_ORDER_RELEASE );
 
-    write_index %= JOB_STACK_MAX_ENTRY_COUNT;
+    ___job_counter_release( thread_index, counter );
+}
+CORE_API void job_counter_wait( usize thread_index, JobCounter* counter ) {
+    JobWorker* worker = ___job_system_worker( thread_index );
+    if( worker && worker->current ) {
+        // NOTE(alicia): suspend fiber, job thread resumes it
+        // once counter reaches zero.
+        JobFiber* fiber = worker->current;
+        while( atomic_load_u32( &counter->value, MEMORY_ORDER_ACQUIRE ) ) {
+            fiber->wait_counter = counter;
+            platform_fiber_switch( fiber->fiber, worker->thread_fiber );
+        }
+        return;
+    }
 
-    JobEntry entry = { job, user_params };
+    RandState rand_state = rand_init_state( (i32)thread_index + 1 );
 
-    global_job_stack->entries[write_index] = entry;
+    u32 idle_count = 0;
+    while( atomic_load_u32( &counter->value, MEMORY_ORDER_ACQUIRE ) ) {
+        if( worker && ___job_worker_resume( worker ) ) {
+            idle_count = 0;
+            continue;
+        }
 
-    read_write_fence();
-    semaphore_signal( &global_job_stack->wake );
-    read_write_fence();
-    return true;
+        JobEntry entry = {};
+        if(
+            thread_index != JOB_THREAD_INDEX_EXTERNAL &&
+            ___job_system_next( thread_index, &rand_state, &entry )
+        ) {
+            ___job_system_execute( thread_index, &entry );
+            idle_count = 0;
+            continue;
+        }
+
+        // NOTE(alicia): remaining jobs are running on other threads.
+        if( idle_count++ < JOB_IDLE_SPIN_COUNT ) {
+            cpu_pause();
+        } else {
+            platform_sleep( 0 );
+        }
+    }
+}
+
+struct JobParallelForState;
+typedef struct JobParallelForTask {
+    struct JobParallelForState* state;
+    usize begin;
+    usize end;
+} JobParallelForTask;
+typedef struct JobParallelForState {
+    JobCounter             counter;
+    JobParallelForFN*      range_fn;
+    JobParallelIteratorFN* iterator_fn;
+    Iterator*              iter;
+    void*                  user_params;
+    usize                  grain;
+    volatile u32           task_count;
+    JobParallelForTask     tasks[JOB_PARALLEL_FOR_MAX_TASKS];
+} JobParallelForState;
+
+internal void ___job_parallel_for_chunk(
+    JobParallelForState* state, usize thread_index, usize begin, usize end
+) {
+    if( state->range_fn ) {
+        state->range_fn( thread_index, begin, end, state->user_params );
+        return;
+    }
+
+    Iterator head, tail, chunk;
+    iterator_split( state->iter, begin, &head, &tail );
+    iterator_split( &tail, end - begin, &chunk, &head );
+    state->iterator_fn( thread_index, &chunk, state->user_params );
+}
+
+internal void ___job_parallel_for_job( usize thread_index, void* params );
+
+internal void ___job_parallel_for_range(
+    JobParallelForState* state, usize thread_index, usize begin, usize end
+) {
+    JobDeque* deque = ___job_system_deque( JOB_PRIORITY_NORMAL, thread_index );
+
+    // NOTE(alicia): lazy binary splitting, range is only split in half
+    // while this thread's deque is empty, meaning thieves took everything
+    // it had to offer. Otherwise work is done one grain at a time so that
+    // range can still be split later if other threads run out of work.
+    while( begin < end ) {
+        usize size = end - begin;
+        if( size >= state->grain * 2 && ___job_deque_is_empty( deque ) ) {
+            u32 task_index = atomic_fetch_add_u32(
+                &state->task_count, 1, MEMORY_ORDER_RELAXED );
+            if( task_index < JOB_PARALLEL_FOR_MAX_TASKS ) {
+                usize middle = begin + ( size / 2 );
+
+                JobParallelForTask* task = state->tasks + task_index;
+                task->state = state;
+                task->begin = middle;
+                task->end   = end;
+                if( job_system_push_counter(
+                    thread_index, ___job_parallel_for_job, task, &state->counter
+                ) ) {
+                    end = middle;
+                    continue;
+                }
+            }
+        }
+
+        usize chunk_end = begin + ( size < state->grain ? size : state->grain );
+        ___job_parallel_for_chunk( state, thread_index, begin, chunk_end );
+        begin = chunk_end;
+    }
+}
+internal void ___job_parallel_for_job( usize thread_index, void* params ) {
+    JobParallelForTask* task = params;
+    ___job_parallel_for_range( task->state, thread_index, task->begin, task->end );
+}
+internal void ___job_parallel_for(
+    JobParallelForState* state, usize thread_index, usize count, usize min_batch
+) {
+    if( !count ) {
+        return;
+    }
+    if( !global_job_system || !global_job_system->thread_count ) {
+        ___job_parallel_for_chunk( state, thread_index, 0, count );
+        return;
+    }
+    assert( thread_index < global_job_system->deque_count );
+
+    usize chunk_count =
+        global_job_system->deque_count * JOB_PARALLEL_FOR_CHUNKS_PER_THREAD;
+    state->grain = count / chunk_count;
+    if( state->grain < min_batch ) {
+        state->grain = min_batch;
+    }
+    if( !state->grain ) {
+        state->grain = 1;
+    }
+
+    ___job_parallel_for_range( state, thread_index, 0, count );
+    job_counter_wait( thread_index, &state->counter );
+}
+
+CORE_API void job_parallel_for(
+    usize thread_index, usize count, usize min_batch,
+    JobParallelForFN* fn, void* user_params
+) {
+    JobParallelForState state = {};
+    state.range_fn    = fn;
+    state.user_params = user_params;
+    ___job_parallel_for( &state, thread_index, count, min_batch );
+}
+CORE_API void job_parallel_for_iterator(
+    usize thread_index, Iterator* iter, usize min_batch,
+    JobParallelIteratorFN* fn, void* user_params
+) {
+    JobParallelForState state = {};
+    state.iterator_fn = fn;
+    state.iter        = iter;
+    state.user_params = user_params;
+    ___job_parallel_for( &state, thread_index, iter->count, min_batch );
 }
 
 CORE_API void job_system_wait(void) {
-    while( global_job_stack->remaining_entries ) {
-        semaphore_wait( &global_job_stack->entry_completed );
+    RandState rand_state = rand_init_state( 1 );
+    while( atomic_load_u32(
+        &global_job_system->remaining_entries, MEMORY_ORDER_ACQUIRE
+    ) ) {
+        JobEntry entry = {};
+        if( ___job_system_next( 0, &rand_state, &entry ) ) {
+            ___job_system_run( 0, &entry );
+            continue;
+        }
+        // NOTE(alicia): nothing left to help with,
+        // remaining entries are running on job threads.
+        semaphore_wait( &global_job_system->entry_completed );
     }
 }
 CORE_API b32 job_system_wait_timed( u32 ms ) {
-    while( global_job_stack->remaining_entries ) {
-        if( !semaphore_wait_timed( &global_job_stack->entry_completed, ms ) ) {
+    while( atomic_load_u32(
+        &global_job_system->remaining_entries, MEMORY_ORDER_ACQUIRE
+    ) ) {
+        if( !semaphore_wait_timed( &global_job_system->entry_completed, ms ) ) {
             return false;
         }
     }
@@ -168,3 +1195,15 @@ CORE_API b32 job_system_wait_timed( u32 ms ) {
     return true;
 }
 
+#undef JOB_DEQUE_MIN_CAPACITY
+#undef JOB_DEQUE_MAX_CAPACITY
+#undef JOB_DEQUE_DEFAULT_CAPACITY
+#undef JOB_DEQUE_L2_FRACTION
+#undef JOB_SUBMIT_CAPACITY
+#undef JOB_IDLE_SPIN_COUNT
+#undef JOB_PARALLEL_FOR_CHUNKS_PER_THREAD
+#undef JOB_PARALLEL_FOR_MAX_TASKS
+#undef JOB_FIBERS_PER_THREAD
+#undef JOB_FIBER_DEFAULT_STACK_SIZE
+#undef JOB_WORKER_STRIDE
+#undef JOB_OVERFLOW_ALLOCATOR_THREAD_COUNT
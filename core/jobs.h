@@ -4,11 +4,59 @@
  * Description:  Multi-Threaded jobs system.
  * Author:       Alicia Amarilla (smushyaa@gmail.com)
  * File Created: December 05, 2023
+ * Notes:        Each thread owns a work-stealing deque,
+ *               thread index 0 is main thread and job threads start at 1.
 */
 #include "shared/defines.h"
+#include "shared/constants.h"
+#include "core/atomic.h"
+
+struct Iterator;
 
 /// Job function prototype.
 typedef void JobProcFN( usize thread_index, void* user_params );
+/// Parallel for function prototype.
+/// Called with a range of indices, end is exclusive.
+typedef void JobParallelForFN(
+    usize thread_index, usize begin, usize end, void* user_params );
+/// Parallel for iterator function prototype.
+/// Called with an iterator over a chunk of items.
+typedef void JobParallelIteratorFN(
+    usize thread_index, struct Iterator* chunk, void* user_params );
+
+/// Job priority levels.
+/// Threads always run jobs of higher priority first.
+/// Jobs are never interrupted, so long running background jobs
+/// should be split up to keep frame-critical jobs responsive.
+typedef enum JobPriority : u32 {
+    /// Jobs that have to complete within current frame.
+    JOB_PRIORITY_CRITICAL,
+    /// Default priority.
+    JOB_PRIORITY_NORMAL,
+    /// Long running jobs like streaming and packaging.
+    JOB_PRIORITY_BACKGROUND,
+
+    JOB_PRIORITY_COUNT
+} JobPriority;
+
+/// Thread index for threads that are not part of job system.
+/// Functions that take a thread index accept it,
+/// jobs never receive it.
+#define JOB_THREAD_INDEX_EXTERNAL (USIZE_MAX)
+
+/// Counter that tracks completion of a group of jobs.
+/// Must be zero initialized before first use
+/// and must outlive every job pushed with it.
+typedef struct JobCounter {
+    /// Number of jobs that have not completed yet.
+    volatile u32 value;
+    /// Priority continuation is pushed with.
+    JobPriority  continuation_priority;
+    /// Job pushed once value reaches zero.
+    JobProcFN*         continuation;
+    void*              continuation_params;
+    struct JobCounter* continuation_counter;
+} JobCounter;
 
 /// Query memory requirement for job system.
 CORE_API usize job_system_query_memory_requirement( u32 thread_count );
@@ -16,16 +64,102 @@ CORE_API usize job_system_query_memory_requirement( u32 thread_count );
 /// Buffer must be able to hold result from job_system_query_memory_requirement.
 /// Returns false if there was an error.
 CORE_API b32 job_system_initialize( u32 thread_count, void* buffer );
+/// Intialize job system in fiber mode.
+/// Worker threads run jobs on fibers, so a job waiting on
+/// a counter is suspended and its thread keeps running other jobs.
+/// Suspended jobs are always resumed on the thread they started on.
+/// Main thread does not use fibers.
+/// Fiber stack size of zero uses default size.
+/// Buffer must be able to hold result from job_system_query_memory_requirement.
+/// Returns false if there was an error.
+CORE_API b32 job_system_initialize_fibers(
+    u32 thread_count, usize fiber_stack_size, void* buffer );
 /// Shutdown job system.
 CORE_API void job_system_shutdown(void);
+/// Query number of worker threads in job system.
+/// Returns 0 if job system has not been initialized.
+CORE_API u32 job_system_query_thread_count(void);
 
-// TODO(alicia): push_wait, push_wait_timed
-
-/// Attempt to add a job to job stack.
-/// Returns false if job buffer is fully saturated.
+/// Attempt to add a job to submission queue.
+/// Jobs pushed without a priority have normal priority.
+/// Can be called from any thread.
+/// Returns false if submission queue is fully saturated.
 CORE_API b32 job_system_push( JobProcFN* job, void* user_params );
+/// Add a job to submission queue,
+/// blocks calling thread until there is space in queue.
+/// Can be called from any thread but must not be called from inside of a job.
+CORE_API void job_system_push_wait( JobProcFN* job, void* user_params );
+/// Add a job to submission queue,
+/// blocks calling thread until there is space in queue or timeout.
+/// Can be called from any thread but must not be called from inside of a job.
+/// Returns false if timed out.
+CORE_API b32 job_system_push_wait_timed( JobProcFN* job, void* user_params, u32 ms );
+/// Attempt to add a job to calling thread's own queue.
+/// Idle threads steal jobs from other threads' queues so
+/// this is the cheapest way to push jobs from inside of a job.
+/// Thread index must be the index that running job received,
+/// or 0 when called from main thread.
+/// Falls back to job_system_push if thread's queue is full.
+/// Returns false if every queue is fully saturated.
+CORE_API b32 job_system_push_local(
+    usize thread_index, JobProcFN* job, void* user_params );
+/// Attempt to add a job that decrements counter once it completes.
+/// Counter is incremented before job is added.
+/// Thread index works the same as in job_system_push_local,
+/// use JOB_THREAD_INDEX_EXTERNAL to push to submission queue.
+/// Returns false if every queue is fully saturated,
+/// counter is left unchanged in that case.
+CORE_API b32 job_system_push_counter(
+    usize thread_index, JobProcFN* job, void* user_params, JobCounter* counter );
+/// Add a job with given priority, optionally tracked by counter.
+/// Thread index works the same as in job_system_push_local.
+/// Jobs that don't fit in queues go to an unbounded overflow list,
+/// so this only fails if overflow list could not allocate memory.
+CORE_API b32 job_system_push_priority(
+    usize thread_index, JobPriority priority,
+    JobProcFN* job, void* user_params, JobCounter* opt_counter );
+
+/// Set job that is pushed with given priority once counter reaches zero.
+/// Continuation is pushed from thread that completed last job.
+/// If counter is already zero, continuation is pushed right away.
+/// Optional continuation counter is incremented right away and
+/// decremented once continuation completes, so continuations can be chained.
+/// Only one continuation can be set per counter and it runs only once.
+CORE_API void job_counter_set_continuation(
+    usize thread_index, JobCounter* counter, JobPriority priority,
+    JobProcFN* job, void* user_params, JobCounter* opt_continuation_counter );
+/// Wait for counter to reach zero.
+/// Calling thread runs pending jobs while it waits instead of sleeping,
+/// except for JOB_THREAD_INDEX_EXTERNAL which sleeps.
+/// In fiber mode, jobs running on worker threads are suspended instead.
+/// Can be called from inside of a job.
+CORE_API void job_counter_wait( usize thread_index, JobCounter* counter );
+/// Check if every job tracked by counter has completed.
+header_only b32 job_counter_is_complete( JobCounter* counter ) {
+    return atomic_load_u32( &counter->value, MEMORY_ORDER_ACQUIRE ) == 0;
+}
+
+/// Run function over range 0..count split across job system threads.
+/// Range is split into chunks no smaller than min batch,
+/// chunk size is derived from number of threads and chunks are only
+/// split further while other threads are out of work.
+/// Calling thread runs chunks too and returns once every chunk has completed.
+/// Must be called from main thread (thread index 0) or from inside of a job.
+/// If job system has not been initialized, entire range runs on calling thread.
+CORE_API void job_parallel_for(
+    usize thread_index, usize count, usize min_batch,
+    JobParallelForFN* fn, void* user_params );
+/// Run function over items in iterator split across job system threads.
+/// Iterator is split into chunks with iterator_split,
+/// chunks are sized the same way as in job_parallel_for.
+/// Iterator's current position is ignored, every item is visited.
+CORE_API void job_parallel_for_iterator(
+    usize thread_index, struct Iterator* iter, usize min_batch,
+    JobParallelIteratorFN* fn, void* user_params );
 
 /// Wait for all entries to complete.
+/// Must be called from main thread,
+/// main thread runs pending jobs as thread 0 while it waits.
 CORE_API void job_system_wait(void);
 /// Wait for all entries to complete or timeout.
 /// Returns false if timedout.
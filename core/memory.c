@@ -4,26 +4,44 @@
  * File Created: September 27, 2023
 */
 #include "shared/defines.h"
+#include "shared/constants.h"
 #include "core/memory.h"
+#include "core/atomic.h"
+#include "core/sync.h"
+#include "core/telemetry.h"
+#include "core/system.h"
 #include "core/internal/platform.h"
 #include "core/internal/logging.h"
 #include "shared/custom_cstd.h"
 
-#define LOG_MEMORY_SUCCESS( title, format, ... )\
-    ___internal_core_log(\
-        LOGGING_LEVEL_MEMORY,\
-        sizeof("[CORE] " "[" title " | {cc}:{u} > {cc}()] " format),\
-        "[CORE] " "[" title " | {cc}:{u} > {cc}()] " format,\
-        file, line, function, ##__VA_ARGS__\
-    )
-
-#define LOG_MEMORY_ERROR( title, format, ... )\
-    ___internal_core_log(\
-        LOGGING_LEVEL_ERROR,\
-        sizeof("[" title " | {cc}:{u} > {cc}()] " format),\
-        "[" title " | {cc}:{u} > {cc}()] " format,\
-        file, line, function, ##__VA_ARGS__\
-    )
+#if defined(LD_ARCH_X86)
+    #include <immintrin.h>
+#endif
+
+#if defined(LD_LOGGING)
+    #define LOG_MEMORY_SUCCESS( title, format, ... )\
+        ___internal_core_log(\
+            LOGGING_LEVEL_MEMORY,\
+            sizeof("[CORE] " "[" title " | {cc}:{u} > {cc}()] " format),\
+            "[CORE] " "[" title " | {cc}:{u} > {cc}()] " format,\
+            file, line, function, ##__VA_ARGS__\
+        )
+
+    #define LOG_MEMORY_ERROR( title, format, ... )\
+        ___internal_core_log(\
+            LOGGING_LEVEL_ERROR,\
+            sizeof("[" title " | {cc}:{u} > {cc}()] " format),\
+            "[" title " | {cc}:{u} > {cc}()] " format,\
+            file, line, function, ##__VA_ARGS__\
+        )
+#else
+    // NOTE(alicia): trace functions are also used by
+    // profiling builds without logging for telemetry.
+    #define LOG_MEMORY_SUCCESS( title, format, ... )\
+        do { unused(function); unused(file); unused(line); } while(0)
+    #define LOG_MEMORY_ERROR( title, format, ... )\
+        do { unused(function); unused(file); unused(line); } while(0)
+#endif
 
 global usize global_page_size = 0;
 
@@ -41,12 +59,178 @@ internal force_inline void* ___get_aligned_pointer( void* memory ) {
     return ((void**)memory)[-1];
 }
 
+#define BLOCK_ALLOCATOR_WORD_BITS (64)
+
+internal force_inline
+usize ___block_allocator_word_count( usize block_count ) {
+    return
+        ( block_count / BLOCK_ALLOCATOR_WORD_BITS ) +
+        ( ( block_count % BLOCK_ALLOCATOR_WORD_BITS ) ? 1 : 0 );
+}
+internal force_inline
+usize ___memory_size_to_blocks( usize block_size, usize memory_size ) {
+    usize block_count = memory_size / block_size;
+    block_count += ( memory_size % block_size ) ? 1 : 0;
+    return block_count;
+}
+/// Set or clear a range of bits in free list.
+internal void ___block_allocator_mark(
+    u64* free_list, usize first, usize count, b32 is_used
+) {
+    while( count ) {
+        usize word = first / BLOCK_ALLOCATOR_WORD_BITS;
+        usize bit  = first % BLOCK_ALLOCATOR_WORD_BITS;
+        usize bits = BLOCK_ALLOCATOR_WORD_BITS - bit;
+        if( bits > count ) {
+            bits = count;
+        }
+
+        u64 mask = bits == BLOCK_ALLOCATOR_WORD_BITS ?
+            U64_MAX : ( ( 1ull << bits ) - 1 ) << bit;
+
+        if( is_used ) {
+            free_list[word] |= mask;
+        } else {
+            free_list[word] &= ~mask;
+        }
+
+        first += bits;
+        count -= bits;
+    }
+}
+/// Reset free list and mark bits past the last block as used
+/// so that searches never have to check for them.
+internal void ___block_allocator_reset_free_list( BlockAllocator* allocator ) {
+    usize word_count = ___block_allocator_word_count( allocator->block_count );
+    memory_zero( allocator->free_list, word_count * sizeof(u64) );
+
+    usize tail = allocator->block_count % BLOCK_ALLOCATOR_WORD_BITS;
+    if( tail ) {
+        allocator->free_list[word_count - 1] = U64_MAX << tail;
+    }
+
+    allocator->largest_free_run = allocator->block_count;
+}
+/// Count free blocks directly before index.
+internal usize ___block_allocator_free_run_before(
+    u64* free_list, usize index
+) {
+    usize result = 0;
+    while( index ) {
+        usize word  = ( index - 1 ) / BLOCK_ALLOCATOR_WORD_BITS;
+        usize bit   = ( index - 1 ) % BLOCK_ALLOCATOR_WORD_BITS;
+        usize avail = bit + 1;
+
+        u64 used = free_list[word] << ( ( BLOCK_ALLOCATOR_WORD_BITS - 1 ) - bit );
+        usize run = used ? (usize)__builtin_clzll( used ) : avail;
+
+        result += run;
+        if( run < avail ) {
+            break;
+        }
+        index -= run;
+    }
+    return result;
+}
+/// Count free blocks starting at index, stops counting at limit.
+internal usize ___block_allocator_free_run_after(
+    u64* free_list, usize index, usize block_count, usize limit
+) {
+    usize result = 0;
+    while( index < block_count && result < limit ) {
+        usize word  = index / BLOCK_ALLOCATOR_WORD_BITS;
+        usize bit   = index % BLOCK_ALLOCATOR_WORD_BITS;
+        usize avail = BLOCK_ALLOCATOR_WORD_BITS - bit;
+
+        u64 used = free_list[word] >> bit;
+        usize run = used ? (usize)__builtin_ctzll( used ) : avail;
+
+        result += run;
+        if( run < avail ) {
+            break;
+        }
+        index += run;
+    }
+    return result;
+}
+
+/// Returns index of first word that has a free block,
+/// starting at word. Returns word_count if there are none.
+typedef usize ___BlockAllocatorSkipFN(
+    u64* free_list, usize word, usize word_count );
+
+internal usize ___block_allocator_skip_used_scalar(
+    u64* free_list, usize word, usize word_count
+) {
+    while( word < word_count && free_list[word] == U64_MAX ) {
+        word++;
+    }
+    return word;
+}
+
+#if defined(LD_ARCH_X86)
+
+internal usize ___block_allocator_skip_used_sse2(
+    u64* free_list, usize word, usize word_count
+) {
+    __m128i full = _mm_set1_epi32( -1 );
+    while( word + 2 <= word_count ) {
+        __m128i words = _mm_loadu_si128( (__m128i*)( free_list + word ) );
+        if( _mm_movemask_epi8( _mm_cmpeq_epi8( words, full ) ) != 0xFFFF ) {
+            break;
+        }
+        word += 2;
+    }
+    return ___block_allocator_skip_used_scalar( free_list, word, word_count );
+}
+internal target_features( "avx2" )
+usize ___block_allocator_skip_used_avx2(
+    u64* free_list, usize word, usize word_count
+) {
+    __m256i full = _mm256_set1_epi32( -1 );
+    while( word + 4 <= word_count ) {
+        __m256i words = _mm256_loadu_si256( (__m256i*)( free_list + word ) );
+        if( _mm256_movemask_epi8( _mm256_cmpeq_epi8( words, full ) ) != -1 ) {
+            break;
+        }
+        word += 4;
+    }
+    return ___block_allocator_skip_used_scalar( free_list, word, word_count );
+}
+#endif /* x86 */
+
+internal usize ___block_allocator_skip_used_resolve(
+    u64* free_list, usize word, usize word_count );
+
+// NOTE(alicia): same as memory primitives, resolves
+// implementation from cpu features on first call.
+global ___BlockAllocatorSkipFN* global_block_allocator_skip_used =
+    ___block_allocator_skip_used_resolve;
+
+internal usize ___block_allocator_skip_used_resolve(
+    u64* free_list, usize word, usize word_count
+) {
+    ___BlockAllocatorSkipFN* skip_used = ___block_allocator_skip_used_scalar;
+#if defined(LD_ARCH_X86)
+    CPUFeatureFlags features = system_info_query_features();
+    if( bitfield_check( features, CPU_FEATURE_AVX2 ) ) {
+        skip_used = ___block_allocator_skip_used_avx2;
+    } else if( bitfield_check( features, CPU_FEATURE_SSE2 ) ) {
+        skip_used = ___block_allocator_skip_used_sse2;
+    }
+#endif
+
+    global_block_allocator_skip_used = skip_used;
+    return skip_used( free_list, word, word_count );
+}
+
 CORE_API usize block_allocator_memory_requirement(
     usize block_count, usize block_size
 ) {
     usize allocator_size = sizeof( BlockAllocator );
     usize buffer_size    = block_count * block_size;
-    usize free_list_size = block_count;
+    usize free_list_size =
+        ___block_allocator_word_count( block_count ) * sizeof(u64);
 
     return allocator_size + buffer_size + free_list_size;
 }
@@ -59,109 +243,150 @@ CORE_API BlockAllocator* block_allocator_create(
     result->block_count = block_count;
 
     usize allocator_memory = sizeof(BlockAllocator);
-    allocator_memory      += block_count;
+    allocator_memory +=
+        ___block_allocator_word_count( block_count ) * sizeof(u64);
 
     result->buffer = ((u8*)buffer) + allocator_memory;
 
+    ___block_allocator_reset_free_list( result );
+
     return result;
 }
 
 internal b32 block_allocator_find_free_blocks(
     BlockAllocator* allocator, usize block_count, usize* out_head
 ) {
-    b32   free_block_found = false;
-    usize free_block_head  = 0;
-    usize free_block_count = 0;
-    for( usize i = 0; i < allocator->block_count; ++i ) {
-        if( !allocator->free_list[i] ) {
-            free_block_count++;
-            if( !free_block_found ) {
-                free_block_found = true;
-                free_block_head  = i;
+    // NOTE(alicia): early out, there's no run that can hold block_count.
+    if( !block_count || block_count > allocator->largest_free_run ) {
+        return false;
+    }
+
+    ___BlockAllocatorSkipFN* skip_used = global_block_allocator_skip_used;
+
+    u64*  free_list  = allocator->free_list;
+    usize word_count = ___block_allocator_word_count( allocator->block_count );
+
+    usize run_head = 0;
+    usize run      = 0;
+    usize largest  = 0;
+
+    usize word = 0;
+    while( word < word_count ) {
+        if( !run ) {
+            word = skip_used( free_list, word, word_count );
+            if( word >= word_count ) {
+                break;
             }
-        } else {
-            free_block_found = false;
-            free_block_count = 0;
         }
 
-        if( free_block_count == block_count ) {
-            break;
+        u64 free_bits = ~free_list[word];
+        if( free_bits == U64_MAX ) {
+            if( !run ) {
+                run_head = word * BLOCK_ALLOCATOR_WORD_BITS;
+            }
+            run += BLOCK_ALLOCATOR_WORD_BITS;
+            if( run >= block_count ) {
+                *out_head = run_head;
+                return true;
+            }
+            word++;
+            continue;
         }
-    }
 
-    if( free_block_found ) {
-        *out_head = free_block_head;
-        return true;
+        usize bit = 0;
+        while( bit < BLOCK_ALLOCATOR_WORD_BITS ) {
+            u64 rest = free_bits >> bit;
+            if( !rest ) {
+                largest = run > largest ? run : largest;
+                run     = 0;
+                break;
+            }
+
+            usize used_count = __builtin_ctzll( rest );
+            if( used_count ) {
+                largest = run > largest ? run : largest;
+                run     = 0;
+                bit    += used_count;
+                rest  >>= used_count;
+            }
+
+            // NOTE(alicia): rest always has a cleared high bit here
+            // so ~rest can never be zero.
+            usize free_count = __builtin_ctzll( ~rest );
+            if( !run ) {
+                run_head = ( word * BLOCK_ALLOCATOR_WORD_BITS ) + bit;
+            }
+            run += free_count;
+            if( run >= block_count ) {
+                *out_head = run_head;
+                return true;
+            }
+            bit += free_count;
+        }
+
+        word++;
     }
 
+    // NOTE(alicia): whole free list was scanned so
+    // largest is now the exact longest free run.
+    largest = run > largest ? run : largest;
+    allocator->largest_free_run = largest;
+
     return false;
 }
-internal force_inline
-usize ___memory_size_to_blocks( usize block_size, usize memory_size ) {
-    usize block_count = memory_size / block_size;
-    block_count += ( memory_size % block_size ) ? 1 : 0;
-    return block_count;
-}
-CORE_API void* block_allocator_alloc( BlockAllocator* allocator, usize size ) {
+CORE_API void* ___internal_block_allocator_alloc( BlockAllocator* allocator, usize size ) {
     usize block_count = ___memory_size_to_blocks( allocator->block_size, size );
 
     usize head = 0;
     if( block_allocator_find_free_blocks( allocator, block_count, &head ) ) {
-        memory_set( allocator->free_list + head, 1, block_count );
+        ___block_allocator_mark( allocator->free_list, head, block_count, true );
         return (u8*)allocator->buffer + ( head * allocator->block_size );
     }
 
     return NULL;
 }
-CORE_API void* block_allocator_alloc_aligned(
+CORE_API void* ___internal_block_allocator_alloc_aligned(
     BlockAllocator* allocator, usize size, usize alignment
 ) {
     usize aligned_size = ___aligned_size( size, alignment );
 
-    void* memory = block_allocator_alloc( allocator, aligned_size );
+    void* memory = ___internal_block_allocator_alloc( allocator, aligned_size );
     if( memory ) {
         void* result = ___set_aligned_pointer( memory, alignment );
         return result;
     }
     return memory;
 }
-CORE_API void* block_allocator_realloc(
+CORE_API void* ___internal_block_allocator_realloc(
     BlockAllocator* allocator, void* memory, usize old_size, usize new_size
 ) {
     assert( new_size > old_size );
 
-    usize remainder_of_last_block = old_size % allocator->block_size;
+    usize old_block_count = ___memory_size_to_blocks( allocator->block_size, old_size );
+    usize new_block_count = ___memory_size_to_blocks( allocator->block_size, new_size );
 
-    if( old_size + remainder_of_last_block < new_size ) {
+    if( new_block_count <= old_block_count ) {
         // currently allocated blocks have enough space
-        // to hold new size 
+        // to hold new size
         return memory;
     }
 
-    usize old_block_count = ___memory_size_to_blocks( allocator->block_size, old_size );
-    usize new_block_count = ___memory_size_to_blocks( allocator->block_size, new_size );
-
     usize additional_blocks_required = new_block_count - old_block_count;
-    usize head = ((usize)allocator->buffer - (usize)memory) / allocator->block_size;
+    usize head = ((usize)memory - (usize)allocator->buffer) / allocator->block_size;
+    usize tail = head + old_block_count;
 
-    b32 adjacent_blocks_are_free = true;
-    for( usize i = 0; i < additional_blocks_required; ++i ) {
-        u8 current_block_freed = !allocator->free_list[head + old_block_count + i];
-        if( !current_block_freed ) {
-            adjacent_blocks_are_free = false;
-            break;
-        }
-    }
+    usize adjacent_free_blocks = ___block_allocator_free_run_after(
+        allocator->free_list, tail,
+        allocator->block_count, additional_blocks_required );
 
-    if( adjacent_blocks_are_free ) {
-        // set adjacent blocks to be freed
-        memory_set(
-            allocator->free_list + head + old_block_count,
-            1, additional_blocks_required );
+    if( adjacent_free_blocks >= additional_blocks_required ) {
+        // mark adjacent blocks as in use
+        ___block_allocator_mark(
+            allocator->free_list, tail, additional_blocks_required, true );
         return memory;
     }
 
-    void* new_pointer = block_allocator_alloc( allocator, new_size );
+    void* new_pointer = ___internal_block_allocator_alloc( allocator, new_size );
     if( !new_pointer ) {
         // could not find any free space that can accomodate
         return NULL;
@@ -169,10 +394,10 @@ CORE_API void* block_allocator_realloc(
 
     // allocate new space, copy data to new space and free old space
     memory_copy( new_pointer, memory, old_size );
-    block_allocator_free( allocator, memory, old_size );
+    ___internal_block_allocator_free( allocator, memory, old_size );
     return new_pointer;
 }
-CORE_API void block_allocator_free(
+CORE_API void ___internal_block_allocator_free(
     BlockAllocator* allocator, void* memory, usize size
 ) {
     usize block_count = ___memory_size_to_blocks( allocator->block_size, size );
@@ -180,26 +405,378 @@ CORE_API void block_allocator_free(
     usize head = ((usize)memory - (usize)allocator->buffer) / allocator->block_size;
 
     memory_zero( memory, size );
-    memory_zero( allocator->free_list + head, block_count );
+    ___block_allocator_mark( allocator->free_list, head, block_count, false );
+
+    // NOTE(alicia): freed blocks may have joined neighboring runs,
+    // grow hint so that it remains an upper bound.
+    usize run =
+        ___block_allocator_free_run_before( allocator->free_list, head ) +
+        block_count +
+        ___block_allocator_free_run_after(
+            allocator->free_list, head + block_count,
+            allocator->block_count, allocator->block_count );
+    if( run > allocator->largest_free_run ) {
+        allocator->largest_free_run = run;
+    }
 }
-CORE_API void block_allocator_free_aligned(
+CORE_API void ___internal_block_allocator_free_aligned(
     BlockAllocator* allocator, void* memory, usize size, usize alignment
 ) {
     usize aligned_size = ___aligned_size( size, alignment );
-    block_allocator_free( allocator, ___get_aligned_pointer( memory ), aligned_size );
+    ___internal_block_allocator_free(
+        allocator, ___get_aligned_pointer( memory ), aligned_size );
 }
-CORE_API void block_allocator_clear( BlockAllocator* allocator ) {
-    memory_zero( allocator->free_list, allocator->block_count );
+CORE_API void ___internal_block_allocator_clear( BlockAllocator* allocator ) {
+    ___block_allocator_reset_free_list( allocator );
     memory_zero( allocator->buffer, allocator->block_size * allocator->block_count );
 }
 
+CORE_API void* ___internal_block_allocator_alloc_trace(
+    BlockAllocator* allocator, usize size,
+    MemoryTag tag, const char* file, int line
+) {
+    void* result = ___internal_block_allocator_alloc( allocator, size );
+    ___internal_memory_telemetry_record_alloc(
+        tag, MEMORY_ALLOCATOR_BLOCK, allocator->buffer, result, size, file, line );
+    return result;
+}
+CORE_API void* ___internal_block_allocator_alloc_aligned_trace(
+    BlockAllocator* allocator, usize size, usize alignment,
+    MemoryTag tag, const char* file, int line
+) {
+    void* result = ___internal_block_allocator_alloc_aligned(
+        allocator, size, alignment );
+    ___internal_memory_telemetry_record_alloc(
+        tag, MEMORY_ALLOCATOR_BLOCK, allocator->buffer, result, size, file, line );
+    return result;
+}
+CORE_API void* ___internal_block_allocator_realloc_trace(
+    BlockAllocator* allocator, void* memory, usize old_size, usize new_size,
+    MemoryTag tag, const char* file, int line
+) {
+    void* result = ___internal_block_allocator_realloc(
+        allocator, memory, old_size, new_size );
+    if( result ) {
+        ___internal_memory_telemetry_record_free( allocator->buffer, memory );
+        ___internal_memory_telemetry_record_alloc(
+            tag, MEMORY_ALLOCATOR_BLOCK, allocator->buffer,
+            result, new_size, file, line );
+    }
+    return result;
+}
+CORE_API void ___internal_block_allocator_free_trace(
+    BlockAllocator* allocator, void* memory, usize size
+) {
+    ___internal_memory_telemetry_record_free( allocator->buffer, memory );
+    ___internal_block_allocator_free( allocator, memory, size );
+}
+CORE_API void ___internal_block_allocator_free_aligned_trace(
+    BlockAllocator* allocator, void* memory, usize size, usize alignment
+) {
+    ___internal_memory_telemetry_record_free( allocator->buffer, memory );
+    ___internal_block_allocator_free_aligned( allocator, memory, size, alignment );
+}
+CORE_API void ___internal_block_allocator_clear_trace( BlockAllocator* allocator ) {
+    ___internal_memory_telemetry_record_free_range(
+        allocator->buffer, allocator->block_size * allocator->block_count );
+    ___internal_block_allocator_clear( allocator );
+}
+
+// NOTE(alicia): slab size classes are 16 byte steps up to 128 bytes,
+// then four steps per power of two up to SLAB_ALLOCATOR_MAX_SIZE.
+#define SLAB_SMALL_CLASS_COUNT (8)
+#define SLAB_SMALL_CLASS_STEP  (16)
+#define SLAB_SMALL_CLASS_MAX   ( SLAB_SMALL_CLASS_COUNT * SLAB_SMALL_CLASS_STEP )
+#define SLAB_CLASS_COUNT       (SLAB_SMALL_CLASS_COUNT + (7 * 4))
+#define SLAB_TARGET_SIZE       (kilobytes(64))
+#define SLAB_BATCH_BYTES       (kilobytes(8))
+#define SLAB_BATCH_MIN         (4)
+#define SLAB_BATCH_MAX         (64)
+
+/// Free object, next_batch is only valid for
+/// the head of a batch in the shared list.
+typedef struct SlabNode {
+    struct SlabNode* next;
+    struct SlabNode* next_batch;
+} SlabNode;
+
+/// Header at the start of every slab.
+typedef struct SlabHeader {
+    struct SlabHeader* next;
+    usize page_count;
+} SlabHeader;
+
+/// Shared list of full batches for a size class.
+typedef union SlabCentral {
+    struct {
+        volatile u32 lock;
+        SlabNode*    batches;
+        SlabHeader*  slabs;
+    };
+    u8 ___padding[CACHE_LINE_SIZE];
+} SlabCentral;
+
+/// Thread-local list of free objects for a size class.
+typedef struct SlabBin {
+    SlabNode* head;
+    usize     count;
+} SlabBin;
+
+/// Thread-local cache, only ever touched by owning thread.
+typedef struct SlabThreadCache {
+    SlabBin bins[SLAB_CLASS_COUNT];
+} SlabThreadCache;
+static_assert(
+    sizeof(SlabThreadCache) % CACHE_LINE_SIZE == 0,
+    "SlabThreadCache must be a multiple of cache line size!" );
+
+struct SlabAllocator {
+    SlabCentral central[SLAB_CLASS_COUNT];
+    usize thread_count;
+    u8    ___padding[CACHE_LINE_SIZE - sizeof(usize)];
+    SlabThreadCache caches[];
+};
+
+internal force_inline usize ___slab_size_class( usize size ) {
+    if( size <= SLAB_SMALL_CLASS_MAX ) {
+        return size ? ( ( size - 1 ) / SLAB_SMALL_CLASS_STEP ) : 0;
+    }
+    usize high_bit = 63 - __builtin_clzll( size - 1 );
+    usize step     = ( size - 1 ) >> ( high_bit - 2 );
+    return SLAB_SMALL_CLASS_COUNT + ( ( high_bit - 7 ) * 4 ) + ( step - 4 );
+}
+internal force_inline usize ___slab_class_size( usize class ) {
+    if( class < SLAB_SMALL_CLASS_COUNT ) {
+        return ( class + 1 ) * SLAB_SMALL_CLASS_STEP;
+    }
+    usize group = ( class - SLAB_SMALL_CLASS_COUNT ) / 4;
+    usize step  = ( class - SLAB_SMALL_CLASS_COUNT ) % 4;
+    usize base  = SLAB_SMALL_CLASS_MAX << group;
+    return base + ( ( step + 1 ) * ( base / 4 ) );
+}
+internal force_inline usize ___slab_batch_count( usize class_size ) {
+    usize result = SLAB_BATCH_BYTES / class_size;
+    if( result < SLAB_BATCH_MIN ) {
+        return SLAB_BATCH_MIN;
+    }
+    if( result > SLAB_BATCH_MAX ) {
+        return SLAB_BATCH_MAX;
+    }
+    return result;
+}
+internal force_inline void ___slab_lock( volatile u32* lock ) {
+    while( interlocked_compare_exchange( lock, 1, 0 ) != 0 ) {
+        while( *lock ) {
+            cpu_pause();
+        }
+    }
+}
+internal force_inline void ___slab_unlock( volatile u32* lock ) {
+    interlocked_exchange( lock, 0 );
+}
+
+/// Allocate a new slab and carve it into batches.
+/// Keeps first batch in bin and pushes the rest to shared list.
+internal b32 ___slab_grow(
+    SlabAllocator* allocator, usize class, SlabBin* bin
+) {
+    usize class_size  = ___slab_class_size( class );
+    usize batch_count = ___slab_batch_count( class_size );
+    usize batch_size  = batch_count * class_size;
+
+    usize batches_per_slab = SLAB_TARGET_SIZE / batch_size;
+    if( !batches_per_slab ) {
+        batches_per_slab = 1;
+    }
+
+    usize page_count = memory_size_to_page_count(
+        CACHE_LINE_SIZE + ( batches_per_slab * batch_size ) );
+    SlabHeader* slab = system_page_alloc_tagged( page_count, MEMORY_TAG_CORE );
+    if( !slab ) {
+        return false;
+    }
+    slab->page_count = page_count;
+
+    // NOTE(alicia): fill slab with as many batches as will fit in pages.
+    batches_per_slab =
+        ( page_count_to_memory_size( page_count ) - CACHE_LINE_SIZE ) / batch_size;
+
+    u8* objects = (u8*)slab + CACHE_LINE_SIZE;
+    SlabNode* batches    = NULL;
+    SlabNode* last_batch = NULL;
+    for( usize i = 0; i < batches_per_slab; ++i ) {
+        u8* batch = objects + ( i * batch_size );
+        for( usize j = 0; j < batch_count; ++j ) {
+            SlabNode* node = (SlabNode*)( batch + ( j * class_size ) );
+            node->next = ( j + 1 < batch_count ) ?
+                (SlabNode*)( batch + ( ( j + 1 ) * class_size ) ) : NULL;
+        }
+
+        SlabNode* head = (SlabNode*)batch;
+        head->next_batch = batches;
+        batches = head;
+        if( !last_batch ) {
+            last_batch = head;
+        }
+    }
+
+    bin->head  = batches;
+    bin->count = batch_count;
+
+    SlabCentral* central = allocator->central + class;
+    ___slab_lock( &central->lock );
+
+    if( batches != last_batch ) {
+        last_batch->next_batch = central->batches;
+        central->batches       = batches->next_batch;
+    }
+    slab->next     = central->slabs;
+    central->slabs = slab;
+
+    ___slab_unlock( &central->lock );
+
+    return true;
+}
+internal b32 ___slab_refill(
+    SlabAllocator* allocator, usize class, SlabBin* bin
+) {
+    SlabCentral* central = allocator->central + class;
+
+    ___slab_lock( &central->lock );
+    SlabNode* batch = central->batches;
+    if( batch ) {
+        central->batches = batch->next_batch;
+    }
+    ___slab_unlock( &central->lock );
+
+    if( !batch ) {
+        return ___slab_grow( allocator, class, bin );
+    }
+
+    bin->head  = batch;
+    bin->count = ___slab_batch_count( ___slab_class_size( class ) );
+    return true;
+}
+/// Move one batch from bin to shared list.
+internal void ___slab_release_batch(
+    SlabAllocator* allocator, usize class, SlabBin* bin, usize batch_count
+) {
+    SlabNode* head = bin->head;
+    SlabNode* tail = head;
+    for( usize i = 1; i < batch_count; ++i ) {
+        tail = tail->next;
+    }
+
+    bin->head   = tail->next;
+    bin->count -= batch_count;
+    tail->next  = NULL;
+
+    SlabCentral* central = allocator->central + class;
+    ___slab_lock( &central->lock );
+    head->next_batch = central->batches;
+    central->batches = head;
+    ___slab_unlock( &central->lock );
+}
+
+CORE_API usize slab_allocator_memory_requirement( usize thread_count ) {
+    // NOTE(alicia): extra cache line for aligning buffer.
+    return
+        sizeof(SlabAllocator) +
+        ( sizeof(SlabThreadCache) * thread_count ) +
+        CACHE_LINE_SIZE;
+}
+CORE_API SlabAllocator* slab_allocator_create( usize thread_count, void* buffer ) {
+    SlabAllocator* result = memory_align( buffer, CACHE_LINE_SIZE );
+    memory_zero(
+        result,
+        sizeof(SlabAllocator) + ( sizeof(SlabThreadCache) * thread_count ) );
+    result->thread_count = thread_count;
+    return result;
+}
+CORE_API void slab_allocator_destroy( SlabAllocator* allocator ) {
+    for( usize i = 0; i < SLAB_CLASS_COUNT; ++i ) {
+        SlabHeader* slab = allocator->central[i].slabs;
+        while( slab ) {
+            SlabHeader* next = slab->next;
+            system_page_free( slab, slab->page_count );
+            slab = next;
+        }
+    }
+    memory_zero(
+        allocator,
+        sizeof(SlabAllocator) +
+        ( sizeof(SlabThreadCache) * allocator->thread_count ) );
+}
+CORE_API void* slab_allocator_alloc(
+    SlabAllocator* allocator, usize thread_index, usize size
+) {
+    if( size > SLAB_ALLOCATOR_MAX_SIZE ) {
+        return system_alloc( size );
+    }
+    assert( thread_index < allocator->thread_count );
+
+    usize class  = ___slab_size_class( size );
+    SlabBin* bin = allocator->caches[thread_index].bins + class;
+    if( !bin->head && !___slab_refill( allocator, class, bin ) ) {
+        return NULL;
+    }
+
+    SlabNode* node = bin->head;
+    bin->head = node->next;
+    bin->count--;
+
+    memory_zero( node, size < sizeof(SlabNode) ? sizeof(SlabNode) : size );
+    return node;
+}
+CORE_API void slab_allocator_free(
+    SlabAllocator* allocator, usize thread_index, void* memory, usize size
+) {
+    if( size > SLAB_ALLOCATOR_MAX_SIZE ) {
+        system_free( memory, size );
+        return;
+    }
+    assert( thread_index < allocator->thread_count );
+
+    usize class  = ___slab_size_class( size );
+    SlabBin* bin = allocator->caches[thread_index].bins + class;
+
+    SlabNode* node = memory;
+    node->next = bin->head;
+    bin->head  = node;
+    bin->count++;
+
+    usize batch_count = ___slab_batch_count( ___slab_class_size( class ) );
+    if( bin->count >= batch_count * 2 ) {
+        ___slab_release_batch( allocator, class, bin, batch_count );
+    }
+}
+CORE_API void slab_allocator_flush( SlabAllocator* allocator, usize thread_index ) {
+    assert( thread_index < allocator->thread_count );
+    SlabThreadCache* cache = allocator->caches + thread_index;
+    for( usize i = 0; i < SLAB_CLASS_COUNT; ++i ) {
+        usize batch_count = ___slab_batch_count( ___slab_class_size( i ) );
+        while( cache->bins[i].count >= batch_count ) {
+            ___slab_release_batch( allocator, i, cache->bins + i, batch_count );
+        }
+    }
+}
+
+#undef SLAB_SMALL_CLASS_COUNT
+#undef SLAB_SMALL_CLASS_STEP
+#undef SLAB_SMALL_CLASS_MAX
+#undef SLAB_CLASS_COUNT
+#undef SLAB_TARGET_SIZE
+#undef SLAB_BATCH_BYTES
+#undef SLAB_BATCH_MIN
+#undef SLAB_BATCH_MAX
+
 CORE_API StackAllocator stack_allocator_create( usize buffer_size, void* buffer ) {
     StackAllocator result = {0};
     result.buffer      = buffer;
     result.buffer_size = buffer_size;
     return result;
 }
-CORE_API void* stack_allocator_push( StackAllocator* allocator, usize size ) {
+CORE_API void* ___internal_stack_allocator_push( StackAllocator* allocator, usize size ) {
     if( (allocator->current + size) > allocator->buffer_size ) {
         return NULL;
     }
@@ -208,11 +785,11 @@ CORE_API void* stack_allocator_push( StackAllocator* allocator, usize size ) {
 
     return result;
 }
-CORE_API void* stack_allocator_push_aligned(
+CORE_API void* ___internal_stack_allocator_push_aligned(
     StackAllocator* allocator, usize size, usize alignment
 ) {
     usize aligned_size = ___aligned_size( size, alignment );
-    void* memory = stack_allocator_push( allocator, aligned_size );
+    void* memory = ___internal_stack_allocator_push( allocator, aligned_size );
     if( memory ) {
         void* result = ___set_aligned_pointer( memory, alignment );
         return result;
@@ -220,7 +797,7 @@ CORE_API void* stack_allocator_push_aligned(
 
     return memory;
 }
-CORE_API b32 stack_allocator_pop( StackAllocator* allocator, usize size ) {
+CORE_API b32 ___internal_stack_allocator_pop( StackAllocator* allocator, usize size ) {
     if( size > allocator->current ) {
         return false;
     }
@@ -228,17 +805,68 @@ CORE_API b32 stack_allocator_pop( StackAllocator* allocator, usize size ) {
     memory_zero( (u8*)allocator->buffer + allocator->current, size );
     return true;
 }
-CORE_API b32 stack_allocator_pop_aligned(
+CORE_API b32 ___internal_stack_allocator_pop_aligned(
     StackAllocator* allocator, usize size, usize alignment
 ) {
     usize aligned_size = ___aligned_size( size, alignment );
-    return stack_allocator_pop( allocator, aligned_size );
+    return ___internal_stack_allocator_pop( allocator, aligned_size );
 }
-CORE_API void stack_allocator_clear( StackAllocator* allocator ) {
+CORE_API void ___internal_stack_allocator_clear( StackAllocator* allocator ) {
     allocator->current = 0;
     memory_zero( allocator->buffer, allocator->buffer_size );
 }
 
+// NOTE(alicia): stack allocations are recorded at the start of the pushed
+// region rather than the aligned pointer so that pops can find them.
+
+CORE_API void* ___internal_stack_allocator_push_trace(
+    StackAllocator* allocator, usize size,
+    MemoryTag tag, const char* file, int line
+) {
+    void* result = ___internal_stack_allocator_push( allocator, size );
+    ___internal_memory_telemetry_record_alloc(
+        tag, MEMORY_ALLOCATOR_STACK, allocator->buffer, result, size, file, line );
+    return result;
+}
+CORE_API void* ___internal_stack_allocator_push_aligned_trace(
+    StackAllocator* allocator, usize size, usize alignment,
+    MemoryTag tag, const char* file, int line
+) {
+    void* start  = (u8*)allocator->buffer + allocator->current;
+    void* result = ___internal_stack_allocator_push_aligned(
+        allocator, size, alignment );
+    if( result ) {
+        ___internal_memory_telemetry_record_alloc(
+            tag, MEMORY_ALLOCATOR_STACK, allocator->buffer, start, size, file, line );
+    }
+    return result;
+}
+CORE_API b32 ___internal_stack_allocator_pop_trace(
+    StackAllocator* allocator, usize size
+) {
+    if( ___internal_stack_allocator_pop( allocator, size ) ) {
+        ___internal_memory_telemetry_record_free(
+            allocator->buffer, (u8*)allocator->buffer + allocator->current );
+        return true;
+    }
+    return false;
+}
+CORE_API b32 ___internal_stack_allocator_pop_aligned_trace(
+    StackAllocator* allocator, usize size, usize alignment
+) {
+    if( ___internal_stack_allocator_pop_aligned( allocator, size, alignment ) ) {
+        ___internal_memory_telemetry_record_free(
+            allocator->buffer, (u8*)allocator->buffer + allocator->current );
+        return true;
+    }
+    return false;
+}
+CORE_API void ___internal_stack_allocator_clear_trace( StackAllocator* allocator ) {
+    ___internal_memory_telemetry_record_free_range(
+        allocator->buffer, allocator->buffer_size );
+    ___internal_stack_allocator_clear( allocator );
+}
+
 internal usize ___get_page_size(void) {
     if( global_page_size ) {
         return global_page_size;
@@ -261,43 +889,50 @@ CORE_API usize page_count_to_memory_size( usize pages ) {
     return pages * page_size;
 }
 
-global usize HEAP_MEMORY_USAGE = 0;
-global usize PAGE_MEMORY_USAGE = 0;
+// NOTE(alicia): usage counters are only statistics, relaxed ordering
+// is enough as long as updates from different threads are atomic.
+global volatile usize HEAP_MEMORY_USAGE = 0;
+global volatile usize PAGE_MEMORY_USAGE = 0;
 
 CORE_API usize memory_query_heap_usage(void) {
-    return HEAP_MEMORY_USAGE;
+    return atomic_load_usize( &HEAP_MEMORY_USAGE, MEMORY_ORDER_RELAXED );
 }
 CORE_API usize memory_query_page_usage(void) {
-    return PAGE_MEMORY_USAGE;
+    return atomic_load_usize( &PAGE_MEMORY_USAGE, MEMORY_ORDER_RELAXED );
 }
 CORE_API usize memory_query_total_usage(void) {
-    return HEAP_MEMORY_USAGE + (page_count_to_memory_size( PAGE_MEMORY_USAGE ));
+    return
+        memory_query_heap_usage() +
+        page_count_to_memory_size( memory_query_page_usage() );
 }
 
 CORE_API void* ___internal_system_page_alloc( usize pages ) {
-    void* result = platform_heap_alloc( page_count_to_memory_size( pages ) );
+    void* result = platform_page_alloc( page_count_to_memory_size( pages ) );
 
     if( result ) {
-        PAGE_MEMORY_USAGE += pages;
+        atomic_fetch_add_usize( &PAGE_MEMORY_USAGE, pages, MEMORY_ORDER_RELAXED );
     }
     return result;
 }
 CORE_API void  ___internal_system_page_free( void* memory, usize pages ) {
-    PAGE_MEMORY_USAGE -= pages;
-    platform_heap_free( memory, page_count_to_memory_size( pages ) );
+    atomic_fetch_sub_usize( &PAGE_MEMORY_USAGE, pages, MEMORY_ORDER_RELAXED );
+    platform_page_free( memory, page_count_to_memory_size( pages ) );
 }
 
 CORE_API void* ___internal_system_page_alloc_trace(
-    usize pages, const char* function, const char* file, int line
+    usize pages, MemoryTag tag,
+    const char* function, const char* file, int line
 ) {
     usize memory_size = page_count_to_memory_size( pages );
-    void* result = platform_heap_alloc( memory_size );
+    void* result = platform_page_alloc( memory_size );
 
     if( result ) {
         LOG_MEMORY_SUCCESS(
             "PAGE", "Allocated {f,m,.2}. Pointer: {usize,X}",
             (f64)memory_size, (usize)result );
-        PAGE_MEMORY_USAGE += pages;
+        atomic_fetch_add_usize( &PAGE_MEMORY_USAGE, pages, MEMORY_ORDER_RELAXED );
+        ___internal_memory_telemetry_record_alloc(
+            tag, MEMORY_ALLOCATOR_PAGE, NULL, result, memory_size, file, line );
     } else {
         LOG_MEMORY_ERROR(
             "PAGE", "Failed to allocate {f,m,.2}!",
@@ -313,15 +948,231 @@ CORE_API void  ___internal_system_page_free_trace(
     LOG_MEMORY_SUCCESS(
         "PAGE", "Freed {f,m,.2}. Pointer: {usize,X}",
         (f64)memory_size, (usize)memory );
-    PAGE_MEMORY_USAGE -= pages;
-    // TODO(alicia): VirtualAlloc/mmap
-    platform_heap_free( memory, memory_size );
+    atomic_fetch_sub_usize( &PAGE_MEMORY_USAGE, pages, MEMORY_ORDER_RELAXED );
+    ___internal_memory_telemetry_record_free( NULL, memory );
+    ___internal_memory_telemetry_record_free_range( memory, memory_size );
+    platform_page_free( memory, memory_size );
+}
+
+CORE_API usize memory_query_huge_page_size(void) {
+    return platform_huge_page_size();
+}
+CORE_API const char* memory_huge_page_kind_to_cstr( MemoryHugePageKind kind ) {
+    switch( kind ) {
+        case MEMORY_HUGE_PAGE_NONE:        return "none";
+        case MEMORY_HUGE_PAGE_EXPLICIT:    return "explicit";
+        case MEMORY_HUGE_PAGE_TRANSPARENT: return "transparent";
+    }
+    return "unknown";
+}
+
+/// Round page count up to a multiple of huge page size.
+internal usize ___huge_page_memory_size( usize pages ) {
+    usize huge_page_size = platform_huge_page_size();
+    usize memory_size    = page_count_to_memory_size( pages );
+    return
+        ( ( memory_size + huge_page_size - 1 ) / huge_page_size ) * huge_page_size;
+}
+
+CORE_API void* ___internal_system_huge_page_alloc(
+    usize pages, MemoryHugePageKind* out_kind
+) {
+    usize memory_size = ___huge_page_memory_size( pages );
+    void* result = platform_huge_page_alloc( memory_size, out_kind );
+
+    if( result ) {
+        atomic_fetch_add_usize(
+            &PAGE_MEMORY_USAGE, memory_size / ___get_page_size(), MEMORY_ORDER_RELAXED );
+    }
+    return result;
+}
+CORE_API void  ___internal_system_huge_page_free( void* memory, usize pages ) {
+    usize memory_size = ___huge_page_memory_size( pages );
+    atomic_fetch_sub_usize(
+        &PAGE_MEMORY_USAGE, memory_size / ___get_page_size(), MEMORY_ORDER_RELAXED );
+    platform_huge_page_free( memory, memory_size );
+}
+
+CORE_API void* ___internal_system_huge_page_alloc_trace(
+    usize pages, MemoryHugePageKind* out_kind, MemoryTag tag,
+    const char* function, const char* file, int line
+) {
+    usize memory_size = ___huge_page_memory_size( pages );
+    void* result = platform_huge_page_alloc( memory_size, out_kind );
+
+    if( result ) {
+        LOG_MEMORY_SUCCESS(
+            "HUGE PAGE", "Allocated {f,m,.2} ({cc}). Pointer: {usize,X}",
+            (f64)memory_size, memory_huge_page_kind_to_cstr( *out_kind ),
+            (usize)result );
+        atomic_fetch_add_usize(
+            &PAGE_MEMORY_USAGE, memory_size / ___get_page_size(), MEMORY_ORDER_RELAXED );
+        ___internal_memory_telemetry_record_alloc(
+            tag, MEMORY_ALLOCATOR_PAGE, NULL, result, memory_size, file, line );
+    } else {
+        LOG_MEMORY_ERROR(
+            "HUGE PAGE", "Failed to allocate {f,m,.2}!",
+            (f64)memory_size );
+    }
+
+    return result;
+}
+CORE_API void  ___internal_system_huge_page_free_trace(
+    void* memory, usize pages, const char* function, const char* file, int line
+) {
+    usize memory_size = ___huge_page_memory_size( pages );
+    LOG_MEMORY_SUCCESS(
+        "HUGE PAGE", "Freed {f,m,.2}. Pointer: {usize,X}",
+        (f64)memory_size, (usize)memory );
+    atomic_fetch_sub_usize(
+        &PAGE_MEMORY_USAGE, memory_size / ___get_page_size(), MEMORY_ORDER_RELAXED );
+    ___internal_memory_telemetry_record_free( NULL, memory );
+    ___internal_memory_telemetry_record_free_range( memory, memory_size );
+    platform_huge_page_free( memory, memory_size );
+}
+
+internal force_inline usize ___round_up_to( usize size, usize granularity ) {
+    return ( ( size + granularity - 1 ) / granularity ) * granularity;
+}
+
+CORE_API b32 virtual_arena_create(
+    usize reserve_size, usize commit_granularity, VirtualArena* out_arena
+) {
+    usize page_size = ___get_page_size();
+
+    usize reserved    = ___round_up_to( reserve_size, page_size );
+    usize granularity =
+        ___round_up_to( commit_granularity ? commit_granularity : 1, page_size );
+
+    void* buffer = platform_virtual_reserve( reserved );
+    if( !buffer ) {
+        core_log_error(
+            "Failed to reserve {f,m,.2} for virtual arena!", (f64)reserved );
+        return false;
+    }
+
+    VirtualArena result = {};
+    result.buffer             = buffer;
+    result.reserved           = reserved;
+    result.commit_granularity = granularity;
+
+    *out_arena = result;
+    return true;
+}
+CORE_API void virtual_arena_destroy( VirtualArena* arena ) {
+    if( !arena->buffer ) {
+        return;
+    }
+    atomic_fetch_sub_usize(
+        &PAGE_MEMORY_USAGE, arena->committed / ___get_page_size(), MEMORY_ORDER_RELAXED );
+    platform_virtual_release( arena->buffer, arena->reserved );
+
+    VirtualArena zero = {};
+    *arena = zero;
+}
+CORE_API void* virtual_arena_push( VirtualArena* arena, usize size ) {
+    usize new_current = arena->current + size;
+    if( new_current > arena->reserved ) {
+        return NULL;
+    }
+
+    if( new_current > arena->committed ) {
+        usize commit_size = ___round_up_to(
+            new_current - arena->committed, arena->commit_granularity );
+        if( arena->committed + commit_size > arena->reserved ) {
+            commit_size = arena->reserved - arena->committed;
+        }
+
+        void* commit_start = (u8*)arena->buffer + arena->committed;
+        if( !platform_virtual_commit( commit_start, commit_size ) ) {
+            core_log_error(
+                "Failed to commit {f,m,.2} for virtual arena!",
+                (f64)commit_size );
+            return NULL;
+        }
+
+        atomic_fetch_add_usize(
+            &PAGE_MEMORY_USAGE, commit_size / ___get_page_size(), MEMORY_ORDER_RELAXED );
+        arena->committed  += commit_size;
+        if( arena->committed > arena->committed_high_water_mark ) {
+            arena->committed_high_water_mark = arena->committed;
+        }
+    }
+
+    void* result = (u8*)arena->buffer + arena->current;
+    arena->current = new_current;
+    if( arena->current > arena->high_water_mark ) {
+        arena->high_water_mark = arena->current;
+    }
+
+    return result;
+}
+CORE_API void* virtual_arena_push_aligned(
+    VirtualArena* arena, usize size, usize alignment
+) {
+    usize aligned_size = ___aligned_size( size, alignment );
+    void* memory = virtual_arena_push( arena, aligned_size );
+    if( memory ) {
+        void* result = ___set_aligned_pointer( memory, alignment );
+        return result;
+    }
+
+    return memory;
+}
+CORE_API b32 virtual_arena_pop( VirtualArena* arena, usize size ) {
+    if( size > arena->current ) {
+        return false;
+    }
+    arena->current -= size;
+    memory_zero( (u8*)arena->buffer + arena->current, size );
+    return true;
+}
+CORE_API b32 virtual_arena_pop_aligned(
+    VirtualArena* arena, usize size, usize alignment
+) {
+    usize aligned_size = ___aligned_size( size, alignment );
+    return virtual_arena_pop( arena, aligned_size );
+}
+CORE_API void virtual_arena_reset( VirtualArena* arena, b32 decommit ) {
+    if( decommit ) {
+        if( arena->committed ) {
+            platform_virtual_decommit( arena->buffer, arena->committed );
+            atomic_fetch_sub_usize(
+                &PAGE_MEMORY_USAGE, arena->committed / ___get_page_size(), MEMORY_ORDER_RELAXED );
+        }
+        arena->committed = 0;
+    } else {
+        memory_zero( arena->buffer, arena->current );
+    }
+    arena->current = 0;
+}
+CORE_API VirtualArenaStats virtual_arena_query_stats( VirtualArena* arena ) {
+    VirtualArenaStats result = {};
+    result.current                   = arena->current;
+    result.committed                 = arena->committed;
+    result.reserved                  = arena->reserved;
+    result.high_water_mark           = arena->high_water_mark;
+    result.committed_high_water_mark = arena->committed_high_water_mark;
+    return result;
+}
+CORE_API MemoryHugePageKind virtual_arena_request_huge_pages( VirtualArena* arena ) {
+    assert( !arena->committed );
+
+    MemoryHugePageKind result =
+        platform_virtual_advise_huge_pages( arena->buffer, arena->reserved );
+    if( result != MEMORY_HUGE_PAGE_NONE ) {
+        // NOTE(alicia): committing a page at a time would
+        // split huge pages back into regular pages.
+        arena->commit_granularity =
+            ___round_up_to( arena->commit_granularity, platform_huge_page_size() );
+    }
+    return result;
 }
 
 CORE_API void* ___internal_system_alloc( usize size ) {
     void* result = platform_heap_alloc( size );
     if( result ) {
-        HEAP_MEMORY_USAGE += size;
+        atomic_fetch_add_usize( &HEAP_MEMORY_USAGE, size, MEMORY_ORDER_RELAXED );
     }
     return result;
 }
@@ -340,33 +1191,35 @@ CORE_API void* ___internal_system_realloc(
 ) {
     void* result = platform_heap_realloc( memory, old_size, new_size );
     if( result ) {
-        HEAP_MEMORY_USAGE -= old_size;
-        HEAP_MEMORY_USAGE += new_size;
+        atomic_fetch_sub_usize( &HEAP_MEMORY_USAGE, old_size, MEMORY_ORDER_RELAXED );
+        atomic_fetch_add_usize( &HEAP_MEMORY_USAGE, new_size, MEMORY_ORDER_RELAXED );
     }
     return result;
 }
 CORE_API void ___internal_system_free( void* memory, usize size ) {
-    HEAP_MEMORY_USAGE -= size;
+    atomic_fetch_sub_usize( &HEAP_MEMORY_USAGE, size, MEMORY_ORDER_RELAXED );
     platform_heap_free( memory, size );
 }
 CORE_API void ___internal_system_free_aligned(
     void* memory, usize size, usize alignment
 ) {
     usize aligned_size = ___aligned_size( size, alignment );
-    HEAP_MEMORY_USAGE -= aligned_size;
+    atomic_fetch_sub_usize( &HEAP_MEMORY_USAGE, aligned_size, MEMORY_ORDER_RELAXED );
     platform_heap_free( ___get_aligned_pointer( memory ), aligned_size );
 }
 
 CORE_API void* ___internal_system_alloc_trace(
-    usize size, const char* function, const char* file, int line
+    usize size, MemoryTag tag,
+    const char* function, const char* file, int line
 ) {
     void* result = platform_heap_alloc( size );
     if( result ) {
-        f64 sizef = (f64)size;
         LOG_MEMORY_SUCCESS(
             "HEAP", "Allocated {f,m,.2}. Pointer: {usize,X}",
-            sizef, (usize)result );
-        HEAP_MEMORY_USAGE += size;
+            (f64)size, (usize)result );
+        atomic_fetch_add_usize( &HEAP_MEMORY_USAGE, size, MEMORY_ORDER_RELAXED );
+        ___internal_memory_telemetry_record_alloc(
+            tag, MEMORY_ALLOCATOR_SYSTEM, NULL, result, size, file, line );
     } else {
         LOG_MEMORY_ERROR( "HEAP", "Failed to allocate {f,m,.2}!", (f64)size );
     }
@@ -374,13 +1227,16 @@ CORE_API void* ___internal_system_alloc_trace(
     return result;
 }
 CORE_API void* ___internal_system_alloc_aligned_trace(
-    usize size, usize alignment, const char* function, const char* file, int line
+    usize size, usize alignment, MemoryTag tag,
+    const char* function, const char* file, int line
 ) {
     void* result = ___internal_system_alloc_aligned( size, alignment );
     if( result ) {
         LOG_MEMORY_SUCCESS(
             "HEAP", "Allocated {f,m,.2}. Alignment: {usize} Pointer: {usize,X}",
             (f64)size, alignment, (usize)result );
+        ___internal_memory_telemetry_record_alloc(
+            tag, MEMORY_ALLOCATOR_SYSTEM, NULL, result, size, file, line );
     } else {
         LOG_MEMORY_ERROR(
             "HEAP", "Failed to allocate {f,m,.2}! Alignment: {usize}",
@@ -389,7 +1245,7 @@ CORE_API void* ___internal_system_alloc_aligned_trace(
     return result;
 }
 CORE_API void* ___internal_system_realloc_trace(
-    void* memory, usize old_size, usize new_size,
+    void* memory, usize old_size, usize new_size, MemoryTag tag,
     const char* function, const char* file, int line
 ) {
     void* result = platform_heap_realloc( memory, old_size, new_size );
@@ -397,8 +1253,11 @@ CORE_API void* ___internal_system_realloc_trace(
         LOG_MEMORY_SUCCESS(
             "HEAP", "Reallocated {usize,X}. {f,m,.2} -> {f,m,.2}",
             (usize)memory, (f64)old_size, (f64)new_size );
-        HEAP_MEMORY_USAGE -= old_size;
-        HEAP_MEMORY_USAGE += new_size;
+        atomic_fetch_sub_usize( &HEAP_MEMORY_USAGE, old_size, MEMORY_ORDER_RELAXED );
+        atomic_fetch_add_usize( &HEAP_MEMORY_USAGE, new_size, MEMORY_ORDER_RELAXED );
+        ___internal_memory_telemetry_record_free( NULL, memory );
+        ___internal_memory_telemetry_record_alloc(
+            tag, MEMORY_ALLOCATOR_SYSTEM, NULL, result, new_size, file, line );
     } else {
         LOG_MEMORY_SUCCESS(
             "HEAP", "Failed to reallocate {usize,X}! {f,m,.2} -> {f,m,.2}",
@@ -409,16 +1268,18 @@ CORE_API void* ___internal_system_realloc_trace(
 CORE_API void ___internal_system_free_trace(
     void* memory, usize size, const char* function, const char* file, int line
 ) {
+    ___internal_memory_telemetry_record_free( NULL, memory );
     platform_heap_free( memory, size );
     LOG_MEMORY_SUCCESS(
         "HEAP", "Freed {f,m,.2}. Pointer: {usize,X}",
         (f64)size, (usize)memory );
-    HEAP_MEMORY_USAGE -= size;
+    atomic_fetch_sub_usize( &HEAP_MEMORY_USAGE, size, MEMORY_ORDER_RELAXED );
 }
 CORE_API void ___internal_system_free_aligned_trace(
     void* memory, usize size, usize alignment,
     const char* function, const char* file, int line
 ) {
+    ___internal_memory_telemetry_record_free( NULL, memory );
     ___internal_system_free_aligned( memory, size, alignment );
     LOG_MEMORY_SUCCESS(
         "HEAP", "Freed {f,m,.2}. Alignment: {usize} Pointer: {usize,X}",
@@ -439,16 +1300,7 @@ CORE_API void memory_copy_overlapped( void* dst, const void* src, usize size ) {
 CORE_API void memory_set( void* dst, u8 value, usize size ) {
     (void)memset( dst, value, size );
 }
-CORE_API void memory_set_chunks(
-    void* in_dst, usize chunk_size, void* chunk, usize chunk_count
-) {
-    u8* dst = in_dst;
-    for( usize i = 0; i < chunk_count; ++i ) {
-        memory_copy( dst, chunk, chunk_size );
-        dst += chunk_size;
-    }
-}
-CORE_API b32 memory_cmp( const void* a, const void* b, usize size ) {
+internal b32 ___memory_cmp_scalar( const void* a, const void* b, usize size ) {
     usize size64 = size / sizeof(u64);
     for( usize i = 0; i < size64; ++i ) {
         if( *((u64*)a + i) != *((u64*)b + i) ) {
@@ -467,4 +1319,375 @@ CORE_API b32 memory_cmp( const void* a, const void* b, usize size ) {
 
     return true;
 }
+internal b32 ___memory_find_byte_scalar(
+    const void* memory, usize size, u8 value, usize* out_index
+) {
+    const u8* bytes = memory;
+    for( usize i = 0; i < size; ++i ) {
+        if( bytes[i] == value ) {
+            *out_index = i;
+            return true;
+        }
+    }
+    return false;
+}
+internal usize ___memory_count_byte_scalar(
+    const void* memory, usize size, u8 value
+) {
+    const u8* bytes = memory;
+    usize result = 0;
+    for( usize i = 0; i < size; ++i ) {
+        result += bytes[i] == value;
+    }
+    return result;
+}
+internal b32 ___memory_is_zero_scalar( const void* memory, usize size ) {
+    usize size64 = size / sizeof(u64);
+    u64 accumulator = 0;
+    for( usize i = 0; i < size64; ++i ) {
+        accumulator |= *((u64*)memory + i);
+    }
+
+    const u8* remainder = (u8*)((u64*)memory + size64);
+    for( usize i = 0; i < size % sizeof(u64); ++i ) {
+        accumulator |= remainder[i];
+    }
+
+    return accumulator == 0;
+}
+/// Fill destination with chunk by doubling the already filled region,
+/// takes log2(chunk_count) copies instead of chunk_count.
+internal void ___memory_set_chunks_scalar(
+    void* in_dst, usize chunk_size, void* chunk, usize chunk_count
+) {
+    if( !chunk_size || !chunk_count ) {
+        return;
+    }
+    u8* dst = in_dst;
+    usize total  = chunk_size * chunk_count;
+    usize filled = chunk_size;
+    memory_copy( dst, chunk, chunk_size );
+    while( filled < total ) {
+        usize copy_size = filled;
+        if( copy_size > total - filled ) {
+            copy_size = total - filled;
+        }
+        memory_copy( dst + filled, dst, copy_size );
+        filled += copy_size;
+    }
+}
+
+#if defined(LD_ARCH_X86)
+
+internal b32 ___memory_cmp_sse2( const void* a, const void* b, usize size ) {
+    const u8* a8 = a;
+    const u8* b8 = b;
+    usize i = 0;
+    for( ; i + 16 <= size; i += 16 ) {
+        __m128i va = _mm_loadu_si128( (__m128i*)( a8 + i ) );
+        __m128i vb = _mm_loadu_si128( (__m128i*)( b8 + i ) );
+        if( _mm_movemask_epi8( _mm_cmpeq_epi8( va, vb ) ) != 0xFFFF ) {
+            return false;
+        }
+    }
+    return ___memory_cmp_scalar( a8 + i, b8 + i, size - i );
+}
+internal b32 ___memory_find_byte_sse2(
+    const void* memory, usize size, u8 value, usize* out_index
+) {
+    const u8* bytes = memory;
+    __m128i needle = _mm_set1_epi8( (char)value );
+    usize i = 0;
+    for( ; i + 16 <= size; i += 16 ) {
+        __m128i v = _mm_loadu_si128( (__m128i*)( bytes + i ) );
+        u32 mask = (u32)_mm_movemask_epi8( _mm_cmpeq_epi8( v, needle ) );
+        if( mask ) {
+            *out_index = i + __builtin_ctz( mask );
+            return true;
+        }
+    }
+    if( ___memory_find_byte_scalar( bytes + i, size - i, value, out_index ) ) {
+        *out_index += i;
+        return true;
+    }
+    return false;
+}
+internal usize ___memory_count_byte_sse2(
+    const void* memory, usize size, u8 value
+) {
+    const u8* bytes = memory;
+    __m128i needle = _mm_set1_epi8( (char)value );
+    __m128i zero   = _mm_setzero_si128();
+    __m128i total  = _mm_setzero_si128();
+    usize i = 0;
+    while( i + 16 <= size ) {
+        // NOTE(alicia): byte counters overflow after 255 iterations.
+        __m128i counts = _mm_setzero_si128();
+        usize iterations = ( size - i ) / 16;
+        if( iterations > 255 ) {
+            iterations = 255;
+        }
+        for( usize j = 0; j < iterations; ++j, i += 16 ) {
+            __m128i v = _mm_loadu_si128( (__m128i*)( bytes + i ) );
+            counts = _mm_sub_epi8( counts, _mm_cmpeq_epi8( v, needle ) );
+        }
+        total = _mm_add_epi64( total, _mm_sad_epu8( counts, zero ) );
+    }
+    usize result =
+        (usize)_mm_cvtsi128_si64( total ) +
+        (usize)_mm_cvtsi128_si64( _mm_unpackhi_epi64( total, total ) );
+    return result + ___memory_count_byte_scalar( bytes + i, size - i, value );
+}
+internal b32 ___memory_is_zero_sse2( const void* memory, usize size ) {
+    const u8* bytes = memory;
+    __m128i zero = _mm_setzero_si128();
+    usize i = 0;
+    for( ; i + 64 <= size; i += 64 ) {
+        __m128i v0 = _mm_loadu_si128( (__m128i*)( bytes + i ) );
+        __m128i v1 = _mm_loadu_si128( (__m128i*)( bytes + i + 16 ) );
+        __m128i v2 = _mm_loadu_si128( (__m128i*)( bytes + i + 32 ) );
+        __m128i v3 = _mm_loadu_si128( (__m128i*)( bytes + i + 48 ) );
+        __m128i v  = _mm_or_si128( _mm_or_si128( v0, v1 ), _mm_or_si128( v2, v3 ) );
+        if( _mm_movemask_epi8( _mm_cmpeq_epi8( v, zero ) ) != 0xFFFF ) {
+            return false;
+        }
+    }
+    return ___memory_is_zero_scalar( bytes + i, size - i );
+}
+internal void ___memory_set_chunks_sse2(
+    void* in_dst, usize chunk_size, void* chunk, usize chunk_count
+) {
+    // NOTE(alicia): chunks that evenly divide a register
+    // are broadcast and stored a register at a time.
+    if( !chunk_size || 16 % chunk_size ) {
+        ___memory_set_chunks_scalar( in_dst, chunk_size, chunk, chunk_count );
+        return;
+    }
+
+    u8 pattern_bytes[16];
+    for( usize i = 0; i < 16; i += chunk_size ) {
+        memory_copy( pattern_bytes + i, chunk, chunk_size );
+    }
+    __m128i pattern = _mm_loadu_si128( (__m128i*)pattern_bytes );
+
+    u8* dst = in_dst;
+    usize total = chunk_size * chunk_count;
+    usize i = 0;
+    for( ; i + 16 <= total; i += 16 ) {
+        _mm_storeu_si128( (__m128i*)( dst + i ), pattern );
+    }
+    memory_copy( dst + i, pattern_bytes, total - i );
+}
+
+internal target_features( "avx2" )
+b32 ___memory_cmp_avx2( const void* a, const void* b, usize size ) {
+    const u8* a8 = a;
+    const u8* b8 = b;
+    usize i = 0;
+    for( ; i + 32 <= size; i += 32 ) {
+        __m256i va = _mm256_loadu_si256( (__m256i*)( a8 + i ) );
+        __m256i vb = _mm256_loadu_si256( (__m256i*)( b8 + i ) );
+        if( _mm256_movemask_epi8( _mm256_cmpeq_epi8( va, vb ) ) != -1 ) {
+            return false;
+        }
+    }
+    return ___memory_cmp_sse2( a8 + i, b8 + i, size - i );
+}
+internal target_features( "avx2" )
+b32 ___memory_find_byte_avx2(
+    const void* memory, usize size, u8 value, usize* out_index
+) {
+    const u8* bytes = memory;
+    __m256i needle = _mm256_set1_epi8( (char)value );
+    usize i = 0;
+    for( ; i + 32 <= size; i += 32 ) {
+        __m256i v = _mm256_loadu_si256( (__m256i*)( bytes + i ) );
+        u32 mask = (u32)_mm256_movemask_epi8( _mm256_cmpeq_epi8( v, needle ) );
+        if( mask ) {
+            *out_index = i + __builtin_ctz( mask );
+            return true;
+        }
+    }
+    if( ___memory_find_byte_sse2( bytes + i, size - i, value, out_index ) ) {
+        *out_index += i;
+        return true;
+    }
+    return false;
+}
+internal target_features( "avx2" )
+usize ___memory_count_byte_avx2(
+    const void* memory, usize size, u8 value
+) {
+    const u8* bytes = memory;
+    __m256i needle = _mm256_set1_epi8( (char)value );
+    __m256i zero   = _mm256_setzero_si256();
+    __m256i total  = _mm256_setzero_si256();
+    usize i = 0;
+    while( i + 32 <= size ) {
+        // NOTE(alicia): byte counters overflow after 255 iterations.
+        __m256i counts = _mm256_setzero_si256();
+        usize iterations = ( size - i ) / 32;
+        if( iterations > 255 ) {
+            iterations = 255;
+        }
+        for( usize j = 0; j < iterations; ++j, i += 32 ) {
+            __m256i v = _mm256_loadu_si256( (__m256i*)( bytes + i ) );
+            counts = _mm256_sub_epi8( counts, _mm256_cmpeq_epi8( v, needle ) );
+        }
+        total = _mm256_add_epi64( total, _mm256_sad_epu8( counts, zero ) );
+    }
+    usize result =
+        (usize)_mm256_extract_epi64( total, 0 ) +
+        (usize)_mm256_extract_epi64( total, 1 ) +
+        (usize)_mm256_extract_epi64( total, 2 ) +
+        (usize)_mm256_extract_epi64( total, 3 );
+    return result + ___memory_count_byte_sse2( bytes + i, size - i, value );
+}
+internal target_features( "avx2" )
+b32 ___memory_is_zero_avx2( const void* memory, usize size ) {
+    const u8* bytes = memory;
+    usize i = 0;
+    for( ; i + 128 <= size; i += 128 ) {
+        __m256i v0 = _mm256_loadu_si256( (__m256i*)( bytes + i ) );
+        __m256i v1 = _mm256_loadu_si256( (__m256i*)( bytes + i + 32 ) );
+        __m256i v2 = _mm256_loadu_si256( (__m256i*)( bytes + i + 64 ) );
+        __m256i v3 = _mm256_loadu_si256( (__m256i*)( bytes + i + 96 ) );
+        __m256i v  = _mm256_or_si256(
+            _mm256_or_si256( v0, v1 ), _mm256_or_si256( v2, v3 ) );
+        if( !_mm256_testz_si256( v, v ) ) {
+            return false;
+        }
+    }
+    return ___memory_is_zero_sse2( bytes + i, size - i );
+}
+internal target_features( "avx2" )
+void ___memory_set_chunks_avx2(
+    void* in_dst, usize chunk_size, void* chunk, usize chunk_count
+) {
+    if( !chunk_size || 32 % chunk_size ) {
+        ___memory_set_chunks_scalar( in_dst, chunk_size, chunk, chunk_count );
+        return;
+    }
+
+    u8 pattern_bytes[32];
+    for( usize i = 0; i < 32; i += chunk_size ) {
+        memory_copy( pattern_bytes + i, chunk, chunk_size );
+    }
+    __m256i pattern = _mm256_loadu_si256( (__m256i*)pattern_bytes );
+
+    u8* dst = in_dst;
+    usize total = chunk_size * chunk_count;
+    usize i = 0;
+    for( ; i + 32 <= total; i += 32 ) {
+        _mm256_storeu_si256( (__m256i*)( dst + i ), pattern );
+    }
+    memory_copy( dst + i, pattern_bytes, total - i );
+}
+
+#endif /* x86 */
+
+typedef b32 ___MemoryCmpFN( const void* a, const void* b, usize size );
+typedef b32 ___MemoryFindByteFN(
+    const void* memory, usize size, u8 value, usize* out_index );
+typedef usize ___MemoryCountByteFN( const void* memory, usize size, u8 value );
+typedef b32 ___MemoryIsZeroFN( const void* memory, usize size );
+typedef void ___MemorySetChunksFN(
+    void* dst, usize chunk_size, void* chunk, usize chunk_count );
+
+internal b32 ___memory_cmp_resolve( const void* a, const void* b, usize size );
+internal b32 ___memory_find_byte_resolve(
+    const void* memory, usize size, u8 value, usize* out_index );
+internal usize ___memory_count_byte_resolve(
+    const void* memory, usize size, u8 value );
+internal b32 ___memory_is_zero_resolve( const void* memory, usize size );
+internal void ___memory_set_chunks_resolve(
+    void* dst, usize chunk_size, void* chunk, usize chunk_count );
+
+// NOTE(alicia): every function starts out pointing at a resolver that
+// selects implementations from cpu features on first call,
+// after that calls go straight to the selected implementation.
+global ___MemoryCmpFN*       global_memory_cmp        = ___memory_cmp_resolve;
+global ___MemoryFindByteFN*  global_memory_find_byte  = ___memory_find_byte_resolve;
+global ___MemoryCountByteFN* global_memory_count_byte = ___memory_count_byte_resolve;
+global ___MemoryIsZeroFN*    global_memory_is_zero    = ___memory_is_zero_resolve;
+global ___MemorySetChunksFN* global_memory_set_chunks = ___memory_set_chunks_resolve;
+
+internal void ___memory_primitives_resolve(void) {
+    ___MemoryCmpFN*       cmp        = ___memory_cmp_scalar;
+    ___MemoryFindByteFN*  find_byte  = ___memory_find_byte_scalar;
+    ___MemoryCountByteFN* count_byte = ___memory_count_byte_scalar;
+    ___MemoryIsZeroFN*    is_zero    = ___memory_is_zero_scalar;
+    ___MemorySetChunksFN* set_chunks = ___memory_set_chunks_scalar;
+
+#if defined(LD_ARCH_X86)
+    CPUFeatureFlags features = system_info_query_features();
+    if( bitfield_check( features, CPU_FEATURE_AVX2 ) ) {
+        cmp        = ___memory_cmp_avx2;
+        find_byte  = ___memory_find_byte_avx2;
+        count_byte = ___memory_count_byte_avx2;
+        is_zero    = ___memory_is_zero_avx2;
+        set_chunks = ___memory_set_chunks_avx2;
+    } else if( bitfield_check( features, CPU_FEATURE_SSE2 ) ) {
+        cmp        = ___memory_cmp_sse2;
+        find_byte  = ___memory_find_byte_sse2;
+        count_byte = ___memory_count_byte_sse2;
+        is_zero    = ___memory_is_zero_sse2;
+        set_chunks = ___memory_set_chunks_sse2;
+    }
+#endif
+
+    // NOTE(alicia): every thread resolves to the same functions
+    // so racing on these stores is harmless.
+    global_memory_cmp        = cmp;
+    global_memory_find_byte  = find_byte;
+    global_memory_count_byte = count_byte;
+    global_memory_is_zero    = is_zero;
+    global_memory_set_chunks = set_chunks;
+}
+internal b32 ___memory_cmp_resolve( const void* a, const void* b, usize size ) {
+    ___memory_primitives_resolve();
+    return global_memory_cmp( a, b, size );
+}
+internal b32 ___memory_find_byte_resolve(
+    const void* memory, usize size, u8 value, usize* out_index
+) {
+    ___memory_primitives_resolve();
+    return global_memory_find_byte( memory, size, value, out_index );
+}
+internal usize ___memory_count_byte_resolve(
+    const void* memory, usize size, u8 value
+) {
+    ___memory_primitives_resolve();
+    return global_memory_count_byte( memory, size, value );
+}
+internal b32 ___memory_is_zero_resolve( const void* memory, usize size ) {
+    ___memory_primitives_resolve();
+    return global_memory_is_zero( memory, size );
+}
+internal void ___memory_set_chunks_resolve(
+    void* dst, usize chunk_size, void* chunk, usize chunk_count
+) {
+    ___memory_primitives_resolve();
+    global_memory_set_chunks( dst, chunk_size, chunk, chunk_count );
+}
+
+CORE_API void memory_set_chunks(
+    void* dst, usize chunk_size, void* chunk, usize chunk_count
+) {
+    global_memory_set_chunks( dst, chunk_size, chunk, chunk_count );
+}
+CORE_API b32 memory_cmp( const void* a, const void* b, usize size ) {
+    return global_memory_cmp( a, b, size );
+}
+CORE_API b32 memory_find_byte(
+    const void* memory, usize size, u8 value, usize* out_index
+) {
+    return global_memory_find_byte( memory, size, value, out_index );
+}
+CORE_API usize memory_count_byte( const void* memory, usize size, u8 value ) {
+    return global_memory_count_byte( memory, size, value );
+}
+CORE_API b32 memory_is_zero( const void* memory, usize size ) {
+    return global_memory_is_zero( memory, size );
+}
 
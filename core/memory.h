@@ -4,9 +4,11 @@
  * Description:  Memory Functions
  * Author:       Alicia Amarilla (smushyaa@gmail.com)
  * File Created: September 27, 2023
- * Notes:        define LD_MEMORY_NO_LOG before including to disable logging allocations
+ * Notes:        define LD_MEMORY_NO_LOG before including to disable logging
+ *               and telemetry of allocations
 */
 #include "shared/defines.h"
+#include "core/telemetry.h"
 
 /// Slice of bytes.
 struct ByteSlice {
@@ -42,12 +44,53 @@ struct StackAllocator {
 /// Stack allocator.
 typedef struct StackAllocator StackAllocator;
 
+/// Kind of huge pages backing an allocation.
+typedef enum MemoryHugePageKind : u32 {
+    /// Regular pages, huge pages are unavailable or disabled.
+    MEMORY_HUGE_PAGE_NONE,
+    /// Explicit huge pages reserved from system pool (MAP_HUGETLB/MEM_LARGE_PAGES).
+    MEMORY_HUGE_PAGE_EXPLICIT,
+    /// Transparent huge pages, promoted by the kernel when possible (MADV_HUGEPAGE).
+    MEMORY_HUGE_PAGE_TRANSPARENT,
+} MemoryHugePageKind;
+
+/// Virtual memory arena.
+/// Reserves address space up front and commits pages as it grows.
+struct VirtualArena {
+    void* buffer;
+    usize current;
+    usize committed;
+    usize reserved;
+    usize commit_granularity;
+    usize high_water_mark;
+    usize committed_high_water_mark;
+};
+/// Virtual memory arena.
+typedef struct VirtualArena VirtualArena;
+
+/// Virtual memory arena statistics.
+typedef struct VirtualArenaStats {
+    /// Bytes currently pushed onto arena.
+    usize current;
+    /// Bytes currently backed by physical memory.
+    usize committed;
+    /// Bytes of address space reserved.
+    usize reserved;
+    /// Largest number of bytes ever pushed onto arena.
+    usize high_water_mark;
+    /// Largest number of bytes ever committed.
+    usize committed_high_water_mark;
+} VirtualArenaStats;
+
 /// Fixed-size block allocator.
 struct BlockAllocator {
     void* buffer;
     usize block_size;
     usize block_count;
-    u8    free_list[];
+    /// Upper bound of longest run of free blocks.
+    usize largest_free_run;
+    /// Bitset of blocks, set bit means block is in use.
+    u64   free_list[];
 };
 /// Fixed-size block allocator.
 typedef struct BlockAllocator BlockAllocator;
@@ -59,43 +102,153 @@ CORE_API usize block_allocator_memory_requirement( usize block_count, usize bloc
 CORE_API BlockAllocator* block_allocator_create(
     usize block_count, usize block_size, void* buffer );
 /// Allocate memory from block allocator.
-CORE_API void* block_allocator_alloc( BlockAllocator* allocator, usize size );
+CORE_API void* ___internal_block_allocator_alloc( BlockAllocator* allocator, usize size );
 /// Allocate aligned memory from block allocator.
-CORE_API void* block_allocator_alloc_aligned(
+CORE_API void* ___internal_block_allocator_alloc_aligned(
     BlockAllocator* allocator, usize size, usize alignment );
 /// Reallocate memory from block allocator.
-CORE_API void* block_allocator_realloc(
+CORE_API void* ___internal_block_allocator_realloc(
     BlockAllocator* allocator, void* memory, usize old_size, usize new_size );
 /// Free memory from block allocator.
-CORE_API void block_allocator_free( BlockAllocator* allocator, void* memory, usize size );
+CORE_API void ___internal_block_allocator_free(
+    BlockAllocator* allocator, void* memory, usize size );
+/// Free aligned memory from block allocator.
+CORE_API void ___internal_block_allocator_free_aligned(
+    BlockAllocator* allocator, void* memory, usize size, usize alignment );
+/// Clears free list and zeroes out buffer.
+CORE_API void ___internal_block_allocator_clear( BlockAllocator* allocator );
+
+/// Allocate memory from block allocator.
+CORE_API void* ___internal_block_allocator_alloc_trace(
+    BlockAllocator* allocator, usize size,
+    MemoryTag tag, const char* file, int line );
+/// Allocate aligned memory from block allocator.
+CORE_API void* ___internal_block_allocator_alloc_aligned_trace(
+    BlockAllocator* allocator, usize size, usize alignment,
+    MemoryTag tag, const char* file, int line );
+/// Reallocate memory from block allocator.
+CORE_API void* ___internal_block_allocator_realloc_trace(
+    BlockAllocator* allocator, void* memory, usize old_size, usize new_size,
+    MemoryTag tag, const char* file, int line );
+/// Free memory from block allocator.
+CORE_API void ___internal_block_allocator_free_trace(
+    BlockAllocator* allocator, void* memory, usize size );
 /// Free aligned memory from block allocator.
-CORE_API void block_allocator_free_aligned(
+CORE_API void ___internal_block_allocator_free_aligned_trace(
     BlockAllocator* allocator, void* memory, usize size, usize alignment );
 /// Clears free list and zeroes out buffer.
-CORE_API void block_allocator_clear( BlockAllocator* allocator );
+CORE_API void ___internal_block_allocator_clear_trace( BlockAllocator* allocator );
+
+/// Size-class slab allocator with per-thread caches.
+typedef struct SlabAllocator SlabAllocator;
+/// Largest allocation served by slab allocator,
+/// larger allocations go to system allocator.
+#define SLAB_ALLOCATOR_MAX_SIZE (kilobytes(16))
+
+/// Calculate how many bytes are required for slab allocator.
+/// Thread count must include the main thread.
+CORE_API usize slab_allocator_memory_requirement( usize thread_count );
+/// Create a slab allocator.
+/// Buffer must be able to hold result from slab_allocator_memory_requirement().
+CORE_API SlabAllocator* slab_allocator_create( usize thread_count, void* buffer );
+/// Return all slabs to the system.
+/// Any memory still allocated from slab allocator becomes invalid.
+CORE_API void slab_allocator_destroy( SlabAllocator* allocator );
+/// Allocate memory from slab allocator.
+/// Thread index must be unique to calling thread, same as job thread index.
+/// Memory returned is always zeroed.
+CORE_API void* slab_allocator_alloc(
+    SlabAllocator* allocator, usize thread_index, usize size );
+/// Free memory allocated from slab allocator.
+/// Memory can be freed from any thread.
+CORE_API void slab_allocator_free(
+    SlabAllocator* allocator, usize thread_index, void* memory, usize size );
+/// Return thread's cached memory to shared lists.
+/// Less than one batch per size class stays cached.
+CORE_API void slab_allocator_flush( SlabAllocator* allocator, usize thread_index );
 
 /// Create a stack allocator.
 CORE_API StackAllocator stack_allocator_create( usize buffer_size, void* buffer );
 /// Push item onto stack.
 /// Returns NULL if item is too large to fit in allocator.
-CORE_API void* stack_allocator_push( StackAllocator* allocator, usize size );
+CORE_API void* ___internal_stack_allocator_push( StackAllocator* allocator, usize size );
 /// Push item onto stack.
 /// Pointer returned is aligned to given alignment
 /// Returns NULL if item is too large to fit in allocator.
-CORE_API void* stack_allocator_push_aligned(
+CORE_API void* ___internal_stack_allocator_push_aligned(
     StackAllocator* allocator, usize size, usize alignment );
 /// Pop item from stack.
-CORE_API b32 stack_allocator_pop( StackAllocator* allocator, usize size );
+CORE_API b32 ___internal_stack_allocator_pop( StackAllocator* allocator, usize size );
 /// Pop aligned item from stack.
-CORE_API b32 stack_allocator_pop_aligned(
+CORE_API b32 ___internal_stack_allocator_pop_aligned(
     StackAllocator* allocator, usize size, usize alignment );
 /// Resets current pointer and zeroes out entire buffer.
-CORE_API void stack_allocator_clear( StackAllocator* allocator );
+CORE_API void ___internal_stack_allocator_clear( StackAllocator* allocator );
+
+/// Push item onto stack.
+/// Returns NULL if item is too large to fit in allocator.
+CORE_API void* ___internal_stack_allocator_push_trace(
+    StackAllocator* allocator, usize size,
+    MemoryTag tag, const char* file, int line );
+/// Push item onto stack.
+/// Pointer returned is aligned to given alignment
+/// Returns NULL if item is too large to fit in allocator.
+CORE_API void* ___internal_stack_allocator_push_aligned_trace(
+    StackAllocator* allocator, usize size, usize alignment,
+    MemoryTag tag, const char* file, int line );
+/// Pop item from stack.
+CORE_API b32 ___internal_stack_allocator_pop_trace(
+    StackAllocator* allocator, usize size );
+/// Pop aligned item from stack.
+CORE_API b32 ___internal_stack_allocator_pop_aligned_trace(
+    StackAllocator* allocator, usize size, usize alignment );
+/// Resets current pointer and zeroes out entire buffer.
+CORE_API void ___internal_stack_allocator_clear_trace( StackAllocator* allocator );
 /// Calculate remaining space in stack allocator.
 header_only usize stack_allocator_remaining_memory( StackAllocator* allocator ) {
     return allocator->buffer_size - allocator->current;
 }
 
+/// Create a virtual memory arena.
+/// Reserves reserve_size bytes of address space without committing any of it.
+/// Commits are rounded up to commit_granularity,
+/// pass zero to commit one page at a time.
+/// Returns false if address space could not be reserved.
+CORE_API b32 virtual_arena_create(
+    usize reserve_size, usize commit_granularity, VirtualArena* out_arena );
+/// Release arena's address space.
+CORE_API void virtual_arena_destroy( VirtualArena* arena );
+/// Push item onto arena, committing pages as needed.
+/// Memory returned is zeroed unless it was used before and arena
+/// was rewound without zeroing (scratch_end does this).
+/// Returns NULL if arena is out of address space or commit failed.
+CORE_API void* virtual_arena_push( VirtualArena* arena, usize size );
+/// Push item onto arena.
+/// Pointer returned is aligned to given alignment.
+CORE_API void* virtual_arena_push_aligned(
+    VirtualArena* arena, usize size, usize alignment );
+/// Pop item from arena.
+/// Popped memory is zeroed but remains committed.
+CORE_API b32 virtual_arena_pop( VirtualArena* arena, usize size );
+/// Pop aligned item from arena.
+CORE_API b32 virtual_arena_pop_aligned(
+    VirtualArena* arena, usize size, usize alignment );
+/// Reset arena.
+/// If decommit is true, all committed pages are returned to the system,
+/// otherwise used memory is zeroed and stays committed.
+CORE_API void virtual_arena_reset( VirtualArena* arena, b32 decommit );
+/// Query arena statistics.
+CORE_API VirtualArenaStats virtual_arena_query_stats( VirtualArena* arena );
+/// Ask system to back arena with transparent huge pages.
+/// Raises commit granularity to huge page size.
+/// Call before pushing anything onto arena.
+/// Returns kind of huge pages that arena will use.
+CORE_API MemoryHugePageKind virtual_arena_request_huge_pages( VirtualArena* arena );
+/// Calculate remaining address space in virtual arena.
+header_only usize virtual_arena_remaining_memory( VirtualArena* arena ) {
+    return arena->reserved - arena->current;
+}
+
 /// Query how many bytes have been allocated from system heap.
 CORE_API usize memory_query_heap_usage(void);
 /// Query how many pages have been allocated from system.
@@ -107,6 +260,10 @@ CORE_API usize memory_query_total_usage(void);
 CORE_API usize memory_size_to_page_count( usize size );
 /// Calculate memory size of pages.
 CORE_API usize page_count_to_memory_size( usize pages );
+/// Query size of a huge page in bytes.
+CORE_API usize memory_query_huge_page_size(void);
+/// Convert huge page kind to a null-terminated string.
+CORE_API const char* memory_huge_page_kind_to_cstr( MemoryHugePageKind kind );
 
 /// Allocate memory from system allocator by pages.
 /// Only use this if you're allocating a large amount of memory.
@@ -119,11 +276,34 @@ CORE_API void  ___internal_system_page_free( void* memory, usize pages );
 /// Only use this if you're allocating a large amount of memory.
 /// This memory should only be freed with the corresponding page free function.
 CORE_API void* ___internal_system_page_alloc_trace(
-    usize pages, const char* function, const char* file, int line );
+    usize pages, MemoryTag tag,
+    const char* function, const char* file, int line );
 /// Free memory allocated with page_alloc.
 CORE_API void  ___internal_system_page_free_trace(
     void* memory, usize pages, const char* function, const char* file, int line );
 
+/// Allocate memory from system allocator by pages, backed by huge pages.
+/// Tries explicit huge pages first, falls back to transparent huge pages
+/// and finally to regular pages. Kind used is written to out_kind.
+/// Pages are rounded up to huge page size.
+/// This memory should only be freed with the corresponding huge page free function.
+CORE_API void* ___internal_system_huge_page_alloc(
+    usize pages, MemoryHugePageKind* out_kind );
+/// Free memory allocated with huge_page_alloc.
+CORE_API void  ___internal_system_huge_page_free( void* memory, usize pages );
+
+/// Allocate memory from system allocator by pages, backed by huge pages.
+/// Tries explicit huge pages first, falls back to transparent huge pages
+/// and finally to regular pages. Kind used is written to out_kind.
+/// Pages are rounded up to huge page size.
+/// This memory should only be freed with the corresponding huge page free function.
+CORE_API void* ___internal_system_huge_page_alloc_trace(
+    usize pages, MemoryHugePageKind* out_kind, MemoryTag tag,
+    const char* function, const char* file, int line );
+/// Free memory allocated with huge_page_alloc.
+CORE_API void  ___internal_system_huge_page_free_trace(
+    void* memory, usize pages, const char* function, const char* file, int line );
+
 /// Allocate memory from system allocator.
 CORE_API void* ___internal_system_alloc( usize size );
 /// Allocate aligned memory from system allocator.
@@ -138,14 +318,16 @@ CORE_API void ___internal_system_free_aligned( void* memory, usize size, usize a
 
 /// Allocate memory from system allocator.
 CORE_API void* ___internal_system_alloc_trace(
-    usize size, const char* function, const char* file, int line );
+    usize size, MemoryTag tag,
+    const char* function, const char* file, int line );
 /// Allocate aligned memory from system allocator.
 /// Must be freed with system_free_aligned!
 CORE_API void* ___internal_system_alloc_aligned_trace(
-    usize size, usize alignment, const char* function, const char* file, int line );
+    usize size, usize alignment, MemoryTag tag,
+    const char* function, const char* file, int line );
 /// Reallocate memory from system allocator.
 CORE_API void* ___internal_system_realloc_trace(
-    void* memory, usize old_size, usize new_size,
+    void* memory, usize old_size, usize new_size, MemoryTag tag,
     const char* function, const char* file, int line );
 /// Free allocated memory from system allocator.
 CORE_API void ___internal_system_free_trace(
@@ -155,43 +337,142 @@ CORE_API void ___internal_system_free_aligned_trace(
     void* memory, usize size, usize alignment,
     const char* function, const char* file, int line );
 
-#if defined(LD_LOGGING) && !defined( LD_MEMORY_NO_LOG )
-    #define system_alloc( size )\
-        ___internal_system_alloc_trace( size, __FUNCTION__, __FILE__, __LINE__ )
-    #define system_alloc_aligned( size, alignment )\
+#if ( defined(LD_LOGGING) || defined(LD_PROFILING) ) && !defined( LD_MEMORY_NO_LOG )
+    #define system_alloc_tagged( size, tag )\
+        ___internal_system_alloc_trace(\
+            size, tag, __FUNCTION__, __FILE__, __LINE__ )
+    #define system_alloc_aligned_tagged( size, alignment, tag )\
         ___internal_system_alloc_aligned_trace(\
-            size, alignment, __FUNCTION__, __FILE__, __LINE__ )
-    #define system_realloc( memory, old_size, new_size )\
+            size, alignment, tag, __FUNCTION__, __FILE__, __LINE__ )
+    #define system_realloc_tagged( memory, old_size, new_size, tag )\
         ___internal_system_realloc_trace(\
-            memory, old_size, new_size, __FUNCTION__, __FILE__, __LINE__ )
+            memory, old_size, new_size, tag, __FUNCTION__, __FILE__, __LINE__ )
     #define system_free( memory, size )\
         ___internal_system_free_trace(\
             memory, size, __FUNCTION__, __FILE__, __LINE__ )
     #define system_free_aligned( memory, size, alignment )\
         ___internal_system_free_aligned_trace(\
             memory, size, alignment, __FUNCTION__, __FILE__, __LINE__ )
-    #define system_page_alloc( pages )\
-        ___internal_system_page_alloc_trace( pages, __FUNCTION__, __FILE__, __LINE__ )
+    #define system_page_alloc_tagged( pages, tag )\
+        ___internal_system_page_alloc_trace(\
+            pages, tag, __FUNCTION__, __FILE__, __LINE__ )
     #define system_page_free( memory, pages )\
         ___internal_system_page_free_trace(\
             memory, pages, __FUNCTION__, __FILE__, __LINE__ )
+    #define system_huge_page_alloc_tagged( pages, out_kind, tag )\
+        ___internal_system_huge_page_alloc_trace(\
+            pages, out_kind, tag, __FUNCTION__, __FILE__, __LINE__ )
+    #define system_huge_page_free( memory, pages )\
+        ___internal_system_huge_page_free_trace(\
+            memory, pages, __FUNCTION__, __FILE__, __LINE__ )
+
+    #define block_allocator_alloc_tagged( allocator, size, tag )\
+        ___internal_block_allocator_alloc_trace(\
+            allocator, size, tag, __FILE__, __LINE__ )
+    #define block_allocator_alloc_aligned_tagged( allocator, size, alignment, tag )\
+        ___internal_block_allocator_alloc_aligned_trace(\
+            allocator, size, alignment, tag, __FILE__, __LINE__ )
+    #define block_allocator_realloc_tagged( allocator, memory, old_size, new_size, tag )\
+        ___internal_block_allocator_realloc_trace(\
+            allocator, memory, old_size, new_size, tag, __FILE__, __LINE__ )
+    #define block_allocator_free( allocator, memory, size )\
+        ___internal_block_allocator_free_trace( allocator, memory, size )
+    #define block_allocator_free_aligned( allocator, memory, size, alignment )\
+        ___internal_block_allocator_free_aligned_trace(\
+            allocator, memory, size, alignment )
+    #define block_allocator_clear( allocator )\
+        ___internal_block_allocator_clear_trace( allocator )
+
+    #define stack_allocator_push_tagged( allocator, size, tag )\
+        ___internal_stack_allocator_push_trace(\
+            allocator, size, tag, __FILE__, __LINE__ )
+    #define stack_allocator_push_aligned_tagged( allocator, size, alignment, tag )\
+        ___internal_stack_allocator_push_aligned_trace(\
+            allocator, size, alignment, tag, __FILE__, __LINE__ )
+    #define stack_allocator_pop( allocator, size )\
+        ___internal_stack_allocator_pop_trace( allocator, size )
+    #define stack_allocator_pop_aligned( allocator, size, alignment )\
+        ___internal_stack_allocator_pop_aligned_trace( allocator, size, alignment )
+    #define stack_allocator_clear( allocator )\
+        ___internal_stack_allocator_clear_trace( allocator )
 #else
-    #define system_alloc( size )\
+    #define system_alloc_tagged( size, tag )\
         ___internal_system_alloc( size )
-    #define system_alloc_aligned( size, alignment )\
+    #define system_alloc_aligned_tagged( size, alignment, tag )\
         ___internal_system_alloc_aligned( size, alignment )
-    #define system_realloc( memory, old_size, new_size )\
+    #define system_realloc_tagged( memory, old_size, new_size, tag )\
         ___internal_system_realloc( memory, old_size, new_size )
     #define system_free( memory, size )\
         ___internal_system_free( memory, size )
     #define system_free_aligned( memory, size, alignment )\
         ___internal_system_free_aligned( memory, size, alignment )
-    #define system_page_alloc( pages )\
+    #define system_page_alloc_tagged( pages, tag )\
         ___internal_system_page_alloc( pages )
     #define system_page_free( memory, pages )\
         ___internal_system_page_free( memory, pages )
+    #define system_huge_page_alloc_tagged( pages, out_kind, tag )\
+        ___internal_system_huge_page_alloc( pages, out_kind )
+    #define system_huge_page_free( memory, pages )\
+        ___internal_system_huge_page_free( memory, pages )
+
+    #define block_allocator_alloc_tagged( allocator, size, tag )\
+        ___internal_block_allocator_alloc( allocator, size )
+    #define block_allocator_alloc_aligned_tagged( allocator, size, alignment, tag )\
+        ___internal_block_allocator_alloc_aligned( allocator, size, alignment )
+    #define block_allocator_realloc_tagged( allocator, memory, old_size, new_size, tag )\
+        ___internal_block_allocator_realloc( allocator, memory, old_size, new_size )
+    #define block_allocator_free( allocator, memory, size )\
+        ___internal_block_allocator_free( allocator, memory, size )
+    #define block_allocator_free_aligned( allocator, memory, size, alignment )\
+        ___internal_block_allocator_free_aligned( allocator, memory, size, alignment )
+    #define block_allocator_clear( allocator )\
+        ___internal_block_allocator_clear( allocator )
+
+    #define stack_allocator_push_tagged( allocator, size, tag )\
+        ___internal_stack_allocator_push( allocator, size )
+    #define stack_allocator_push_aligned_tagged( allocator, size, alignment, tag )\
+        ___internal_stack_allocator_push_aligned( allocator, size, alignment )
+    #define stack_allocator_pop( allocator, size )\
+        ___internal_stack_allocator_pop( allocator, size )
+    #define stack_allocator_pop_aligned( allocator, size, alignment )\
+        ___internal_stack_allocator_pop_aligned( allocator, size, alignment )
+    #define stack_allocator_clear( allocator )\
+        ___internal_stack_allocator_clear( allocator )
 #endif
 
+/// Allocate memory from system allocator.
+#define system_alloc( size )\
+    system_alloc_tagged( size, MEMORY_TAG_UNKNOWN )
+/// Allocate aligned memory from system allocator.
+/// Must be freed with system_free_aligned!
+#define system_alloc_aligned( size, alignment )\
+    system_alloc_aligned_tagged( size, alignment, MEMORY_TAG_UNKNOWN )
+/// Reallocate memory from system allocator.
+#define system_realloc( memory, old_size, new_size )\
+    system_realloc_tagged( memory, old_size, new_size, MEMORY_TAG_UNKNOWN )
+/// Allocate memory from system allocator by pages.
+#define system_page_alloc( pages )\
+    system_page_alloc_tagged( pages, MEMORY_TAG_UNKNOWN )
+/// Allocate memory from system allocator by pages, backed by huge pages.
+#define system_huge_page_alloc( pages, out_kind )\
+    system_huge_page_alloc_tagged( pages, out_kind, MEMORY_TAG_UNKNOWN )
+/// Allocate memory from block allocator.
+#define block_allocator_alloc( allocator, size )\
+    block_allocator_alloc_tagged( allocator, size, MEMORY_TAG_UNKNOWN )
+/// Allocate aligned memory from block allocator.
+#define block_allocator_alloc_aligned( allocator, size, alignment )\
+    block_allocator_alloc_aligned_tagged( allocator, size, alignment, MEMORY_TAG_UNKNOWN )
+/// Reallocate memory from block allocator.
+#define block_allocator_realloc( allocator, memory, old_size, new_size )\
+    block_allocator_realloc_tagged(\
+        allocator, memory, old_size, new_size, MEMORY_TAG_UNKNOWN )
+/// Push item onto stack.
+#define stack_allocator_push( allocator, size )\
+    stack_allocator_push_tagged( allocator, size, MEMORY_TAG_UNKNOWN )
+/// Push aligned item onto stack.
+#define stack_allocator_push_aligned( allocator, size, alignment )\
+    stack_allocator_push_aligned_tagged( allocator, size, alignment, MEMORY_TAG_UNKNOWN )
+
 /// Copy from source buffer to destination buffer.
 CORE_API void memory_copy( void* restricted dst, const void* restricted src, usize size );
 /// Copy from source buffer to destination buffer.
@@ -209,6 +490,14 @@ header_only void memory_zero( void* dst, usize size ) {
 }
 /// Compare two equally sized buffers.
 CORE_API b32 memory_cmp( const void* a, const void* b, usize size );
+/// Find first occurrence of byte in buffer.
+/// Returns false if byte was not found.
+CORE_API b32 memory_find_byte(
+    const void* memory, usize size, u8 value, usize* out_index );
+/// Count occurrences of byte in buffer.
+CORE_API usize memory_count_byte( const void* memory, usize size, u8 value );
+/// Check if every byte in buffer is zero.
+CORE_API b32 memory_is_zero( const void* memory, usize size );
 
 /// Align a pointer to a given alignment.
 #define memory_align( ptr, alignment )\
@@ -0,0 +1,222 @@
+/**
+ * Description:  Bounded lock-free ring buffers implementation.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "shared/constants.h"
+#include "core/ring.h"
+#include "core/atomic.h"
+#include "core/memory.h"
+
+// NOTE(alicia): positions are free running counters,
+// they are only masked when indexing into items so
+// full and empty rings can be told apart without a spare slot.
+
+/// Counter only written by one side of a ring.
+/// Each counter lives on its own cache line so
+/// producers and consumers don't invalidate each other's lines.
+typedef union RingCounter {
+    struct {
+        volatile u32 position;
+        /// Last position of other side that was observed.
+        u32 cached;
+    };
+    u8 ___padding[CACHE_LINE_SIZE];
+} RingCounter;
+
+struct RingSPSC {
+    RingCounter head;
+    RingCounter tail;
+    union {
+        struct {
+            u8*   items;
+            usize item_size;
+            u32   mask;
+        };
+        u8 ___padding[CACHE_LINE_SIZE];
+    };
+};
+static_assert(
+    sizeof(RingSPSC) % CACHE_LINE_SIZE == 0,
+    "RingSPSC must be a multiple of cache line size!" );
+
+internal force_inline b32 ___ring_is_power_of_two( usize capacity ) {
+    return capacity && ( ( capacity & ( capacity - 1 ) ) == 0 );
+}
+
+CORE_API usize ring_spsc_memory_requirement( usize capacity, usize item_size ) {
+    // NOTE(alicia): extra cache line for aligning buffer.
+    return sizeof(RingSPSC) + ( capacity * item_size ) + CACHE_LINE_SIZE;
+}
+CORE_API RingSPSC* ring_spsc_create( usize capacity, usize item_size, void* buffer ) {
+    assert( ___ring_is_power_of_two( capacity ) );
+    assert( capacity <= U32_MAX / 2 );
+
+    RingSPSC* result = memory_align( buffer, CACHE_LINE_SIZE );
+    memory_zero( result, sizeof(RingSPSC) );
+    result->items     = (u8*)( result + 1 );
+    result->item_size = item_size;
+    result->mask      = (u32)capacity - 1;
+    return result;
+}
+CORE_API b32 ring_spsc_push( RingSPSC* ring, const void* item ) {
+    u32 head = ring->head.position;
+    // NOTE(alicia): tail is only reloaded when ring looks full,
+    // that way producer rarely touches consumer's cache line.
+    if( head - ring->head.cached > ring->mask ) {
+        ring->head.cached =
+            atomic_load_u32( &ring->tail.position, MEMORY_ORDER_ACQUIRE );
+        if( head - ring->head.cached > ring->mask ) {
+            return false;
+        }
+    }
+
+    memory_copy(
+        ring->items + ( (usize)( head & ring->mask ) * ring->item_size ),
+        item, ring->item_size );
+    atomic_store_u32( &ring->head.position, head + 1, MEMORY_ORDER_RELEASE );
+    return true;
+}
+CORE_API b32 ring_spsc_pop( RingSPSC* ring, void* out_item ) {
+    u32 tail = ring->tail.position;
+    if( tail == ring->tail.cached ) {
+        ring->tail.cached =
+            atomic_load_u32( &ring->head.position, MEMORY_ORDER_ACQUIRE );
+        if( tail == ring->tail.cached ) {
+            return false;
+        }
+    }
+
+    memory_copy(
+        out_item,
+        ring->items + ( (usize)( tail & ring->mask ) * ring->item_size ),
+        ring->item_size );
+    atomic_store_u32( &ring->tail.position, tail + 1, MEMORY_ORDER_RELEASE );
+    return true;
+}
+CORE_API usize ring_spsc_count( RingSPSC* ring ) {
+    u32 tail = atomic_load_u32( &ring->tail.position, MEMORY_ORDER_ACQUIRE );
+    u32 head = atomic_load_u32( &ring->head.position, MEMORY_ORDER_ACQUIRE );
+    return head - tail;
+}
+
+/// MPMC cell header.
+/// Sequence tells pushers and poppers which lap of the ring
+/// the cell is ready for, item is stored right after it.
+typedef struct RingCell {
+    volatile u32 sequence;
+    u32 ___padding;
+} RingCell;
+
+struct RingMPMC {
+    RingCounter enqueue;
+    RingCounter dequeue;
+    union {
+        struct {
+            u8*   cells;
+            usize cell_size;
+            usize item_size;
+            u32   mask;
+        };
+        u8 ___padding[CACHE_LINE_SIZE];
+    };
+};
+static_assert(
+    sizeof(RingMPMC) % CACHE_LINE_SIZE == 0,
+    "RingMPMC must be a multiple of cache line size!" );
+
+internal force_inline usize ___ring_mpmc_cell_size( usize item_size ) {
+    // NOTE(alicia): keep cell headers aligned regardless of item size.
+    return ( sizeof(RingCell) + item_size + 7 ) & ~(usize)7;
+}
+internal force_inline RingCell* ___ring_mpmc_cell( RingMPMC* ring, u32 position ) {
+    return (RingCell*)(
+        ring->cells + ( (usize)( position & ring->mask ) * ring->cell_size ) );
+}
+
+CORE_API usize ring_mpmc_memory_requirement( usize capacity, usize item_size ) {
+    // NOTE(alicia): extra cache line for aligning buffer.
+    return
+        sizeof(RingMPMC) +
+        ( capacity * ___ring_mpmc_cell_size( item_size ) ) +
+        CACHE_LINE_SIZE;
+}
+CORE_API RingMPMC* ring_mpmc_create( usize capacity, usize item_size, void* buffer ) {
+    assert( ___ring_is_power_of_two( capacity ) );
+    assert( capacity <= U32_MAX / 2 );
+
+    RingMPMC* result = memory_align( buffer, CACHE_LINE_SIZE );
+    memory_zero( result, sizeof(RingMPMC) );
+    result->cells     = (u8*)( result + 1 );
+    result->cell_size = ___ring_mpmc_cell_size( item_size );
+    result->item_size = item_size;
+    result->mask      = (u32)capacity - 1;
+
+    for( u32 i = 0; i < (u32)capacity; ++i ) {
+        ___ring_mpmc_cell( result, i )->sequence = i;
+    }
+    return result;
+}
+CORE_API b32 ring_mpmc_push( RingMPMC* ring, const void* item ) {
+    RingCell* cell = NULL;
+    u32 position   = atomic_load_u32( &ring->enqueue.position, MEMORY_ORDER_RELAXED );
+    loop {
+        cell = ___ring_mpmc_cell( ring, position );
+        u32 sequence = atomic_load_u32( &cell->sequence, MEMORY_ORDER_ACQUIRE );
+        i32 diff     = (i32)( sequence - position );
+
+        if( diff == 0 ) {
+            if( atomic_compare_exchange_weak_u32(
+                &ring->enqueue.position, &position, position + 1,
+                MEMORY_ORDER_RELAXED, MEMORY_ORDER_RELAXED
+            ) ) {
+                break;
+            }
+        } else if( diff < 0 ) {
+            // NOTE(alicia): cell still holds an item from previous lap.
+            return false;
+        } else {
+            position = atomic_load_u32( &ring->enqueue.position, MEMORY_ORDER_RELAXED );
+        }
+    }
+
+    memory_copy( cell + 1, item, ring->item_size );
+    atomic_store_u32( &cell->sequence, position + 1, MEMORY_ORDER_RELEASE );
+    return true;
+}
+CORE_API b32 ring_mpmc_pop( RingMPMC* ring, void* out_item ) {
+    RingCell* cell = NULL;
+    u32 position   = atomic_load_u32( &ring->dequeue.position, MEMORY_ORDER_RELAXED );
+    loop {
+        cell = ___ring_mpmc_cell( ring, position );
+        u32 sequence = atomic_load_u32( &cell->sequence, MEMORY_ORDER_ACQUIRE );
+        i32 diff     = (i32)( sequence - ( position + 1 ) );
+
+        if( diff == 0 ) {
+            if( atomic_compare_exchange_weak_u32(
+                &ring->dequeue.position, &position, position + 1,
+                MEMORY_ORDER_RELAXED, MEMORY_ORDER_RELAXED
+            ) ) {
+                break;
+            }
+        } else if( diff < 0 ) {
+            // NOTE(alicia): cell has not been written this lap.
+            return false;
+        } else {
+            position = atomic_load_u32( &ring->dequeue.position, MEMORY_ORDER_RELAXED );
+        }
+    }
+
+    memory_copy( out_item, cell + 1, ring->item_size );
+    atomic_store_u32(
+        &cell->sequence, position + ring->mask + 1, MEMORY_ORDER_RELEASE );
+    return true;
+}
+CORE_API usize ring_mpmc_count( RingMPMC* ring ) {
+    u32 dequeue = atomic_load_u32( &ring->dequeue.position, MEMORY_ORDER_ACQUIRE );
+    u32 enqueue = atomic_load_u32( &ring->enqueue.position, MEMORY_ORDER_ACQUIRE );
+    i32 diff    = (i32)( enqueue - dequeue );
+    return diff > 0 ? (usize)diff : 0;
+}
+
@@ -0,0 +1,61 @@
+#if !defined(LD_CORE_RING_H)
+#define LD_CORE_RING_H
+/**
+ * Description:  Bounded lock-free ring buffers.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+ * Notes:        Items are copied in and out of rings,
+ *               capacity must always be a power of two.
+*/
+#include "shared/defines.h"
+
+/// Single producer, single consumer ring buffer.
+/// Only one thread may push and only one thread may pop at a time.
+typedef struct RingSPSC RingSPSC;
+/// Multiple producer, multiple consumer ring buffer.
+/// Any number of threads may push and pop concurrently.
+typedef struct RingMPMC RingMPMC;
+
+/// Calculate memory requirement of a single producer, single consumer ring.
+/// Capacity must be a power of two.
+CORE_API usize ring_spsc_memory_requirement( usize capacity, usize item_size );
+/// Create a single producer, single consumer ring.
+/// Capacity must be a power of two.
+/// Buffer must be able to hold result from ring_spsc_memory_requirement.
+CORE_API RingSPSC* ring_spsc_create( usize capacity, usize item_size, void* buffer );
+/// Push an item into ring.
+/// Item is copied into ring.
+/// Must only be called from producer thread.
+/// Returns false if ring is full.
+CORE_API b32 ring_spsc_push( RingSPSC* ring, const void* item );
+/// Pop an item from ring.
+/// Item is copied to out_item.
+/// Must only be called from consumer thread.
+/// Returns false if ring is empty.
+CORE_API b32 ring_spsc_pop( RingSPSC* ring, void* out_item );
+/// Query number of items in ring.
+/// Result is only a snapshot if called while other threads
+/// are pushing or popping.
+CORE_API usize ring_spsc_count( RingSPSC* ring );
+
+/// Calculate memory requirement of a multiple producer, multiple consumer ring.
+/// Capacity must be a power of two.
+CORE_API usize ring_mpmc_memory_requirement( usize capacity, usize item_size );
+/// Create a multiple producer, multiple consumer ring.
+/// Capacity must be a power of two.
+/// Buffer must be able to hold result from ring_mpmc_memory_requirement.
+CORE_API RingMPMC* ring_mpmc_create( usize capacity, usize item_size, void* buffer );
+/// Push an item into ring.
+/// Item is copied into ring.
+/// Returns false if ring is full.
+CORE_API b32 ring_mpmc_push( RingMPMC* ring, const void* item );
+/// Pop an item from ring.
+/// Item is copied to out_item.
+/// Returns false if ring is empty.
+CORE_API b32 ring_mpmc_pop( RingMPMC* ring, void* out_item );
+/// Query number of items in ring.
+/// Result is only a snapshot if called while other threads
+/// are pushing or popping.
+CORE_API usize ring_mpmc_count( RingMPMC* ring );
+
+#endif /* header guard */
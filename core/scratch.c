@@ -0,0 +1,108 @@
+/**
+ * Description:  Per-thread scratch arenas implementation.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+*/
+#include "shared/defines.h"
+#include "shared/constants.h"
+#include "core/scratch.h"
+#include "core/memory.h"
+#include "core/internal/logging.h"
+
+/// Scratch arena, padded so that threads never share a cache line.
+typedef union ScratchThread {
+    VirtualArena arena;
+    u8 ___padding[CACHE_LINE_SIZE];
+} ScratchThread;
+static_assert(
+    sizeof(VirtualArena) <= CACHE_LINE_SIZE,
+    "VirtualArena must fit in a cache line!" );
+
+global ScratchThread* global_scratch_threads      = NULL;
+global usize          global_scratch_thread_count = 0;
+
+CORE_API usize scratch_query_memory_requirement( usize thread_count ) {
+    // NOTE(alicia): extra cache line for aligning buffer.
+    return ( sizeof(ScratchThread) * thread_count ) + CACHE_LINE_SIZE;
+}
+CORE_API b32 scratch_initialize(
+    usize thread_count, usize reserve_size, b32 huge_pages, void* buffer
+) {
+    ScratchThread* threads = memory_align( buffer, CACHE_LINE_SIZE );
+
+    MemoryHugePageKind huge_page_kind = MEMORY_HUGE_PAGE_NONE;
+    for( usize i = 0; i < thread_count; ++i ) {
+        if( !virtual_arena_create( reserve_size, 0, &threads[i].arena ) ) {
+            core_log_error(
+                "Failed to create scratch arena for thread {usize}!", i );
+            for( usize j = 0; j < i; ++j ) {
+                virtual_arena_destroy( &threads[j].arena );
+            }
+            return false;
+        }
+        if( huge_pages ) {
+            huge_page_kind =
+                virtual_arena_request_huge_pages( &threads[i].arena );
+        }
+    }
+
+    global_scratch_threads      = threads;
+    global_scratch_thread_count = thread_count;
+
+    core_log_note(
+        "Created {usize} scratch arenas, {f,m,.2} reserved each. Huge pages: {cc}",
+        thread_count, (f64)reserve_size,
+        memory_huge_page_kind_to_cstr( huge_page_kind ) );
+    return true;
+}
+CORE_API void scratch_shutdown(void) {
+    for( usize i = 0; i < global_scratch_thread_count; ++i ) {
+        virtual_arena_destroy( &global_scratch_threads[i].arena );
+    }
+    global_scratch_threads      = NULL;
+    global_scratch_thread_count = 0;
+}
+
+CORE_API Scratch scratch_begin( usize thread_index ) {
+    assert( thread_index < global_scratch_thread_count );
+
+    Scratch result = {};
+    result.arena      = &global_scratch_threads[thread_index].arena;
+    result.checkpoint = result.arena->current;
+    return result;
+}
+CORE_API void scratch_end( Scratch* scratch ) {
+    // NOTE(alicia): rewind without zeroing, this is why
+    // scratch memory is never guaranteed to be zeroed.
+    assert( scratch->checkpoint <= scratch->arena->current );
+    scratch->arena->current = scratch->checkpoint;
+}
+CORE_API void* scratch_push( Scratch* scratch, usize size ) {
+    return virtual_arena_push( scratch->arena, size );
+}
+CORE_API void* scratch_push_aligned(
+    Scratch* scratch, usize size, usize alignment
+) {
+    VirtualArena* arena = scratch->arena;
+
+    u8* current = (u8*)arena->buffer + arena->current;
+    u8* aligned = memory_align( current, alignment );
+
+    u8* result = virtual_arena_push( arena, ( aligned - current ) + size );
+    if( !result ) {
+        return NULL;
+    }
+    return aligned;
+}
+
+CORE_API usize scratch_query_usage( usize thread_index ) {
+    assert( thread_index < global_scratch_thread_count );
+    return global_scratch_threads[thread_index].arena.current;
+}
+CORE_API usize scratch_query_peak_usage( usize thread_index ) {
+    assert( thread_index < global_scratch_thread_count );
+    return global_scratch_threads[thread_index].arena.high_water_mark;
+}
+CORE_API usize scratch_query_thread_count(void) {
+    return global_scratch_thread_count;
+}
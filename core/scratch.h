@@ -0,0 +1,56 @@
+#if !defined(LD_CORE_SCRATCH_H)
+#define LD_CORE_SCRATCH_H
+/**
+ * Description:  Per-thread scratch arenas.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+ * Notes:        Each thread owns one arena, indexed by the same
+ *               thread_index that job procs receive (0 is main thread).
+*/
+#include "shared/defines.h"
+
+struct VirtualArena;
+
+/// Scratch checkpoint.
+/// Everything pushed after scratch_begin is released by scratch_end.
+typedef struct Scratch {
+    struct VirtualArena* arena;
+    usize checkpoint;
+} Scratch;
+
+/// Query memory requirement for scratch arenas.
+/// Thread count must include the main thread.
+CORE_API usize scratch_query_memory_requirement( usize thread_count );
+/// Initialize scratch arenas.
+/// Each thread reserves reserve_size bytes of address space,
+/// pages are only committed when they're used.
+/// If huge_pages is true, arenas ask to be backed by transparent huge pages.
+/// Buffer must be able to hold result from scratch_query_memory_requirement.
+/// Returns false if address space could not be reserved.
+CORE_API b32 scratch_initialize(
+    usize thread_count, usize reserve_size, b32 huge_pages, void* buffer );
+/// Release scratch arenas.
+CORE_API void scratch_shutdown(void);
+
+/// Begin scratch allocations for given thread.
+CORE_API Scratch scratch_begin( usize thread_index );
+/// Rewind thread's arena back to checkpoint.
+/// Rewound memory is not zeroed, later pushes get it back dirty.
+CORE_API void scratch_end( Scratch* scratch );
+/// Push memory onto scratch arena.
+/// Memory is not zeroed.
+/// Returns NULL if thread's arena is out of memory.
+CORE_API void* scratch_push( Scratch* scratch, usize size );
+/// Push aligned memory onto scratch arena.
+/// Memory is not zeroed.
+CORE_API void* scratch_push_aligned(
+    Scratch* scratch, usize size, usize alignment );
+
+/// Query how many bytes thread is currently using.
+CORE_API usize scratch_query_usage( usize thread_index );
+/// Query largest number of bytes thread has ever used.
+CORE_API usize scratch_query_peak_usage( usize thread_index );
+/// Query number of scratch arenas.
+CORE_API usize scratch_query_thread_count(void);
+
+#endif /* header guard */
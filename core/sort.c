@@ -4,96 +4,697 @@
  * File Created: October 20, 2023
 */
 #include "shared/defines.h"
+#include "shared/constants.h"
 #include "core/sort.h"
 #include "core/memory.h"
+#include "core/jobs.h"
+#include "core/sync.h"
 
-internal isize sorting_quicksort_partition(
-    isize low, isize high, usize element_size, void* buffer,
-    SortLTFN* lt, void* opt_lt_params, SortSwapFN* swap_
+// NOTE(alicia): pattern-defeating quicksort.
+// Based on pdqsort by Orson Peters, adapted to work through
+// less than and swap callbacks instead of moving elements.
+// Pivot stays at beginning of range while partitioning and
+// is swapped into place afterwards.
+
+/// Ranges smaller than this are insertion sorted.
+#define SORT_INSERTION_THRESHOLD (24)
+/// Ranges larger than this use pseudomedian of 9 for pivot.
+#define SORT_NINTHER_THRESHOLD (128)
+/// Maximum number of elements partial insertion sort
+/// can move before it gives up.
+#define SORT_PARTIAL_INSERTION_LIMIT (8)
+/// Number of elements classified at once by block partitioning.
+#define SORT_BLOCK_SIZE (64)
+
+typedef struct SortContext {
+    u8*         buffer;
+    usize       element_size;
+    /// If NULL, elements are compared as u32.
+    SortLTFN*   lt;
+    void*       lt_params;
+    /// If NULL, elements are swapped with ___sort_memswap.
+    SortSwapFN* swap_;
+} SortContext;
+
+internal force_inline void ___sort_memswap( void* lhs, void* rhs, usize size ) {
+    u8* a = lhs;
+    u8* b = rhs;
+    switch( size ) {
+        case sizeof(u32): {
+            u32 temp = *(u32*)a;
+            *(u32*)a = *(u32*)b;
+            *(u32*)b = temp;
+        } return;
+        case sizeof(u64): {
+            u64 temp = *(u64*)a;
+            *(u64*)a = *(u64*)b;
+            *(u64*)b = temp;
+        } return;
+        default: break;
+    }
+
+    while( size >= sizeof(u64) ) {
+        u64 x, y;
+        __builtin_memcpy( &x, a, sizeof(u64) );
+        __builtin_memcpy( &y, b, sizeof(u64) );
+        __builtin_memcpy( a, &y, sizeof(u64) );
+        __builtin_memcpy( b, &x, sizeof(u64) );
+        a    += sizeof(u64);
+        b    += sizeof(u64);
+        size -= sizeof(u64);
+    }
+    while( size-- ) {
+        u8 temp = *a;
+        *a++ = *b;
+        *b++ = temp;
+    }
+}
+internal force_inline void* ___sort_at( SortContext* ctx, usize index ) {
+    return ctx->buffer + ( index * ctx->element_size );
+}
+internal force_inline b32 ___sort_lt( SortContext* ctx, usize lhs, usize rhs ) {
+    void* a = ___sort_at( ctx, lhs );
+    void* b = ___sort_at( ctx, rhs );
+    if( !ctx->lt ) {
+        return *(u32*)a < *(u32*)b;
+    }
+    return ctx->lt( a, b, ctx->lt_params );
+}
+internal force_inline void ___sort_swap( SortContext* ctx, usize lhs, usize rhs ) {
+    void* a = ___sort_at( ctx, lhs );
+    void* b = ___sort_at( ctx, rhs );
+    if( ctx->swap_ ) {
+        ctx->swap_( a, b );
+    } else {
+        ___sort_memswap( a, b, ctx->element_size );
+    }
+}
+internal force_inline void ___sort2( SortContext* ctx, usize a, usize b ) {
+    if( ___sort_lt( ctx, b, a ) ) {
+        ___sort_swap( ctx, a, b );
+    }
+}
+internal force_inline void ___sort3( SortContext* ctx, usize a, usize b, usize c ) {
+    ___sort2( ctx, a, b );
+    ___sort2( ctx, b, c );
+    ___sort2( ctx, a, b );
+}
+
+/// Insertion sort [begin, end).
+/// If unguarded, element before begin must not be greater
+/// than any element in range.
+internal void ___sort_insertion(
+    SortContext* ctx, usize begin, usize end, b32 unguarded
+) {
+    for( usize i = begin + 1; i < end; ++i ) {
+        usize j = i;
+        while( ( unguarded || j > begin ) && ___sort_lt( ctx, j, j - 1 ) ) {
+            ___sort_swap( ctx, j, j - 1 );
+            j--;
+        }
+    }
+}
+/// Insertion sort [begin, end) but give up
+/// if too many elements have to be moved.
+/// Returns true if range was sorted.
+internal b32 ___sort_partial_insertion( SortContext* ctx, usize begin, usize end ) {
+    usize moved = 0;
+    for( usize i = begin + 1; i < end; ++i ) {
+        usize j = i;
+        while( j > begin && ___sort_lt( ctx, j, j - 1 ) ) {
+            ___sort_swap( ctx, j, j - 1 );
+            j--;
+        }
+        moved += i - j;
+        if( moved > SORT_PARTIAL_INSERTION_LIMIT ) {
+            return false;
+        }
+    }
+    return true;
+}
+internal void ___sort_heap_sift_down(
+    SortContext* ctx, usize begin, usize count, usize root
+) {
+    loop {
+        usize child = ( root * 2 ) + 1;
+        if( child >= count ) {
+            break;
+        }
+        if(
+            child + 1 < count &&
+            ___sort_lt( ctx, begin + child, begin + child + 1 )
+        ) {
+            child++;
+        }
+        if( !___sort_lt( ctx, begin + root, begin + child ) ) {
+            break;
+        }
+        ___sort_swap( ctx, begin + root, begin + child );
+        root = child;
+    }
+}
+/// Heapsort [begin, end).
+internal void ___sort_heap( SortContext* ctx, usize begin, usize end ) {
+    usize count = end - begin;
+    for( usize i = count / 2; i-- > 0; ) {
+        ___sort_heap_sift_down( ctx, begin, count, i );
+    }
+    while( count > 1 ) {
+        count--;
+        ___sort_swap( ctx, begin, begin + count );
+        ___sort_heap_sift_down( ctx, begin, count, 0 );
+    }
+}
+/// Partition [begin, end) around pivot at begin.
+/// Elements equal to pivot go to the left partition.
+/// Returns final position of pivot.
+internal usize ___sort_partition_left( SortContext* ctx, usize begin, usize end ) {
+    usize first = begin;
+    usize last  = end;
+
+    while( ___sort_lt( ctx, begin, --last ) ) {}
+    if( last + 1 == end ) {
+        while( first < last && !___sort_lt( ctx, begin, ++first ) ) {}
+    } else {
+        while( !___sort_lt( ctx, begin, ++first ) ) {}
+    }
+
+    while( first < last ) {
+        ___sort_swap( ctx, first, last );
+        while( ___sort_lt( ctx, begin, --last ) ) {}
+        while( !___sort_lt( ctx, begin, ++first ) ) {}
+    }
+
+    ___sort_swap( ctx, begin, last );
+    return last;
+}
+/// Partition [begin, end) around pivot at begin.
+/// Elements equal to pivot go to the right partition.
+/// Elements on the wrong side are found a block at a time
+/// without branching on comparison results, then swapped in pairs.
+/// Returns final position of pivot.
+internal usize ___sort_partition_right(
+    SortContext* ctx, usize begin, usize end, b32* out_already_partitioned
 ) {
-    u8* buf = buffer;
-    void* pivot = buf + (high * element_size);
+    usize first = begin;
+    usize last  = end;
+
+    // NOTE(alicia): median of 3 guarantees that an element
+    // greater than or equal to pivot exists.
+    while( ___sort_lt( ctx, ++first, begin ) ) {}
+    if( first - 1 == begin ) {
+        while( first < last && !___sort_lt( ctx, --last, begin ) ) {}
+    } else {
+        while( !___sort_lt( ctx, --last, begin ) ) {}
+    }
+
+    b32 already_partitioned = first >= last;
+    if( !already_partitioned ) {
+        ___sort_swap( ctx, first, last );
+        first++;
+
+        u8 offsets_l[SORT_BLOCK_SIZE];
+        u8 offsets_r[SORT_BLOCK_SIZE];
+
+        usize base_l  = first;
+        usize base_r  = last;
+        usize num_l   = 0;
+        usize num_r   = 0;
+        usize start_l = 0;
+        usize start_r = 0;
+
+        while( first < last ) {
+            usize num_unknown = last - first;
+            usize left_split  =
+                num_l == 0 ? ( num_r == 0 ? num_unknown / 2 : num_unknown ) : 0;
+            usize right_split = num_r == 0 ? ( num_unknown - left_split ) : 0;
+
+            if( left_split > SORT_BLOCK_SIZE ) {
+                left_split = SORT_BLOCK_SIZE;
+            }
+            for( usize i = 0; i < left_split; ++i ) {
+                offsets_l[num_l] = (u8)i;
+                num_l += !___sort_lt( ctx, first, begin );
+                first++;
+            }
 
-    isize i = (isize)low - 1;
+            if( right_split > SORT_BLOCK_SIZE ) {
+                right_split = SORT_BLOCK_SIZE;
+            }
+            for( usize i = 0; i < right_split; ++i ) {
+                offsets_r[num_r] = (u8)( i + 1 );
+                num_r += ___sort_lt( ctx, --last, begin );
+            }
 
-    for( isize j = (isize)low; j <= (isize)high - 1; ++j ) {
-        void* at_j = buf + (j * element_size);
+            usize num = num_l < num_r ? num_l : num_r;
+            for( usize i = 0; i < num; ++i ) {
+                ___sort_swap(
+                    ctx,
+                    base_l + offsets_l[start_l + i],
+                    base_r - offsets_r[start_r + i] );
+            }
+            num_l   -= num;
+            num_r   -= num;
+            start_l += num;
+            start_r += num;
 
-        if( lt( at_j, pivot, opt_lt_params ) ) {
-            ++i;
-            void* at_i = buf + (i * element_size);
-            swap_( at_i, at_j );
+            if( num_l == 0 ) {
+                start_l = 0;
+                base_l  = first;
+            }
+            if( num_r == 0 ) {
+                start_r = 0;
+                base_r  = last;
+            }
+        }
+
+        // NOTE(alicia): one side has leftover elements
+        // that are on the wrong side, move them to the boundary.
+        if( num_l ) {
+            while( num_l-- ) {
+                ___sort_swap( ctx, base_l + offsets_l[start_l + num_l], --last );
+            }
+            first = last;
+        }
+        if( num_r ) {
+            while( num_r-- ) {
+                ___sort_swap( ctx, base_r - offsets_r[start_r + num_r], first );
+                first++;
+            }
+            last = first;
         }
     }
 
-    swap_( buf + ((i + 1) * element_size), buf + (high * element_size) );
-    return i + 1;
+    usize pivot = first - 1;
+    ___sort_swap( ctx, begin, pivot );
+    *out_already_partitioned = already_partitioned;
+    return pivot;
+}
+internal void ___sort_pdq(
+    SortContext* ctx, usize begin, usize end, usize bad_allowed, b32 leftmost
+) {
+    loop {
+        usize size = end - begin;
+        if( size < SORT_INSERTION_THRESHOLD ) {
+            ___sort_insertion( ctx, begin, end, !leftmost );
+            return;
+        }
+
+        usize half = size / 2;
+        if( size > SORT_NINTHER_THRESHOLD ) {
+            ___sort3( ctx, begin,            begin + half,       end - 1 );
+            ___sort3( ctx, begin + 1,        begin + half - 1,   end - 2 );
+            ___sort3( ctx, begin + 2,        begin + half + 1,   end - 3 );
+            ___sort3( ctx, begin + half - 1, begin + half,       begin + half + 1 );
+            ___sort_swap( ctx, begin, begin + half );
+        } else {
+            ___sort3( ctx, begin + half, begin, end - 1 );
+        }
+
+        // NOTE(alicia): element before begin is the pivot of a previous
+        // partition so nothing in range is smaller than it.
+        // If it's equal to this pivot, range has lots of equal elements,
+        // those all go to the left partition which is then already sorted.
+        if( !leftmost && !___sort_lt( ctx, begin - 1, begin ) ) {
+            begin = ___sort_partition_left( ctx, begin, end ) + 1;
+            continue;
+        }
+
+        b32 already_partitioned = false;
+        usize pivot = ___sort_partition_right( ctx, begin, end, &already_partitioned );
+
+        usize size_l = pivot - begin;
+        usize size_r = end - ( pivot + 1 );
+        b32 highly_unbalanced = size_l < size / 8 || size_r < size / 8;
+
+        if( highly_unbalanced ) {
+            // NOTE(alicia): too many bad partitions,
+            // fall back to heapsort to guarantee O(n log n).
+            if( --bad_allowed == 0 ) {
+                ___sort_heap( ctx, begin, end );
+                return;
+            }
+
+            // NOTE(alicia): shuffle some elements around to break patterns.
+            if( size_l >= SORT_INSERTION_THRESHOLD ) {
+                ___sort_swap( ctx, begin,     begin + size_l / 4 );
+                ___sort_swap( ctx, pivot - 1, pivot - size_l / 4 );
+                if( size_l > SORT_NINTHER_THRESHOLD ) {
+                    ___sort_swap( ctx, begin + 1, begin + ( size_l / 4 + 1 ) );
+                    ___sort_swap( ctx, begin + 2, begin + ( size_l / 4 + 2 ) );
+                    ___sort_swap( ctx, pivot - 2, pivot - ( size_l / 4 + 1 ) );
+                    ___sort_swap( ctx, pivot - 3, pivot - ( size_l / 4 + 2 ) );
+                }
+            }
+            if( size_r >= SORT_INSERTION_THRESHOLD ) {
+                ___sort_swap( ctx, pivot + 1, pivot + ( 1 + size_r / 4 ) );
+                ___sort_swap( ctx, end - 1,   end - size_r / 4 );
+                if( size_r > SORT_NINTHER_THRESHOLD ) {
+                    ___sort_swap( ctx, pivot + 2, pivot + ( 2 + size_r / 4 ) );
+                    ___sort_swap( ctx, pivot + 3, pivot + ( 3 + size_r / 4 ) );
+                    ___sort_swap( ctx, end - 2,   end - ( 1 + size_r / 4 ) );
+                    ___sort_swap( ctx, end - 3,   end - ( 2 + size_r / 4 ) );
+                }
+            }
+        } else if(
+            already_partitioned &&
+            ___sort_partial_insertion( ctx, begin, pivot ) &&
+            ___sort_partial_insertion( ctx, pivot + 1, end )
+        ) {
+            // NOTE(alicia): range was already partitioned which usually
+            // means it's (mostly) sorted, insertion sort finished it.
+            return;
+        }
+
+        ___sort_pdq( ctx, begin, pivot, bad_allowed, leftmost );
+        begin    = pivot + 1;
+        leftmost = false;
+    }
+}
+internal void ___sort_run( SortContext* ctx, isize from_inclusive, isize to_inclusive ) {
+    if( from_inclusive >= to_inclusive ) {
+        return;
+    }
+    usize begin = (usize)from_inclusive;
+    usize end   = (usize)to_inclusive + 1;
+
+    usize bad_allowed = 64 - __builtin_clzll( (u64)( end - begin ) );
+    ___sort_pdq( ctx, begin, end, bad_allowed, true );
 }
 
 CORE_API void sorting_quicksort(
-    isize       low,
-    isize       high,
+    isize       from_inclusive,
+    isize       to_inclusive,
     usize       element_size,
     void*       buffer,
     SortLTFN*   lt,
     void*       opt_lt_params,
-    SortSwapFN* swap_
+    SortSwapFN* opt_swap
 ) {
-    while( low < high ) {
-        isize partition_index = sorting_quicksort_partition(
-            low, high, element_size,
-            buffer, lt, opt_lt_params, swap_ );
-        if( partition_index - low < high - partition_index ) {
-            sorting_quicksort(
-                low, partition_index - 1, element_size,
-                buffer, lt, opt_lt_params, swap_ );
-            low = partition_index + 1;
-        } else {
-            sorting_quicksort(
-                partition_index + 1, high, element_size,
-                buffer, lt, opt_lt_params, swap_ );
-            high = partition_index - 1;
+    assert( lt );
+    SortContext ctx  = {};
+    ctx.buffer       = buffer;
+    ctx.element_size = element_size;
+    ctx.lt           = lt;
+    ctx.lt_params    = opt_lt_params;
+    ctx.swap_        = opt_swap;
+    ___sort_run( &ctx, from_inclusive, to_inclusive );
+}
+CORE_API void sorting_quicksort_u32(
+    isize from_inclusive, isize to_inclusive, u32* buffer
+) {
+    SortContext ctx  = {};
+    ctx.buffer       = (u8*)buffer;
+    ctx.element_size = sizeof(u32);
+    ___sort_run( &ctx, from_inclusive, to_inclusive );
+}
+
+/// Ranges smaller than this are sorted on a single thread.
+#define SORT_PARALLEL_SERIAL_THRESHOLD (16384)
+/// Maximum number of ranges handed out to job system per sort.
+#define SORT_PARALLEL_MAX_TASKS (128)
+
+struct SortParallelState;
+typedef struct SortParallelTask {
+    struct SortParallelState* state;
+    usize begin;
+    usize end;
+    b32   leftmost;
+} SortParallelTask;
+typedef struct SortParallelState {
+    SortContext      ctx;
+    JobCounter       counter;
+    volatile u32     task_count;
+    SortParallelTask tasks[SORT_PARALLEL_MAX_TASKS];
+} SortParallelState;
+
+internal void ___sort_parallel_job( usize thread_index, void* params );
+
+internal void ___sort_parallel_range(
+    SortParallelState* state, usize thread_index,
+    usize begin, usize end, b32 leftmost
+) {
+    SortContext* ctx = &state->ctx;
+
+    // NOTE(alicia): each range is partitioned once, left side is handed
+    // to job system and right side is partitioned again on this thread,
+    // until ranges are small enough to sort serially.
+    while( end - begin >= SORT_PARALLEL_SERIAL_THRESHOLD ) {
+        usize size = end - begin;
+        usize half = size / 2;
+        ___sort3( ctx, begin,            begin + half,     end - 1 );
+        ___sort3( ctx, begin + 1,        begin + half - 1, end - 2 );
+        ___sort3( ctx, begin + 2,        begin + half + 1, end - 3 );
+        ___sort3( ctx, begin + half - 1, begin + half,     begin + half + 1 );
+        ___sort_swap( ctx, begin, begin + half );
+
+        if( !leftmost && !___sort_lt( ctx, begin - 1, begin ) ) {
+            begin = ___sort_partition_left( ctx, begin, end ) + 1;
+            continue;
+        }
+
+        b32 already_partitioned = false;
+        usize pivot = ___sort_partition_right( ctx, begin, end, &already_partitioned );
+
+        // NOTE(alicia): bad partitions are left to pdqsort,
+        // it knows how to break patterns.
+        if( pivot - begin < size / 8 || end - ( pivot + 1 ) < size / 8 ) {
+            break;
+        }
+
+        u32 task_index = interlocked_increment( &state->task_count );
+        b32 pushed     = false;
+        if( task_index < SORT_PARALLEL_MAX_TASKS ) {
+            SortParallelTask* task = state->tasks + task_index;
+            task->state    = state;
+            task->begin    = begin;
+            task->end      = pivot;
+            task->leftmost = leftmost;
+
+            // NOTE(alicia): jobs push onto their own thread's queue,
+            // idle threads steal from there.
+            pushed = job_system_push_counter(
+                thread_index, ___sort_parallel_job, task, &state->counter );
+        }
+        if( !pushed ) {
+            ___sort_parallel_range( state, thread_index, begin, pivot, leftmost );
         }
+
+        begin    = pivot + 1;
+        leftmost = false;
+    }
+
+    if( end - begin > 1 ) {
+        usize bad_allowed = 64 - __builtin_clzll( (u64)( end - begin ) );
+        ___sort_pdq( ctx, begin, end, bad_allowed, leftmost );
     }
 }
+internal void ___sort_parallel_job( usize thread_index, void* params ) {
+    SortParallelTask* task = params;
+    ___sort_parallel_range(
+        task->state, thread_index, task->begin, task->end, task->leftmost );
+}
 
-internal isize sorting_quicksort_partition_u32(
-    isize low, isize high, u32* buffer
+CORE_API void sorting_quicksort_parallel(
+    usize       thread_index,
+    isize       from_inclusive,
+    isize       to_inclusive,
+    usize       element_size,
+    void*       buffer,
+    SortLTFN*   lt,
+    void*       opt_lt_params,
+    SortSwapFN* opt_swap
 ) {
+    if(
+        to_inclusive - from_inclusive < SORT_PARALLEL_SERIAL_THRESHOLD ||
+        !job_system_query_thread_count()
+    ) {
+        sorting_quicksort(
+            from_inclusive, to_inclusive, element_size,
+            buffer, lt, opt_lt_params, opt_swap );
+        return;
+    }
+
+    assert( lt );
+    SortParallelState state = {};
+    state.ctx.buffer       = buffer;
+    state.ctx.element_size = element_size;
+    state.ctx.lt           = lt;
+    state.ctx.lt_params    = opt_lt_params;
+    state.ctx.swap_        = opt_swap;
+
+    ___sort_parallel_range(
+        &state, thread_index,
+        (usize)from_inclusive, (usize)to_inclusive + 1, true );
 
-    u32* pivot = buffer + high;
+    // NOTE(alicia): calling thread keeps running partitions while it waits.
+    job_counter_wait( thread_index, &state.counter );
+}
 
-    isize i = low - 1;
+/// Number of bits in each radix sort digit.
+#define SORT_RADIX_BITS (11)
+/// Number of buckets in each radix sort histogram.
+#define SORT_RADIX_BUCKETS (1 << SORT_RADIX_BITS)
+#define SORT_RADIX_MASK    (SORT_RADIX_BUCKETS - 1)
+/// Inputs up to this size are insertion sorted instead,
+/// clearing histograms would cost more than sorting.
+#define SORT_RADIX_SMALL_COUNT (64)
+#define SORT_RADIX_PASSES_U32 ((32 + SORT_RADIX_BITS - 1) / SORT_RADIX_BITS)
+#define SORT_RADIX_PASSES_U64 ((64 + SORT_RADIX_BITS - 1) / SORT_RADIX_BITS)
 
-    for( isize j = low; j <= high - 1; ++j ) {
-        u32* at_j = buffer + j;
+/// Turn histogram into starting offset of each bucket.
+internal void ___sort_radix_prefix_sum( u32* histogram ) {
+    u32 sum = 0;
+    for( usize i = 0; i < SORT_RADIX_BUCKETS; ++i ) {
+        u32 bucket_count = histogram[i];
+        histogram[i] = sum;
+        sum += bucket_count;
+    }
+}
 
-        if( *at_j < *pivot ) {
-            ++i;
-            u32* at_i = buffer + i;
-            u32 temp = *at_j;
-            *at_j = *at_i;
-            *at_i = temp;
+CORE_API void sorting_radix_u32(
+    usize count, SortKeyU32* pairs, SortKeyU32* scratch
+) {
+    assert( count <= U32_MAX );
+    if( count <= SORT_RADIX_SMALL_COUNT ) {
+        for( usize i = 1; i < count; ++i ) {
+            SortKeyU32 pair = pairs[i];
+            usize j = i;
+            while( j && pair.key < pairs[j - 1].key ) {
+                pairs[j] = pairs[j - 1];
+                j--;
+            }
+            pairs[j] = pair;
         }
+        return;
     }
 
-    u32 temp = *(buffer + ( i + 1 ));
-    *(buffer + (i + 1)) = *(buffer + high);
-    *(buffer + high) = temp;
+    // NOTE(alicia): histogram of next digit is counted while
+    // scattering current one, only two histograms (16KB) live on
+    // stack so radix sort is safe to call from job fibers.
+    u32  histograms[2][SORT_RADIX_BUCKETS] = {};
+    u32* histogram = histograms[0];
+    u32* next      = histograms[1];
+    for( usize i = 0; i < count; ++i ) {
+        histogram[pairs[i].key & SORT_RADIX_MASK]++;
+    }
+
+    SortKeyU32* src = pairs;
+    SortKeyU32* dst = scratch;
+    for( usize pass = 0; pass < SORT_RADIX_PASSES_U32; ++pass ) {
+        u32 shift      = (u32)( pass * SORT_RADIX_BITS );
+        u32 next_shift = shift + SORT_RADIX_BITS;
+        b32 is_last    = pass + 1 == SORT_RADIX_PASSES_U32;
+        if( !is_last ) {
+            memory_zero( next, sizeof(histograms[0]) );
+        }
+
+        // NOTE(alicia): every key has the same digit, pass would not move anything.
+        if( histogram[( src[0].key >> shift ) & SORT_RADIX_MASK] == count ) {
+            if( !is_last ) {
+                for( usize i = 0; i < count; ++i ) {
+                    next[( src[i].key >> next_shift ) & SORT_RADIX_MASK]++;
+                }
+            }
+        } else {
+            ___sort_radix_prefix_sum( histogram );
+            if( is_last ) {
+                for( usize i = 0; i < count; ++i ) {
+                    u32 digit = ( src[i].key >> shift ) & SORT_RADIX_MASK;
+                    dst[histogram[digit]++] = src[i];
+                }
+            } else {
+                for( usize i = 0; i < count; ++i ) {
+                    u32 key   = src[i].key;
+                    u32 digit = ( key >> shift ) & SORT_RADIX_MASK;
+                    next[( key >> next_shift ) & SORT_RADIX_MASK]++;
+                    dst[histogram[digit]++] = src[i];
+                }
+            }
+
+            SortKeyU32* temp = src;
+            src = dst;
+            dst = temp;
+        }
+
+        u32* current = histogram;
+        histogram = next;
+        next      = current;
+    }
 
-    return i + 1;
+    if( src != pairs ) {
+        memory_copy( pairs, src, sizeof(SortKeyU32) * count );
+    }
 }
+CORE_API void sorting_radix_u64(
+    usize count, SortKeyU64* pairs, SortKeyU64* scratch
+) {
+    assert( count <= U32_MAX );
+    if( count <= SORT_RADIX_SMALL_COUNT ) {
+        for( usize i = 1; i < count; ++i ) {
+            SortKeyU64 pair = pairs[i];
+            usize j = i;
+            while( j && pair.key < pairs[j - 1].key ) {
+                pairs[j] = pairs[j - 1];
+                j--;
+            }
+            pairs[j] = pair;
+        }
+        return;
+    }
+
+    u32  histograms[2][SORT_RADIX_BUCKETS] = {};
+    u32* histogram = histograms[0];
+    u32* next      = histograms[1];
+    for( usize i = 0; i < count; ++i ) {
+        histogram[(u32)pairs[i].key & SORT_RADIX_MASK]++;
+    }
 
-CORE_API void sorting_quicksort_u32( isize low, isize high, u32* buffer ) {
-    while( low < high ) {
-        isize partition_index = sorting_quicksort_partition_u32( low, high, buffer );
-        if( partition_index - low < high - partition_index ) {
-            sorting_quicksort_u32( low, partition_index - 1, buffer );
-            low = partition_index + 1;
+    SortKeyU64* src = pairs;
+    SortKeyU64* dst = scratch;
+    for( usize pass = 0; pass < SORT_RADIX_PASSES_U64; ++pass ) {
+        u32 shift      = (u32)( pass * SORT_RADIX_BITS );
+        u32 next_shift = shift + SORT_RADIX_BITS;
+        b32 is_last    = pass + 1 == SORT_RADIX_PASSES_U64;
+        if( !is_last ) {
+            memory_zero( next, sizeof(histograms[0]) );
+        }
+
+        // NOTE(alicia): every key has the same digit, pass would not move anything.
+        if( histogram[(u32)( src[0].key >> shift ) & SORT_RADIX_MASK] == count ) {
+            if( !is_last ) {
+                for( usize i = 0; i < count; ++i ) {
+                    next[(u32)( src[i].key >> next_shift ) & SORT_RADIX_MASK]++;
+                }
+            }
         } else {
-            sorting_quicksort_u32( partition_index + 1, high, buffer );
-            high = partition_index - 1;
+            ___sort_radix_prefix_sum( histogram );
+            if( is_last ) {
+                for( usize i = 0; i < count; ++i ) {
+                    u32 digit = (u32)( src[i].key >> shift ) & SORT_RADIX_MASK;
+                    dst[histogram[digit]++] = src[i];
+                }
+            } else {
+                for( usize i = 0; i < count; ++i ) {
+                    u64 key   = src[i].key;
+                    u32 digit = (u32)( key >> shift ) & SORT_RADIX_MASK;
+                    next[(u32)( key >> next_shift ) & SORT_RADIX_MASK]++;
+                    dst[histogram[digit]++] = src[i];
+                }
+            }
+
+            SortKeyU64* temp = src;
+            src = dst;
+            dst = temp;
         }
+
+        u32* current = histogram;
+        histogram = next;
+        next      = current;
+    }
+
+    if( src != pairs ) {
+        memory_copy( pairs, src, sizeof(SortKeyU64) * count );
     }
 }
 
@@ -117,3 +718,16 @@ CORE_API void sorting_reverse(
     }
 }
 
+#undef SORT_INSERTION_THRESHOLD
+#undef SORT_NINTHER_THRESHOLD
+#undef SORT_PARTIAL_INSERTION_LIMIT
+#undef SORT_BLOCK_SIZE
+#undef SORT_RADIX_BITS
+#undef SORT_RADIX_BUCKETS
+#undef SORT_RADIX_MASK
+#undef SORT_RADIX_SMALL_COUNT
+#undef SORT_RADIX_PASSES_U32
+#undef SORT_RADIX_PASSES_U64
+#undef SORT_PARALLEL_SERIAL_THRESHOLD
+#undef SORT_PARALLEL_MAX_TASKS
+
@@ -12,6 +12,11 @@ typedef b32 SortLTFN( void* lhs, void* rhs, void* params );
 /// Swap elements function used for sorting.
 typedef void SortSwapFN( void* lhs, void* rhs );
 /// Quicksort sorting algorithm implementation.
+/// Pattern-defeating quicksort, O(n log n) worst case,
+/// close to O(n) on already sorted and reversed input.
+/// Not stable.
+/// If opt_swap is NULL, elements are swapped in place
+/// using element_size, which is faster than calling a swap function.
 CORE_API void sorting_quicksort(
     isize from_inclusive,
     isize to_inclusive,
@@ -19,12 +24,70 @@ CORE_API void sorting_quicksort(
     void* buffer,
     SortLTFN* lt,
     void* opt_lt_params,
-    SortSwapFN* swap
+    SortSwapFN* opt_swap
+);
+/// Quicksort sorting algorithm implementation that
+/// splits work across job system threads.
+/// Takes the same arguments as sorting_quicksort,
+/// plus calling thread's job system index in front of them.
+/// Thread index must be the index that running job received,
+/// 0 when called from main thread or JOB_THREAD_INDEX_EXTERNAL
+/// from any other thread, same as job_system_push_local.
+/// Calling thread sorts partitions too and returns once sorting is done,
+/// external threads sleep instead of helping with other jobs while waiting.
+/// Small ranges, or if job system has not been initialized,
+/// are sorted on calling thread with sorting_quicksort.
+CORE_API void sorting_quicksort_parallel(
+    usize thread_index,
+    isize from_inclusive,
+    isize to_inclusive,
+    usize element_size,
+    void* buffer,
+    SortLTFN* lt,
+    void* opt_lt_params,
+    SortSwapFN* opt_swap
 );
 /// Quicksort unsigned int32
 CORE_API void sorting_quicksort_u32(
     isize from_inclusive, isize to_inclusive, u32* buffer );
 
+/// Key and index pair sorted by sorting_radix_u32.
+typedef struct SortKeyU32 {
+    u32 key;
+    u32 index;
+} SortKeyU32;
+/// Key and index pair sorted by sorting_radix_u64.
+typedef struct SortKeyU64 {
+    u64 key;
+    u32 index;
+    u32 ___padding;
+} SortKeyU64;
+
+/// Convert float to a key that sorts in the same order as float.
+header_only u32 sort_key_from_f32( f32 x ) {
+    union { f32 f; u32 u; } bits = { .f=x };
+    // NOTE(alicia): negative floats have every bit flipped so that
+    // larger magnitudes sort lower, positive floats only flip sign bit.
+    u32 mask = (u32)( -(i32)( bits.u >> 31 ) ) | 0x80000000u;
+    return bits.u ^ mask;
+}
+/// Convert double to a key that sorts in the same order as double.
+header_only u64 sort_key_from_f64( f64 x ) {
+    union { f64 f; u64 u; } bits = { .f=x };
+    u64 mask = (u64)( -(i64)( bits.u >> 63 ) ) | 0x8000000000000000ull;
+    return bits.u ^ mask;
+}
+/// Radix sort key and index pairs by key in ascending order.
+/// Sort is stable, pairs with equal keys keep their order.
+/// Scratch must be able to hold count pairs, nothing is allocated.
+CORE_API void sorting_radix_u32(
+    usize count, SortKeyU32* pairs, SortKeyU32* scratch );
+/// Radix sort key and index pairs by key in ascending order.
+/// Sort is stable, pairs with equal keys keep their order.
+/// Scratch must be able to hold count pairs, nothing is allocated.
+CORE_API void sorting_radix_u64(
+    usize count, SortKeyU64* pairs, SortKeyU64* scratch );
+
 /// Reverse items in buffer.
 CORE_API void sorting_reverse(
     usize item_count, usize item_size,
@@ -8,35 +8,313 @@
 #include "core/memory.h"
 #include "core/fmt.h"
 #include "core/collections.h"
+#include "core/system.h"
 
 #if defined(LD_ARCH_X86) && LD_SIMD_WIDTH != 1
     #include <immintrin.h>
 #endif
 
-CORE_API u64 cstr_hash( usize opt_len, const char* str ) {
-    // NOTE(alicia): elf-hash implementation
-    // may change in the future!
+// NOTE(alicia): string hash.
+// Short strings use wyhash style 64x64 -> 128 bit multiply mixing,
+// 16 bytes per step. Strings longer than STRING_HASH_BULK_THRESHOLD
+// are accumulated in eight 64-bit lanes, 64 bytes per step,
+// in the style of xxh3, which maps directly onto SSE2/AVX2.
+// Every implementation only uses exact integer arithmetic so
+// scalar, SSE2 and AVX2 paths produce identical results,
+// hashes generated by hash/ always match runtime hashes.
+// Reads assume little-endian, true of every supported target.
+
+#define STRING_HASH_SECRET_0 (0xA0761D6478BD642Full)
+#define STRING_HASH_SECRET_1 (0xE7037ED1A0B428DBull)
+#define STRING_HASH_SECRET_2 (0x8EBC6AF09C88C6E3ull)
+#define STRING_HASH_SECRET_3 (0x589965CC75374CC3ull)
+#define STRING_HASH_PRIME_32 (0x9E3779B1u)
+
+#define STRING_HASH_LANE_COUNT        (8)
+#define STRING_HASH_STRIPE_SIZE       (64)
+/// Accumulators are scrambled after every block of stripes.
+#define STRING_HASH_STRIPES_PER_BLOCK (16)
+#define STRING_HASH_BULK_THRESHOLD    (256)
+
+global const u64 global_string_hash_lane_secrets[STRING_HASH_LANE_COUNT] = {
+    0xBE4BA423396CFEB8ull, 0x1CAD21F72C81017Cull,
+    0xDB979083E96DD4DEull, 0x1F67B3B7A4A44072ull,
+    0x78E5C0CC4EE679CBull, 0x2172FFCC7DD05A82ull,
+    0x8E2443F7744608B8ull, 0x4C263A81E69035E0ull,
+};
+global const u64 global_string_hash_scramble_secrets[STRING_HASH_LANE_COUNT] = {
+    0xCB00C391BB52283Cull, 0xA32E531B8B65D088ull,
+    0x4EF90DA297486471ull, 0xD8ACDEA946EF1938ull,
+    0x3F349CE33F76FAA8ull, 0x1D4F0BC7C7BBDCF9ull,
+    0x3159B4CD4BE0518Aull, 0x647378D9C97E9FC8ull,
+};
+
+internal force_inline u64 ___string_hash_read_u64( const u8* bytes ) {
+    u64 result;
+    __builtin_memcpy( &result, bytes, sizeof(result) );
+    return result;
+}
+internal force_inline u64 ___string_hash_read_u32( const u8* bytes ) {
+    u32 result;
+    __builtin_memcpy( &result, bytes, sizeof(result) );
+    return result;
+}
+/// Full 64x64 -> 128 bit multiply.
+internal force_inline void ___string_hash_mum( u64* a, u64* b ) {
+#if defined(LD_ARCH_64_BIT)
+    unsigned __int128 product = (unsigned __int128)*a * *b;
+    *a = (u64)product;
+    *b = (u64)( product >> 64 );
+#else
+    u64 ha = *a >> 32, hb = *b >> 32;
+    u64 la = (u32)*a,  lb = (u32)*b;
+    u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    u64 t  = rl + ( rm0 << 32 );
+    u64 c  = t < rl;
+    u64 lo = t + ( rm1 << 32 );
+    c += lo < t;
+    *a = lo;
+    *b = rh + ( rm0 >> 32 ) + ( rm1 >> 32 ) + c;
+#endif
+}
+internal force_inline u64 ___string_hash_mix( u64 a, u64 b ) {
+    ___string_hash_mum( &a, &b );
+    return a ^ b;
+}
+
+internal void ___string_hash_bulk_scalar(
+    const u8* bytes, usize len, u64* acc
+) {
+    usize stripe_count = ( len - 1 ) / STRING_HASH_STRIPE_SIZE;
+    for( usize stripe = 0; stripe < stripe_count; ++stripe ) {
+        const u8* at = bytes + ( stripe * STRING_HASH_STRIPE_SIZE );
+        for( usize lane = 0; lane < STRING_HASH_LANE_COUNT; ++lane ) {
+            u64 data = ___string_hash_read_u64( at + ( lane * 8 ) );
+            u64 key  = data ^ global_string_hash_lane_secrets[lane];
+            acc[lane ^ 1] += data;
+            acc[lane]     += ( key & 0xFFFFFFFF ) * ( key >> 32 );
+        }
+        if( ( stripe + 1 ) % STRING_HASH_STRIPES_PER_BLOCK == 0 ) {
+            for( usize lane = 0; lane < STRING_HASH_LANE_COUNT; ++lane ) {
+                u64 x = acc[lane];
+                x ^= x >> 47;
+                x ^= global_string_hash_scramble_secrets[lane];
+                acc[lane] = x * STRING_HASH_PRIME_32;
+            }
+        }
+    }
+
+    // NOTE(alicia): last stripe overlaps previous one
+    // so that there's never a partial stripe.
+    const u8* at = bytes + len - STRING_HASH_STRIPE_SIZE;
+    for( usize lane = 0; lane < STRING_HASH_LANE_COUNT; ++lane ) {
+        u64 data = ___string_hash_read_u64( at + ( lane * 8 ) );
+        u64 key  = data ^ global_string_hash_lane_secrets[lane];
+        acc[lane ^ 1] += data;
+        acc[lane]     += ( key & 0xFFFFFFFF ) * ( key >> 32 );
+    }
+}
+
+#if defined(LD_ARCH_X86) && LD_SIMD_WIDTH != 1
+
+internal force_inline
+__m128i ___string_hash_accumulate_sse2(
+    __m128i acc, const u8* at, const u64* secrets
+) {
+    __m128i data    = _mm_loadu_si128( (const __m128i*)at );
+    __m128i key     = _mm_xor_si128(
+        data, _mm_loadu_si128( (const __m128i*)secrets ) );
+    __m128i product = _mm_mul_epu32( key, _mm_srli_epi64( key, 32 ) );
+    __m128i swapped = _mm_shuffle_epi32( data, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+    return _mm_add_epi64( acc, _mm_add_epi64( swapped, product ) );
+}
+internal force_inline
+__m128i ___string_hash_scramble_sse2( __m128i acc, const u64* secrets ) {
+    __m128i prime = _mm_set1_epi32( (int)STRING_HASH_PRIME_32 );
+    acc = _mm_xor_si128( acc, _mm_srli_epi64( acc, 47 ) );
+    acc = _mm_xor_si128( acc, _mm_loadu_si128( (const __m128i*)secrets ) );
+    __m128i lo = _mm_mul_epu32( acc, prime );
+    __m128i hi = _mm_mul_epu32( _mm_srli_epi64( acc, 32 ), prime );
+    return _mm_add_epi64( lo, _mm_slli_epi64( hi, 32 ) );
+}
+internal void ___string_hash_bulk_sse2(
+    const u8* bytes, usize len, u64* acc
+) {
+    __m128i v[4];
+    for( usize i = 0; i < 4; ++i ) {
+        v[i] = _mm_loadu_si128( (const __m128i*)( acc + ( i * 2 ) ) );
+    }
+
+    usize stripe_count = ( len - 1 ) / STRING_HASH_STRIPE_SIZE;
+    for( usize stripe = 0; stripe < stripe_count; ++stripe ) {
+        const u8* at = bytes + ( stripe * STRING_HASH_STRIPE_SIZE );
+        for( usize i = 0; i < 4; ++i ) {
+            v[i] = ___string_hash_accumulate_sse2(
+                v[i], at + ( i * 16 ), global_string_hash_lane_secrets + ( i * 2 ) );
+        }
+        if( ( stripe + 1 ) % STRING_HASH_STRIPES_PER_BLOCK == 0 ) {
+            for( usize i = 0; i < 4; ++i ) {
+                v[i] = ___string_hash_scramble_sse2(
+                    v[i], global_string_hash_scramble_secrets + ( i * 2 ) );
+            }
+        }
+    }
 
+    const u8* at = bytes + len - STRING_HASH_STRIPE_SIZE;
+    for( usize i = 0; i < 4; ++i ) {
+        v[i] = ___string_hash_accumulate_sse2(
+            v[i], at + ( i * 16 ), global_string_hash_lane_secrets + ( i * 2 ) );
+        _mm_storeu_si128( (__m128i*)( acc + ( i * 2 ) ), v[i] );
+    }
+}
+
+internal target_features( "avx2" )
+__m256i ___string_hash_accumulate_avx2(
+    __m256i acc, const u8* at, const u64* secrets
+) {
+    __m256i data    = _mm256_loadu_si256( (const __m256i*)at );
+    __m256i key     = _mm256_xor_si256(
+        data, _mm256_loadu_si256( (const __m256i*)secrets ) );
+    __m256i product = _mm256_mul_epu32( key, _mm256_srli_epi64( key, 32 ) );
+    __m256i swapped = _mm256_shuffle_epi32( data, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+    return _mm256_add_epi64( acc, _mm256_add_epi64( swapped, product ) );
+}
+internal target_features( "avx2" )
+__m256i ___string_hash_scramble_avx2( __m256i acc, const u64* secrets ) {
+    __m256i prime = _mm256_set1_epi32( (int)STRING_HASH_PRIME_32 );
+    acc = _mm256_xor_si256( acc, _mm256_srli_epi64( acc, 47 ) );
+    acc = _mm256_xor_si256(
+        acc, _mm256_loadu_si256( (const __m256i*)secrets ) );
+    __m256i lo = _mm256_mul_epu32( acc, prime );
+    __m256i hi = _mm256_mul_epu32( _mm256_srli_epi64( acc, 32 ), prime );
+    return _mm256_add_epi64( lo, _mm256_slli_epi64( hi, 32 ) );
+}
+internal target_features( "avx2" )
+void ___string_hash_bulk_avx2( const u8* bytes, usize len, u64* acc ) {
+    __m256i v0 = _mm256_loadu_si256( (const __m256i*)( acc + 0 ) );
+    __m256i v1 = _mm256_loadu_si256( (const __m256i*)( acc + 4 ) );
+
+    usize stripe_count = ( len - 1 ) / STRING_HASH_STRIPE_SIZE;
+    for( usize stripe = 0; stripe < stripe_count; ++stripe ) {
+        const u8* at = bytes + ( stripe * STRING_HASH_STRIPE_SIZE );
+        v0 = ___string_hash_accumulate_avx2(
+            v0, at + 0,  global_string_hash_lane_secrets + 0 );
+        v1 = ___string_hash_accumulate_avx2(
+            v1, at + 32, global_string_hash_lane_secrets + 4 );
+        if( ( stripe + 1 ) % STRING_HASH_STRIPES_PER_BLOCK == 0 ) {
+            v0 = ___string_hash_scramble_avx2(
+                v0, global_string_hash_scramble_secrets + 0 );
+            v1 = ___string_hash_scramble_avx2(
+                v1, global_string_hash_scramble_secrets + 4 );
+        }
+    }
+
+    const u8* at = bytes + len - STRING_HASH_STRIPE_SIZE;
+    v0 = ___string_hash_accumulate_avx2(
+        v0, at + 0,  global_string_hash_lane_secrets + 0 );
+    v1 = ___string_hash_accumulate_avx2(
+        v1, at + 32, global_string_hash_lane_secrets + 4 );
+    _mm256_storeu_si256( (__m256i*)( acc + 0 ), v0 );
+    _mm256_storeu_si256( (__m256i*)( acc + 4 ), v1 );
+}
+
+#endif /* x86 */
+
+typedef void ___StringHashBulkFN( const u8* bytes, usize len, u64* acc );
+
+internal void ___string_hash_bulk_resolve( const u8* bytes, usize len, u64* acc );
+
+// NOTE(alicia): same as memory primitives, resolves
+// implementation from cpu features on first call.
+global ___StringHashBulkFN* global_string_hash_bulk = ___string_hash_bulk_resolve;
+
+internal void ___string_hash_bulk_resolve( const u8* bytes, usize len, u64* acc ) {
+    ___StringHashBulkFN* bulk = ___string_hash_bulk_scalar;
+
+#if defined(LD_ARCH_X86) && LD_SIMD_WIDTH != 1
+    CPUFeatureFlags features = system_info_query_features();
+    if( bitfield_check( features, CPU_FEATURE_AVX2 ) ) {
+        bulk = ___string_hash_bulk_avx2;
+    } else if( bitfield_check( features, CPU_FEATURE_SSE2 ) ) {
+        bulk = ___string_hash_bulk_sse2;
+    }
+#endif
+
+    global_string_hash_bulk = bulk;
+    bulk( bytes, len, acc );
+}
+
+CORE_API u64 cstr_hash( usize opt_len, const char* str ) {
     usize len = opt_len;
     if( !len ) {
         len = cstr_len( str );
     }
 
-    unsigned char* ustr = (unsigned char*)str;
-
-    u64 x;
-    u64 result = x = 0;
-    for( usize i = 0; i < len; ++i ) {
-        result = ( result << 4 ) + ustr[i];
-        x = result & 0xF000000000000000;
-        if( x ) {
-            result ^= x >> 24;
+    const u8* bytes = (const u8*)str;
+    u64 seed = STRING_HASH_SECRET_0;
+    u64 a = 0, b = 0;
+
+    if( len <= 16 ) {
+        if( len >= 4 ) {
+            usize offset = ( len >> 3 ) << 2;
+            a = ( ___string_hash_read_u32( bytes ) << 32 ) |
+                ___string_hash_read_u32( bytes + offset );
+            b = ( ___string_hash_read_u32( bytes + len - 4 ) << 32 ) |
+                ___string_hash_read_u32( bytes + len - 4 - offset );
+        } else if( len ) {
+            a = ( (u64)bytes[0] << 16 ) |
+                ( (u64)bytes[len >> 1] << 8 ) |
+                bytes[len - 1];
         }
-        result &= ~x;
+    } else {
+        if( len > STRING_HASH_BULK_THRESHOLD ) {
+            u64 acc[STRING_HASH_LANE_COUNT];
+            for( usize i = 0; i < STRING_HASH_LANE_COUNT; ++i ) {
+                acc[i] = global_string_hash_lane_secrets[i];
+            }
+            global_string_hash_bulk( bytes, len, acc );
+
+            seed ^= ___string_hash_mix(
+                acc[0] ^ STRING_HASH_SECRET_1, acc[1] ^ seed );
+            seed ^= ___string_hash_mix(
+                acc[2] ^ STRING_HASH_SECRET_2, acc[3] ^ seed );
+            seed ^= ___string_hash_mix(
+                acc[4] ^ STRING_HASH_SECRET_3, acc[5] ^ seed );
+            seed ^= ___string_hash_mix(
+                acc[6] ^ STRING_HASH_SECRET_1, acc[7] ^ seed );
+        } else {
+            const u8* at = bytes;
+            usize remaining = len;
+            while( remaining > 16 ) {
+                seed = ___string_hash_mix(
+                    ___string_hash_read_u64( at ) ^ STRING_HASH_SECRET_1,
+                    ___string_hash_read_u64( at + 8 ) ^ seed );
+                at        += 16;
+                remaining -= 16;
+            }
+        }
+
+        a = ___string_hash_read_u64( bytes + len - 16 );
+        b = ___string_hash_read_u64( bytes + len - 8 );
     }
 
-    return result;
+    a ^= STRING_HASH_SECRET_1;
+    b ^= seed;
+    ___string_hash_mum( &a, &b );
+    return ___string_hash_mix(
+        a ^ STRING_HASH_SECRET_0 ^ (u64)len, b ^ STRING_HASH_SECRET_1 );
 }
+
+#undef STRING_HASH_SECRET_0
+#undef STRING_HASH_SECRET_1
+#undef STRING_HASH_SECRET_2
+#undef STRING_HASH_SECRET_3
+#undef STRING_HASH_PRIME_32
+#undef STRING_HASH_LANE_COUNT
+#undef STRING_HASH_STRIPE_SIZE
+#undef STRING_HASH_STRIPES_PER_BLOCK
+#undef STRING_HASH_BULK_THRESHOLD
+
 CORE_API usize cstr_len( const char* cstr ) {
     if( !cstr ) {
         return 0;
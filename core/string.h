@@ -57,6 +57,7 @@ header_only b32 char_is_digit_hexadecimal( char character ) {
     return char_is_digit( character ) || upper || lower;
 }
 /// Hash a string.
+/// Result is identical on every platform and cpu.
 CORE_API u64 cstr_hash( usize opt_len, const char* string );
 /// Hash a string literal.
 #define text_hash( string )\
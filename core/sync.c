@@ -4,104 +4,564 @@
  * File Created: December 03, 2023
 */
 #include "shared/defines.h"
+#include "shared/constants.h"
 #include "core/sync.h"
-#include "core/string.h"
+#include "core/memory.h"
 #include "core/internal/platform.h"
 
-global volatile u32 global_running_semaphore_counter = 0;
-global volatile u32 global_running_mutex_counter     = 0;
+/// Number of times a waiting thread spins before sleeping.
+#define SYNC_SPIN_COUNT (32)
 
-CORE_API b32 semaphore_create( Semaphore* out_semaphore ) {
-    u32 next_number = interlocked_increment( &global_running_semaphore_counter );
+/// Set when threads might be sleeping on semaphore.
+#define SEMAPHORE_SLEEPERS_BIT (1u << 31)
+#define SEMAPHORE_COUNT_MASK   (~SEMAPHORE_SLEEPERS_BIT)
 
-    #define SEMAPHORE_NAME_BUFFER_CAPACITY (64)
-    char small_buffer[SEMAPHORE_NAME_BUFFER_CAPACITY] = {};
+#define MUTEX_UNLOCKED  (0)
+#define MUTEX_LOCKED    (1)
+#define MUTEX_CONTENDED (2)
 
-    StringBuffer buffer;
-    buffer.c   = small_buffer;
-    buffer.cap = SEMAPHORE_NAME_BUFFER_CAPACITY;
-    buffer.len = 0;
+#define EVENT_RESET          (0)
+#define EVENT_SIGNALED       (1)
+#define EVENT_RESET_SLEEPERS (2)
 
-    string_buffer_fmt( &buffer, "sem{u,x}{0}", next_number );
+#define RW_LOCK_MASK            ((1u << 30) - 1)
+#define RW_LOCK_WRITE_LOCKED    RW_LOCK_MASK
+#define RW_LOCK_MAX_READERS     (RW_LOCK_MASK - 1)
+#define RW_LOCK_READERS_WAITING (1u << 30)
+#define RW_LOCK_WRITERS_WAITING (1u << 31)
+#define RW_LOCK_WAITING         (RW_LOCK_READERS_WAITING | RW_LOCK_WRITERS_WAITING)
 
-    void* handle = platform_semaphore_create( small_buffer, 0 );
-    if( !handle ) {
-        return false;
+/// Query start time for a timed wait.
+internal force_inline f64 ___sync_wait_begin( u32 ms ) {
+    if( ms == PLATFORM_INFINITE_TIMEOUT || !ms ) {
+        return 0.0;
     }
-
-    out_semaphore->handle = handle;
-
-    #undef SEMAPHORE_NAME_BUFFER_CAPACITY
-    return true;
+    return platform_time_query_elapsed_seconds();
 }
-CORE_API b32 semaphore_create_named( const char* name, Semaphore* out_semaphore ) {
-    void* handle = platform_semaphore_create( name, 0 );
-    if( !handle ) {
-        return false;
+/// Milliseconds left of a timed wait, 0 if timed out.
+internal u32 ___sync_wait_remaining( f64 start, u32 ms ) {
+    if( ms == PLATFORM_INFINITE_TIMEOUT || !ms ) {
+        return ms;
     }
+    f64 elapsed_ms = ( platform_time_query_elapsed_seconds() - start ) * 1000.0;
+    if( elapsed_ms >= (f64)ms ) {
+        return 0;
+    }
+    u32 result = (u32)( (f64)ms - elapsed_ms );
+    return result ? result : 1;
+}
 
-    out_semaphore->handle = handle;
+CORE_API b32 semaphore_create( Semaphore* out_semaphore ) {
+    out_semaphore->value = 0;
     return true;
 }
+CORE_API b32 semaphore_create_named( const char* name, Semaphore* out_semaphore ) {
+    unused(name);
+    return semaphore_create( out_semaphore );
+}
 CORE_API void semaphore_destroy( Semaphore* semaphore ) {
-    platform_semaphore_destroy( semaphore->handle );
-    semaphore->handle = NULL;
+    semaphore->value = 0;
 }
 CORE_API void semaphore_signal( Semaphore* semaphore ) {
-    platform_semaphore_signal( semaphore->handle );
+    u32 value = atomic_load_u32( &semaphore->value, MEMORY_ORDER_RELAXED );
+    // NOTE(alicia): sleepers bit is cleared by signal that wakes a sleeper,
+    // woken thread sets it again if it might not be the only sleeper.
+    while( !atomic_compare_exchange_weak_u32(
+        &semaphore->value, &value,
+        ( value & SEMAPHORE_COUNT_MASK ) + 1,
+        MEMORY_ORDER_RELEASE, MEMORY_ORDER_RELAXED
+    ) ) {}
+
+    if( value & SEMAPHORE_SLEEPERS_BIT ) {
+        platform_futex_wake( &semaphore->value );
+    }
+}
+internal b32 ___semaphore_wait( Semaphore* semaphore, u32 ms ) {
+    for( u32 i = 0; i < SYNC_SPIN_COUNT; ++i ) {
+        u32 value = atomic_load_u32( &semaphore->value, MEMORY_ORDER_RELAXED );
+        if( value & SEMAPHORE_COUNT_MASK ) {
+            if( atomic_compare_exchange_weak_u32(
+                &semaphore->value, &value, value - 1,
+                MEMORY_ORDER_ACQUIRE, MEMORY_ORDER_RELAXED
+            ) ) {
+                return true;
+            }
+            continue;
+        }
+        cpu_pause();
+    }
+
+    f64 start     = ___sync_wait_begin( ms );
+    b32 has_slept = false;
+    loop {
+        u32 value = atomic_load_u32( &semaphore->value, MEMORY_ORDER_RELAXED );
+        if( value & SEMAPHORE_COUNT_MASK ) {
+            u32 next = value - 1;
+            if( has_slept ) {
+                next |= SEMAPHORE_SLEEPERS_BIT;
+            }
+            if( !atomic_compare_exchange_weak_u32(
+                &semaphore->value, &value, next,
+                MEMORY_ORDER_ACQUIRE, MEMORY_ORDER_RELAXED
+            ) ) {
+                continue;
+            }
+            // NOTE(alicia): signals that came in after the one that woke
+            // this thread saw sleepers bit cleared and did not wake anyone.
+            if( has_slept && ( next & SEMAPHORE_COUNT_MASK ) ) {
+                platform_futex_wake( &semaphore->value );
+            }
+            return true;
+        }
+
+        u32 remaining = ___sync_wait_remaining( start, ms );
+        if( !remaining || !( value & SEMAPHORE_SLEEPERS_BIT ) ) {
+            // NOTE(alicia): a thread that slept sets sleepers bit
+            // even when giving up, other threads may still be sleeping.
+            if( ( has_slept || remaining ) && !atomic_compare_exchange_weak_u32(
+                &semaphore->value, &value,
+                value | SEMAPHORE_SLEEPERS_BIT,
+                MEMORY_ORDER_RELAXED, MEMORY_ORDER_RELAXED
+            ) ) {
+                continue;
+            }
+            if( !remaining ) {
+                return false;
+            }
+            value |= SEMAPHORE_SLEEPERS_BIT;
+        }
+
+        platform_futex_wait( &semaphore->value, value, remaining );
+        has_slept = true;
+    }
 }
 CORE_API void semaphore_wait( Semaphore* semaphore ) {
-    platform_semaphore_wait( semaphore->handle, PLATFORM_INFINITE_TIMEOUT );
+    ___semaphore_wait( semaphore, PLATFORM_INFINITE_TIMEOUT );
 }
 CORE_API b32 semaphore_wait_timed( Semaphore* semaphore, u32 ms ) {
-    return platform_semaphore_wait( semaphore->handle, ms );
+    return ___semaphore_wait( semaphore, ms );
+}
+
+CORE_API b32 mutex_create( Mutex* out_mutex ) {
+    out_mutex->value = MUTEX_UNLOCKED;
+    return true;
 }
 CORE_API b32 mutex_create_named( const char* name, Mutex* out_mutex ) {
-    void* handle = platform_mutex_create( name );
-    if( !handle ) {
-        return false;
+    unused(name);
+    return mutex_create( out_mutex );
+}
+CORE_API void mutex_destroy( Mutex* mutex ) {
+    assert( mutex->value == MUTEX_UNLOCKED );
+    mutex->value = MUTEX_UNLOCKED;
+}
+internal b32 ___mutex_lock( Mutex* mutex, u32 ms ) {
+    u32 value = MUTEX_UNLOCKED;
+    if( atomic_compare_exchange_weak_u32(
+        &mutex->value, &value, MUTEX_LOCKED,
+        MEMORY_ORDER_ACQUIRE, MEMORY_ORDER_RELAXED
+    ) ) {
+        return true;
     }
 
-    out_mutex->handle = handle;
+    for( u32 i = 0; i < SYNC_SPIN_COUNT; ++i ) {
+        value = atomic_load_u32( &mutex->value, MEMORY_ORDER_RELAXED );
+        if( value == MUTEX_UNLOCKED ) {
+            if( atomic_compare_exchange_weak_u32(
+                &mutex->value, &value, MUTEX_LOCKED,
+                MEMORY_ORDER_ACQUIRE, MEMORY_ORDER_RELAXED
+            ) ) {
+                return true;
+            }
+        } else if( value == MUTEX_CONTENDED ) {
+            // NOTE(alicia): others are already sleeping, don't cut in line.
+            break;
+        }
+        cpu_pause();
+    }
+
+    // NOTE(alicia): once a thread had to wait, mutex is marked contended
+    // so that unlock wakes next thread.
+    // Lock taken this way stays contended even if no one else is
+    // sleeping, costing at most one needless wake on unlock.
+    f64 start = ___sync_wait_begin( ms );
+    loop {
+        if( atomic_exchange_u32(
+            &mutex->value, MUTEX_CONTENDED, MEMORY_ORDER_ACQUIRE ) == MUTEX_UNLOCKED
+        ) {
+            return true;
+        }
+
+        u32 remaining = ___sync_wait_remaining( start, ms );
+        if( !remaining ) {
+            return false;
+        }
+        platform_futex_wait( &mutex->value, MUTEX_CONTENDED, remaining );
+    }
+}
+CORE_API void mutex_lock( Mutex* mutex ) {
+    ___mutex_lock( mutex, PLATFORM_INFINITE_TIMEOUT );
+}
+CORE_API b32 mutex_lock_timed( Mutex* mutex, u32 ms ) {
+    return ___mutex_lock( mutex, ms );
+}
+CORE_API void mutex_unlock( Mutex* mutex ) {
+    if( atomic_exchange_u32(
+        &mutex->value, MUTEX_UNLOCKED, MEMORY_ORDER_RELEASE ) == MUTEX_CONTENDED
+    ) {
+        platform_futex_wake( &mutex->value );
+    }
+}
+
+CORE_API b32 event_create( Event* out_event ) {
+    out_event->value = EVENT_RESET;
     return true;
 }
-CORE_API b32 mutex_create( Mutex* out_mutex ) {
-    u32 next_number = interlocked_increment( &global_running_mutex_counter );
+CORE_API void event_destroy( Event* event ) {
+    event->value = EVENT_RESET;
+}
+CORE_API void event_signal( Event* event ) {
+    if( atomic_exchange_u32(
+        &event->value, EVENT_SIGNALED, MEMORY_ORDER_RELEASE ) == EVENT_RESET_SLEEPERS
+    ) {
+        platform_futex_wake_all( &event->value );
+    }
+}
+CORE_API void event_reset( Event* event ) {
+    u32 value = EVENT_SIGNALED;
+    atomic_compare_exchange_u32(
+        &event->value, &value, EVENT_RESET,
+        MEMORY_ORDER_RELAXED, MEMORY_ORDER_RELAXED );
+}
+CORE_API b32 event_is_signaled( Event* event ) {
+    return atomic_load_u32( &event->value, MEMORY_ORDER_ACQUIRE ) == EVENT_SIGNALED;
+}
+internal b32 ___event_wait( Event* event, u32 ms ) {
+    for( u32 i = 0; i < SYNC_SPIN_COUNT; ++i ) {
+        if(
+            atomic_load_u32( &event->value, MEMORY_ORDER_ACQUIRE ) == EVENT_SIGNALED
+        ) {
+            return true;
+        }
+        cpu_pause();
+    }
 
-    #define MUTEX_NAME_BUFFER_CAPACITY (64)
-    char small_buffer[MUTEX_NAME_BUFFER_CAPACITY] = {};
-    StringBuffer buffer;
-    buffer.c   = small_buffer;
-    buffer.cap = MUTEX_NAME_BUFFER_CAPACITY;
-    buffer.len = 0;
+    f64 start = ___sync_wait_begin( ms );
+    loop {
+        u32 value = atomic_load_u32( &event->value, MEMORY_ORDER_ACQUIRE );
+        if( value == EVENT_SIGNALED ) {
+            return true;
+        }
 
-    string_buffer_fmt( &buffer, "mtx{u,x}{c}", next_number, 0 );
+        u32 remaining = ___sync_wait_remaining( start, ms );
+        if( !remaining ) {
+            return false;
+        }
+        if( value == EVENT_RESET && !atomic_compare_exchange_weak_u32(
+            &event->value, &value, EVENT_RESET_SLEEPERS,
+            MEMORY_ORDER_RELAXED, MEMORY_ORDER_RELAXED
+        ) ) {
+            continue;
+        }
+        platform_futex_wait( &event->value, EVENT_RESET_SLEEPERS, remaining );
+    }
+}
+CORE_API void event_wait( Event* event ) {
+    ___event_wait( event, PLATFORM_INFINITE_TIMEOUT );
+}
+CORE_API b32 event_wait_timed( Event* event, u32 ms ) {
+    return ___event_wait( event, ms );
+}
 
-    void* handle = platform_mutex_create( small_buffer );
-    if( !handle ) {
+internal force_inline b32 ___rw_lock_is_unlocked( u32 state ) {
+    return !( state & RW_LOCK_MASK );
+}
+internal force_inline b32 ___rw_lock_is_write_locked( u32 state ) {
+    return ( state & RW_LOCK_MASK ) == RW_LOCK_WRITE_LOCKED;
+}
+internal force_inline b32 ___rw_lock_is_read_lockable( u32 state ) {
+    // NOTE(alicia): readers don't cut in front of anyone
+    // that is waiting, this is what gives writers preference.
+    return
+        ( state & RW_LOCK_MASK ) < RW_LOCK_MAX_READERS &&
+        !( state & RW_LOCK_WAITING );
+}
+/// Spin while write locked and no one is sleeping.
+internal u32 ___rw_lock_spin_read( RWLock* lock ) {
+    u32 state = atomic_load_u32( &lock->state, MEMORY_ORDER_RELAXED );
+    for( u32 i = 0; i < SYNC_SPIN_COUNT; ++i ) {
+        if( !___rw_lock_is_write_locked( state ) || ( state & RW_LOCK_WAITING ) ) {
+            break;
+        }
+        cpu_pause();
+        state = atomic_load_u32( &lock->state, MEMORY_ORDER_RELAXED );
+    }
+    return state;
+}
+/// Spin while locked and no one is sleeping.
+internal u32 ___rw_lock_spin_write( RWLock* lock ) {
+    u32 state = atomic_load_u32( &lock->state, MEMORY_ORDER_RELAXED );
+    for( u32 i = 0; i < SYNC_SPIN_COUNT; ++i ) {
+        if( ___rw_lock_is_unlocked( state ) || ( state & RW_LOCK_WAITING ) ) {
+            break;
+        }
+        cpu_pause();
+        state = atomic_load_u32( &lock->state, MEMORY_ORDER_RELAXED );
+    }
+    return state;
+}
+/// Returns true if a writer was woken.
+internal b32 ___rw_lock_wake_writer( RWLock* lock ) {
+    // NOTE(alicia): futex wake can't report if anyone was woken on
+    // every platform, so sleeping writers are counted instead.
+    // A counted writer that hasn't slept yet sees notify change
+    // and goes back to taking the lock, which is as good as woken.
+    atomic_fetch_add_u32( &lock->writer_notify, 1, MEMORY_ORDER_SEQ_CST );
+    if( !atomic_load_u32( &lock->writers_sleeping, MEMORY_ORDER_SEQ_CST ) ) {
         return false;
     }
+    platform_futex_wake( &lock->writer_notify );
+    return true;
+}
+/// Wake a writer if there is one waiting, otherwise wake all readers.
+internal no_inline void ___rw_lock_wake_writer_or_readers( RWLock* lock, u32 state ) {
+    assert( ___rw_lock_is_unlocked( state ) );
 
-    out_mutex->handle = handle;
+    if( state == RW_LOCK_WRITERS_WAITING ) {
+        if( atomic_compare_exchange_u32(
+            &lock->state, &state, 0,
+            MEMORY_ORDER_RELAXED, MEMORY_ORDER_RELAXED
+        ) ) {
+            ___rw_lock_wake_writer( lock );
+            return;
+        }
+    }
 
-    #undef MUTEX_NAME_BUFFER_CAPACITY
+    if( state == RW_LOCK_WAITING ) {
+        // NOTE(alicia): writers waiting bit can be left over from a writer
+        // that has already taken lock, readers are woken if no writer was.
+        if( atomic_compare_exchange_u32(
+            &lock->state, &state, RW_LOCK_READERS_WAITING,
+            MEMORY_ORDER_RELAXED, MEMORY_ORDER_RELAXED
+        ) ) {
+            if( ___rw_lock_wake_writer( lock ) ) {
+                return;
+            }
+            state = RW_LOCK_READERS_WAITING;
+        }
+    }
+
+    if( state == RW_LOCK_READERS_WAITING ) {
+        if( atomic_compare_exchange_u32(
+            &lock->state, &state, 0,
+            MEMORY_ORDER_RELAXED, MEMORY_ORDER_RELAXED
+        ) ) {
+            platform_futex_wake_all( &lock->state );
+        }
+    }
+}
+internal no_inline void ___rw_lock_read_contended( RWLock* lock ) {
+    u32 state = ___rw_lock_spin_read( lock );
+    loop {
+        if( ___rw_lock_is_read_lockable( state ) ) {
+            if( atomic_compare_exchange_weak_u32(
+                &lock->state, &state, state + 1,
+                MEMORY_ORDER_ACQUIRE, MEMORY_ORDER_RELAXED
+            ) ) {
+                return;
+            }
+            continue;
+        }
+        assert( ( state & RW_LOCK_MASK ) != RW_LOCK_MAX_READERS );
+
+        if( !( state & RW_LOCK_READERS_WAITING ) ) {
+            if( !atomic_compare_exchange_weak_u32(
+                &lock->state, &state, state | RW_LOCK_READERS_WAITING,
+                MEMORY_ORDER_RELAXED, MEMORY_ORDER_RELAXED
+            ) ) {
+                continue;
+            }
+        }
+
+        platform_futex_wait(
+            &lock->state, state | RW_LOCK_READERS_WAITING,
+            PLATFORM_INFINITE_TIMEOUT );
+        state = ___rw_lock_spin_read( lock );
+    }
+}
+internal no_inline void ___rw_lock_write_contended( RWLock* lock ) {
+    u32 state = ___rw_lock_spin_write( lock );
+    // NOTE(alicia): once a writer has slept, it can't know if it was
+    // the only one so it keeps writers waiting bit set when locking.
+    u32 other_writers_waiting = 0;
+    loop {
+        if( ___rw_lock_is_unlocked( state ) ) {
+            if( atomic_compare_exchange_weak_u32(
+                &lock->state, &state,
+                state | RW_LOCK_WRITE_LOCKED | other_writers_waiting,
+                MEMORY_ORDER_ACQUIRE, MEMORY_ORDER_RELAXED
+            ) ) {
+                return;
+            }
+            continue;
+        }
+
+        if( !( state & RW_LOCK_WRITERS_WAITING ) ) {
+            if( !atomic_compare_exchange_weak_u32(
+                &lock->state, &state, state | RW_LOCK_WRITERS_WAITING,
+                MEMORY_ORDER_RELAXED, MEMORY_ORDER_RELAXED
+            ) ) {
+                continue;
+            }
+        }
+
+        // NOTE(alicia): notify is read before checking state again
+        // so that a wake in between isn't missed.
+        atomic_fetch_add_u32( &lock->writers_sleeping, 1, MEMORY_ORDER_SEQ_CST );
+        u32 notify = atomic_load_u32( &lock->writer_notify, MEMORY_ORDER_SEQ_CST );
+        state = atomic_load_u32( &lock->state, MEMORY_ORDER_RELAXED );
+        if(
+            ___rw_lock_is_unlocked( state ) ||
+            !( state & RW_LOCK_WRITERS_WAITING )
+        ) {
+            atomic_fetch_sub_u32( &lock->writers_sleeping, 1, MEMORY_ORDER_RELAXED );
+            continue;
+        }
+
+        platform_futex_wait( &lock->writer_notify, notify, PLATFORM_INFINITE_TIMEOUT );
+        atomic_fetch_sub_u32( &lock->writers_sleeping, 1, MEMORY_ORDER_RELAXED );
+        other_writers_waiting = RW_LOCK_WRITERS_WAITING;
+        state = ___rw_lock_spin_write( lock );
+    }
+}
+
+CORE_API b32 rw_lock_create( RWLock* out_lock ) {
+    out_lock->state            = 0;
+    out_lock->writer_notify    = 0;
+    out_lock->writers_sleeping = 0;
     return true;
 }
-CORE_API void mutex_destroy( Mutex* mutex ) {
-    platform_mutex_destroy( mutex->handle );
-    mutex->handle = NULL;
+CORE_API void rw_lock_destroy( RWLock* lock ) {
+    assert( ___rw_lock_is_unlocked( lock->state ) );
+    lock->state            = 0;
+    lock->writer_notify    = 0;
+    lock->writers_sleeping = 0;
 }
-CORE_API void mutex_lock( Mutex* mutex ) {
-    platform_mutex_lock( mutex->handle, PLATFORM_INFINITE_TIMEOUT );
+CORE_API void rw_lock_read_lock( RWLock* lock ) {
+    u32 state = atomic_load_u32( &lock->state, MEMORY_ORDER_RELAXED );
+    if(
+        ___rw_lock_is_read_lockable( state ) &&
+        atomic_compare_exchange_weak_u32(
+            &lock->state, &state, state + 1,
+            MEMORY_ORDER_ACQUIRE, MEMORY_ORDER_RELAXED )
+    ) {
+        return;
+    }
+    ___rw_lock_read_contended( lock );
 }
-CORE_API b32 mutex_lock_timed( Mutex* mutex, u32 ms ) {
-    return platform_mutex_lock( mutex->handle, ms );
+CORE_API b32 rw_lock_try_read_lock( RWLock* lock ) {
+    u32 state = atomic_load_u32( &lock->state, MEMORY_ORDER_RELAXED );
+    while( ___rw_lock_is_read_lockable( state ) ) {
+        if( atomic_compare_exchange_weak_u32(
+            &lock->state, &state, state + 1,
+            MEMORY_ORDER_ACQUIRE, MEMORY_ORDER_RELAXED
+        ) ) {
+            return true;
+        }
+    }
+    return false;
 }
-CORE_API void mutex_unlock( Mutex* mutex ) {
-    platform_mutex_unlock( mutex->handle );
+CORE_API void rw_lock_read_unlock( RWLock* lock ) {
+    u32 state = atomic_fetch_sub_u32( &lock->state, 1, MEMORY_ORDER_RELEASE ) - 1;
+    // NOTE(alicia): readers only sleep on a read locked lock
+    // when a writer is waiting, so last reader out only has to check that.
+    if(
+        ___rw_lock_is_unlocked( state ) &&
+        ( state & RW_LOCK_WRITERS_WAITING )
+    ) {
+        ___rw_lock_wake_writer_or_readers( lock, state );
+    }
+}
+CORE_API void rw_lock_write_lock( RWLock* lock ) {
+    u32 state = 0;
+    if( atomic_compare_exchange_weak_u32(
+        &lock->state, &state, RW_LOCK_WRITE_LOCKED,
+        MEMORY_ORDER_ACQUIRE, MEMORY_ORDER_RELAXED
+    ) ) {
+        return;
+    }
+    ___rw_lock_write_contended( lock );
+}
+CORE_API b32 rw_lock_try_write_lock( RWLock* lock ) {
+    u32 state = atomic_load_u32( &lock->state, MEMORY_ORDER_RELAXED );
+    while( ___rw_lock_is_unlocked( state ) ) {
+        if( atomic_compare_exchange_weak_u32(
+            &lock->state, &state, state | RW_LOCK_WRITE_LOCKED,
+            MEMORY_ORDER_ACQUIRE, MEMORY_ORDER_RELAXED
+        ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+CORE_API void rw_lock_write_unlock( RWLock* lock ) {
+    u32 state = atomic_fetch_sub_u32(
+        &lock->state, RW_LOCK_WRITE_LOCKED, MEMORY_ORDER_RELEASE
+    ) - RW_LOCK_WRITE_LOCKED;
+    if( state & RW_LOCK_WAITING ) {
+        ___rw_lock_wake_writer_or_readers( lock, state );
+    }
+}
+
+CORE_API b32 seq_lock_create( SeqLock* out_lock ) {
+    out_lock->sequence = 0;
+    return true;
+}
+CORE_API void seq_lock_read(
+    SeqLock* lock, usize size, const void* src, void* dst
+) {
+    u32 sequence = 0;
+    do {
+        sequence = seq_lock_read_begin( lock );
+        memory_copy( dst, src, size );
+    } while( seq_lock_read_retry( lock, sequence ) );
+}
+CORE_API void seq_lock_write(
+    SeqLock* lock, usize size, const void* src, void* dst
+) {
+    seq_lock_write_begin( lock );
+    memory_copy( dst, src, size );
+    seq_lock_write_end( lock );
+}
+
+CORE_API void wait_on_address( volatile u32* address, u32 expected ) {
+    platform_futex_wait( address, expected, PLATFORM_INFINITE_TIMEOUT );
+}
+CORE_API b32 wait_on_address_timed( volatile u32* address, u32 expected, u32 ms ) {
+    return platform_futex_wait( address, expected, ms );
+}
+CORE_API void wake_by_address_single( volatile u32* address ) {
+    platform_futex_wake( address );
+}
+CORE_API void wake_by_address_all( volatile u32* address ) {
+    platform_futex_wake_all( address );
 }
 
 CORE_API void thread_sleep( u32 ms ) {
     platform_sleep( ms );
 }
 
+#undef SYNC_SPIN_COUNT
+#undef SEMAPHORE_SLEEPERS_BIT
+#undef SEMAPHORE_COUNT_MASK
+#undef MUTEX_UNLOCKED
+#undef MUTEX_LOCKED
+#undef MUTEX_CONTENDED
+#undef EVENT_RESET
+#undef EVENT_SIGNALED
+#undef EVENT_RESET_SLEEPERS
+#undef RW_LOCK_MASK
+#undef RW_LOCK_WRITE_LOCKED
+#undef RW_LOCK_MAX_READERS
+#undef RW_LOCK_READERS_WAITING
+#undef RW_LOCK_WRITERS_WAITING
+#undef RW_LOCK_WAITING
@@ -5,10 +5,31 @@
 */
 #include "shared/defines.h"
 #include "core/system.h"
+#include "core/atomic.h"
 #include "core/internal/platform.h"
+#include "core/internal/cpuid.h"
+
+global CPUFeatureFlags global_system_features         = 0;
+global volatile b32    global_system_features_queried = false;
 
 CORE_API void system_info_query( SystemInfo* out_info ) {
     platform_system_info_query( out_info );
 }
+CORE_API CPUFeatureFlags system_info_query_features(void) {
+    if( atomic_load_u32( &global_system_features_queried, MEMORY_ORDER_ACQUIRE ) ) {
+        return global_system_features;
+    }
+
+    // NOTE(alicia): every thread computes the same flags
+    // so racing on first query is harmless.
+    CPUFeatureFlags features = 0;
+#if defined(LD_ARCH_X86)
+    features = ___cpuid_query_features();
+#endif
+
+    global_system_features = features;
+    atomic_store_u32( &global_system_features_queried, true, MEMORY_ORDER_RELEASE );
+    return features;
+}
 
 
@@ -9,9 +9,11 @@
 
 /// Size of cpu name buffer.
 #define SYSTEM_INFO_CPU_NAME_CAPACITY (255)
+/// Maximum number of physical cores that topology is reported for.
+#define SYSTEM_INFO_MAX_CORE_COUNT (64)
 
 /// Feature flags.
-typedef u16 CPUFeatureFlags;
+typedef u32 CPUFeatureFlags;
 #define CPU_FEATURE_SSE     (1 << 0)
 #define CPU_FEATURE_SSE2    (1 << 1)
 #define CPU_FEATURE_SSE3    (1 << 2)
@@ -33,19 +35,61 @@ typedef u16 CPUFeatureFlags;
 #define CPU_FEATURE_AVX_MASK \
     ( CPU_FEATURE_AVX | CPU_FEATURE_AVX2 )
 
-#define CPU_FEATURE_AVX_512 (1 << 8)
+/// AVX-512 Foundation.
+#define CPU_FEATURE_AVX_512      (1 << 8)
+#define CPU_FEATURE_AVX_512_DQ   (1 << 9)
+#define CPU_FEATURE_AVX_512_CD   (1 << 10)
+#define CPU_FEATURE_AVX_512_BW   (1 << 11)
+#define CPU_FEATURE_AVX_512_VL   (1 << 12)
+#define CPU_FEATURE_AVX_512_IFMA (1 << 13)
+#define CPU_FEATURE_AVX_512_VBMI (1 << 14)
+#define CPU_FEATURE_AVX_512_VNNI (1 << 15)
+
+/// Subset of AVX-512 that every AVX-512 capable cpu since Skylake-X has.
+#define CPU_FEATURE_AVX_512_MASK \
+    ( CPU_FEATURE_AVX_512 |\
+        CPU_FEATURE_AVX_512_DQ |\
+        CPU_FEATURE_AVX_512_CD |\
+        CPU_FEATURE_AVX_512_BW |\
+        CPU_FEATURE_AVX_512_VL )
+
+#define CPU_FEATURE_FMA     (1 << 16)
+#define CPU_FEATURE_F16C    (1 << 17)
+#define CPU_FEATURE_BMI1    (1 << 18)
+#define CPU_FEATURE_BMI2    (1 << 19)
+#define CPU_FEATURE_POPCNT  (1 << 20)
+#define CPU_FEATURE_LZCNT   (1 << 21)
 
 /// System Information.
 typedef struct SystemInfo {
     char  cpu_name[SYSTEM_INFO_CPU_NAME_CAPACITY];
     usize total_memory;
     usize page_size;
+    /// Size of L1 data cache of a single core, 0 if unknown.
+    usize l1_cache_size;
+    /// Size of L2 cache of a single core, 0 if unknown.
+    usize l2_cache_size;
+    /// Size of L3 cache, usually shared by every core. 0 if unknown.
+    usize l3_cache_size;
+    u32   cache_line_size;
+    /// Number of logical processors (hardware threads).
     u16   cpu_count;
+    /// Number of physical cores.
+    /// Smaller than cpu_count when cores run multiple hardware threads (SMT).
+    u16   physical_cpu_count;
     CPUFeatureFlags feature_flags;
+    /// Index of first logical processor of each physical core,
+    /// for use with thread_set_affinity.
+    /// Only first SYSTEM_INFO_MAX_CORE_COUNT cores are listed.
+    u16   core_logical_cpu[SYSTEM_INFO_MAX_CORE_COUNT];
 } SystemInfo;
 
 /// Query information about the current system.
 CORE_API void system_info_query( SystemInfo* out_info );
+/// Query only cpu feature flags.
+/// Much cheaper than system_info_query, result is cached after first call.
+/// Meant for selecting implementations at runtime.
+CORE_API CPUFeatureFlags system_info_query_features(void);
 
 /// Check if x86 cpu has SSE instructions (1,2,3,SSSE3,4.1,4.2)
 /// Returns bitfield with missing instructions set to 1.
@@ -65,5 +109,14 @@ header_only CPUFeatureFlags system_info_feature_check_x86_avx( SystemInfo* info
 
     return missing_instructions;
 }
+/// Check if x86 cpu has AVX-512 instructions (F,DQ,CD,BW,VL)
+/// Returns bitfield with missing instructions set to 1.
+/// Returns zero if cpu has AVX-512 instructions.
+header_only CPUFeatureFlags system_info_feature_check_x86_avx_512( SystemInfo* info ) {
+    CPUFeatureFlags inverse              = ~info->feature_flags;
+    CPUFeatureFlags missing_instructions = inverse & CPU_FEATURE_AVX_512_MASK;
+
+    return missing_instructions;
+}
 
 #endif /* header guard */
@@ -0,0 +1,105 @@
+#if !defined(LD_CORE_TELEMETRY_H)
+#define LD_CORE_TELEMETRY_H
+/**
+ * Description:  Allocation telemetry.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 16, 2026
+ * Notes:        Only records allocations when core is built with LD_PROFILING
+ *               (debug builds, or release with make option PROFILING=true).
+ *               Allocations are recorded by the traced allocator macros
+ *               in core/memory.h, define LD_MEMORY_NO_LOG before including
+ *               core/memory.h to exclude a file from telemetry.
+ *               Table sizes are set with MEMORY_TELEMETRY_POINTER_CAPACITY
+ *               (make option TELEMETRY_CAPACITY) and
+ *               MEMORY_TELEMETRY_CALL_SITE_CAPACITY
+ *               (make option TELEMETRY_CALL_SITE_CAPACITY).
+*/
+#include "shared/defines.h"
+
+/// Subsystem that owns an allocation.
+typedef enum MemoryTag : u32 {
+    MEMORY_TAG_UNKNOWN,
+    MEMORY_TAG_CORE,
+    MEMORY_TAG_ENGINE,
+    MEMORY_TAG_RENDERER,
+    MEMORY_TAG_AUDIO,
+    MEMORY_TAG_INPUT,
+    MEMORY_TAG_PACKAGE,
+    MEMORY_TAG_GAME,
+
+    MEMORY_TAG_COUNT
+} MemoryTag;
+
+/// Allocator that an allocation was made from.
+typedef enum MemoryAllocatorKind : u32 {
+    MEMORY_ALLOCATOR_SYSTEM,
+    MEMORY_ALLOCATOR_PAGE,
+    MEMORY_ALLOCATOR_BLOCK,
+    MEMORY_ALLOCATOR_STACK,
+
+    MEMORY_ALLOCATOR_COUNT
+} MemoryAllocatorKind;
+
+/// Number of buckets in call site size histogram.
+/// Bucket 0 counts allocations smaller than 32 bytes,
+/// each following bucket doubles, last bucket counts everything larger.
+#define MEMORY_TELEMETRY_HISTOGRAM_BUCKET_COUNT (16)
+
+/// Allocation statistics for a tag.
+typedef struct MemoryTagStats {
+    /// Bytes currently allocated.
+    usize current;
+    /// Largest number of bytes allocated at once.
+    usize peak;
+} MemoryTagStats;
+
+/// Allocation statistics for a call site.
+typedef struct MemoryCallSiteStats {
+    const char*         file;
+    i32                 line;
+    MemoryTag           tag;
+    MemoryAllocatorKind allocator;
+    /// Bytes currently allocated from call site.
+    usize current;
+    /// Largest number of bytes allocated from call site at once.
+    usize peak;
+    /// Number of allocations by size.
+    usize histogram[MEMORY_TELEMETRY_HISTOGRAM_BUCKET_COUNT];
+} MemoryCallSiteStats;
+
+/// Check if core was built with allocation telemetry.
+CORE_API b32 memory_telemetry_is_enabled(void);
+/// Convert memory tag to a null-terminated string.
+CORE_API const char* memory_tag_to_cstr( MemoryTag tag );
+/// Convert allocator kind to a null-terminated string.
+CORE_API const char* memory_allocator_kind_to_cstr( MemoryAllocatorKind allocator );
+/// Query allocation statistics for tag and allocator.
+CORE_API MemoryTagStats memory_telemetry_query_tag(
+    MemoryTag tag, MemoryAllocatorKind allocator );
+/// Query allocation statistics for every call site.
+/// Writes up to capacity call sites to out_call_sites.
+/// Returns total number of call sites.
+CORE_API usize memory_telemetry_query_call_sites(
+    usize capacity, MemoryCallSiteStats* out_call_sites );
+/// Log current/peak usage of every tag and call site.
+CORE_API void memory_telemetry_log_report(void);
+/// Log every allocation that has not been freed, grouped by call site.
+/// Returns true if any leaks were found.
+CORE_API b32 memory_telemetry_log_leaks(void);
+
+/// Record an allocation.
+/// Owner is the buffer of the block or stack allocator that
+/// memory came from, null for system and page allocations.
+CORE_API void ___internal_memory_telemetry_record_alloc(
+    MemoryTag tag, MemoryAllocatorKind allocator, void* owner,
+    void* memory, usize size, const char* file, int line );
+/// Record a free.
+/// Owner must be the same as when allocation was recorded.
+/// Memory is attributed to the call site that allocated it.
+CORE_API void ___internal_memory_telemetry_record_free( void* owner, void* memory );
+/// Record that every block and stack allocation made from
+/// an owner buffer that starts inside of range has been freed.
+CORE_API void ___internal_memory_telemetry_record_free_range(
+    void* memory, usize size );
+
+#endif /* header guard */
@@ -10,7 +10,23 @@
 CORE_API b32 thread_create( ThreadProcFN* thread_proc, void* user_params ) {
     PlatformThread* thread =
         platform_thread_create( thread_proc, user_params, STACK_SIZE );
-    return thread != NULL;
+    if( !thread ) {
+        return false;
+    }
+    platform_thread_detach( thread );
+    return true;
+}
+CORE_API Thread* thread_create_joinable( ThreadProcFN* thread_proc, void* user_params ) {
+    return platform_thread_create( thread_proc, user_params, STACK_SIZE );
+}
+CORE_API void thread_join( Thread* thread, int* opt_out_return_code ) {
+    platform_thread_join( thread, opt_out_return_code );
+}
+CORE_API b32 thread_set_affinity( u32 logical_cpu ) {
+    return platform_thread_set_affinity( logical_cpu );
+}
+CORE_API void thread_set_name( const char* name ) {
+    platform_thread_set_name( name );
 }
 
 
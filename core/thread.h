@@ -9,9 +9,25 @@
 
 /// Thread procedure prototype.
 typedef int ThreadProcFN( void* user_params );
+/// Opaque handle to a joinable thread.
+typedef void Thread;
 
 /// Create a thread.
+/// Thread cleans up after itself once thread_proc returns.
 /// Returns false if failed.
 CORE_API b32 thread_create( ThreadProcFN* thread_proc, void* user_params );
+/// Create a thread that has to be joined with thread_join.
+/// Returns NULL if failed.
+CORE_API Thread* thread_create_joinable( ThreadProcFN* thread_proc, void* user_params );
+/// Wait for thread to exit and release it.
+/// Writes value returned by thread_proc to opt_out_return_code.
+CORE_API void thread_join( Thread* thread, int* opt_out_return_code );
+/// Restrict calling thread to run only on given logical processor.
+/// SystemInfo::core_logical_cpu lists one logical processor per physical core.
+/// Returns false if failed.
+CORE_API b32 thread_set_affinity( u32 logical_cpu );
+/// Set name of calling thread, shows up in debuggers and profilers.
+/// Name can be truncated, linux only keeps first 15 characters.
+CORE_API void thread_set_name( const char* name );
 
 #endif /* header guard */
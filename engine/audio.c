@@ -4,6 +4,7 @@
  * File Created: October 27, 2023
 */
 #include "shared/defines.h"
+#include "core/atomic.h"
 #include "core/sync.h"
 #include "core/memory.h"
 #include "core/math.h"
@@ -126,7 +127,7 @@ b32 ___debug_load_audio(
 
     buffer.buffer_size = resource.size;
     assert( buffer.right_channel_offset < buffer.buffer_size );
-    buffer.buffer = system_alloc( buffer.buffer_size );
+    buffer.buffer = system_alloc_tagged( buffer.buffer_size, MEMORY_TAG_AUDIO );
     assert( buffer.buffer );
 
     buffer.number_of_channels = 2;
@@ -195,7 +196,8 @@ b32 ___debug_load_audio(
         goto load_audio_fail;
     }
 
-    audio_buffer.buffer = system_alloc( audio_buffer.buffer_size );
+    audio_buffer.buffer = system_alloc_tagged(
+        audio_buffer.buffer_size, MEMORY_TAG_AUDIO );
     if( !audio_buffer.buffer ) {
         error_log(
             "Failed to allocate {f,m} for audio buffer!",
@@ -224,9 +226,11 @@ load_audio_fail:
 #define AUDIO_BUFFER_LENGTH_MS (250)
 
 global MediaAudioContext global_audio_ctx;
-global b32 global_audio_is_playing = false;
+global volatile b32 global_audio_is_playing = false;
 
 struct AudioMixer {
+    /// Volumes are written by main thread and read by audio thread.
+    SeqLock volume_lock;
     f32 master_volume;
     f32 sfx_volume;
     f32 music_volume;
@@ -252,7 +256,9 @@ f32 ___audio_db_to_01( f32 in_volume ) {
 }
 
 LD_API void audio_set_master_volume( f32 volume ) {
+    seq_lock_write_begin( &global_audio_mixer.volume_lock );
     global_audio_mixer.master_volume = ___audio_01_to_db( volume );
+    seq_lock_write_end( &global_audio_mixer.volume_lock );
 }
 LD_API f32 audio_query_master_volume(void) {
     return global_audio_mixer.master_volume;
@@ -261,7 +267,9 @@ LD_API f32 audio_query_master_volume_linear(void) {
     return ___audio_db_to_01( global_audio_mixer.master_volume );
 }
 LD_API void audio_set_music_volume( f32 volume ) {
+    seq_lock_write_begin( &global_audio_mixer.volume_lock );
     global_audio_mixer.music_volume = ___audio_01_to_db( volume );
+    seq_lock_write_end( &global_audio_mixer.volume_lock );
 }
 LD_API f32 audio_query_music_volume(void) {
     return global_audio_mixer.music_volume;
@@ -270,7 +278,9 @@ LD_API f32 audio_query_music_volume_linear(void) {
     return ___audio_db_to_01( global_audio_mixer.music_volume );
 }
 LD_API void audio_set_sfx_volume( f32 volume ) {
+    seq_lock_write_begin( &global_audio_mixer.volume_lock );
     global_audio_mixer.sfx_volume = ___audio_01_to_db( volume );
+    seq_lock_write_end( &global_audio_mixer.volume_lock );
 }
 LD_API f32 audio_query_sfx_volume(void) {
     return global_audio_mixer.sfx_volume;
@@ -297,9 +307,14 @@ void ___audio_fill_buffer( usize samples_to_fill ) {
 
     struct AudioVoice* voices = global_voices;
 
-    f32 master_volume = global_audio_mixer.master_volume;
-    f32 music_volume  = ___audio_music_volume();
-    f32 sfx_volume    = ___audio_sfx_volume();
+    f32 master_volume, music_volume, sfx_volume;
+    u32 volume_sequence;
+    do {
+        volume_sequence = seq_lock_read_begin( &global_audio_mixer.volume_lock );
+        master_volume   = global_audio_mixer.master_volume;
+        music_volume    = ___audio_music_volume();
+        sfx_volume      = ___audio_sfx_volume();
+    } while( seq_lock_read_retry( &global_audio_mixer.volume_lock, volume_sequence ) );
 
     f32* samples = (f32*)global_audio_mixer.buffer;
     for( usize i = 0; i < samples_to_fill; ++i ) {
@@ -374,13 +389,12 @@ void audio_subsystem_output(void) {
 internal no_inline int on_buffer_fill( void* user_params ) {
     unused( user_params );
 
-    read_write_fence();
-
+    // NOTE(alicia): semaphore wait already acquires everything
+    // main thread wrote before signaling, no fence needed.
     loop {
         semaphore_wait( &global_audio_mt.buffer_fill );
-        read_write_fence();
 
-        if( !global_audio_is_playing ) {
+        if( !atomic_load_u32( &global_audio_is_playing, MEMORY_ORDER_ACQUIRE ) ) {
             continue;
         }
 
@@ -456,8 +470,6 @@ b32 audio_subsystem_initialize(void) {
         return false;
     }
 
-    read_write_fence();
-
     if( !thread_create( on_buffer_fill, NULL ) ) {
         fatal_log( "Failed to create audio thread!" );
         return false;
@@ -491,8 +503,7 @@ void audio_subsystem_resume(void) {
         media_audio_is_context_valid( &global_audio_ctx ) &&
         !global_audio_is_playing
     ) {
-        global_audio_is_playing = true;
-        read_write_fence();
+        atomic_store_u32( &global_audio_is_playing, true, MEMORY_ORDER_RELEASE );
         media_audio_start( &global_audio_ctx );
     }
 }
@@ -501,8 +512,7 @@ void audio_subsystem_pause(void) {
         media_audio_is_context_valid( &global_audio_ctx ) &&
         global_audio_is_playing
     ) {
-        global_audio_is_playing = false;
-        read_write_fence();
+        atomic_store_u32( &global_audio_is_playing, false, MEMORY_ORDER_RELEASE );
         media_audio_stop( &global_audio_ctx );
     }
 }
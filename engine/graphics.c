@@ -109,14 +109,6 @@ b32 render_command_sort_lt( void* lhs, void* rhs, void* params ) {
     return a->type < b->type;
 
 }
-internal no_inline
-void render_command_sort_swap( void* lhs, void* rhs ) {
-    struct RenderCommand* a = lhs;
-    struct RenderCommand* b = rhs;
-    struct RenderCommand  temp = *a;
-    *a = *b;
-    *b = temp;
-}
 
 internal b32 renderer_subsystem_begin_frame(void) {
     vec3 camera_position = VEC3_ZERO;
@@ -130,8 +122,7 @@ internal b32 renderer_subsystem_begin_frame(void) {
         0, global_render_data->list_commands.count - 1,
         sizeof(struct RenderCommand),
         global_render_data->list_commands.buffer,
-        render_command_sort_lt, &camera_position,
-        render_command_sort_swap );
+        render_command_sort_lt, &camera_position, NULL );
 
     // TODO(alicia): frustum culling
 
@@ -162,6 +153,34 @@ internal b32 renderer_subsystem_begin_frame(void) {
 internal b32 renderer_subsystem_end_frame(void) {
     return global_renderer->end_frame();
 }
+/// Free payloads that did not fit in given frame arena.
+internal void renderer_subsystem_free_frame_large_allocations( u32 arena_index ) {
+    RenderFrameLargeAllocation* allocation =
+        global_render_data->frame_large_allocations[arena_index];
+    while( allocation ) {
+        RenderFrameLargeAllocation* next = allocation->next;
+        system_free( allocation, allocation->size );
+        allocation = next;
+    }
+    global_render_data->frame_large_allocations[arena_index] = NULL;
+}
+internal void renderer_subsystem_swap_frame_arena(void) {
+    StackAllocator* arena =
+        global_render_data->frame_arenas + global_render_data->frame_arena_index;
+    global_render_data->frame_arena_high_water_mark = max(
+        global_render_data->frame_arena_high_water_mark, arena->current );
+
+    global_render_data->frame_arena_index =
+        ( global_render_data->frame_arena_index + 1 ) % RENDER_FRAME_ARENA_COUNT;
+
+    // NOTE(alicia): arena is only rewound, frame allocations
+    // are not guaranteed to be zeroed so there's no point
+    // in clearing the whole buffer every frame.
+    global_render_data->frame_arenas[
+        global_render_data->frame_arena_index].current = 0;
+    renderer_subsystem_free_frame_large_allocations(
+        global_render_data->frame_arena_index );
+}
 b32 renderer_subsystem_draw(void) {
     if( renderer_subsystem_begin_frame() ) {
         if( !renderer_subsystem_end_frame() ) {
@@ -172,17 +191,88 @@ b32 renderer_subsystem_draw(void) {
         return false;
     }
 
+    renderer_subsystem_swap_frame_arena();
     return true;
 }
 
 void renderer_subsystem_shutdown(void) {
     global_renderer->shutdown();
     global_renderer = NULL;
+
+    for( u32 i = 0; i < RENDER_FRAME_ARENA_COUNT; ++i ) {
+        renderer_subsystem_free_frame_large_allocations( i );
+    }
 }
 
 LD_API void graphics_set_camera( struct Camera* camera ) {
     global_render_data->camera = camera;
 }
+LD_API void* graphics_frame_alloc( usize size ) {
+    StackAllocator* arena =
+        global_render_data->frame_arenas + global_render_data->frame_arena_index;
+
+    u8* current = (u8*)arena->buffer + arena->current;
+    u8* aligned = memory_align( current, RENDER_FRAME_ARENA_ALIGNMENT );
+
+    usize new_current = (usize)( aligned - (u8*)arena->buffer ) + size;
+    if( new_current > arena->buffer_size ) {
+        return NULL;
+    }
+
+    arena->current = new_current;
+    return aligned;
+}
+/// Allocate payload that does not fit in frame arena from heap.
+/// Freed once current frame arena is reused, same as arena memory.
+internal void* graphics_frame_alloc_large( usize size ) {
+    usize allocation_size = sizeof(RenderFrameLargeAllocation) + size;
+    RenderFrameLargeAllocation* allocation =
+        system_alloc_tagged( allocation_size, MEMORY_TAG_RENDERER );
+    if( !allocation ) {
+        return NULL;
+    }
+
+    u32 arena_index  = global_render_data->frame_arena_index;
+    allocation->size = allocation_size;
+    allocation->next = global_render_data->frame_large_allocations[arena_index];
+    global_render_data->frame_large_allocations[arena_index] = allocation;
+    return allocation + 1;
+}
+/// Copy payload into frame arena.
+/// Payloads that were allocated with graphics_frame_alloc are not copied.
+/// Payloads that don't fit in frame arena are copied to heap instead.
+/// Returns false if payload could not be copied,
+/// command must not be sent in that case since caller's buffer
+/// can be freed before renderer reads it.
+internal b32 graphics_frame_copy( void* buffer, usize size, void** out_copy ) {
+    if( !buffer || !size ) {
+        *out_copy = buffer;
+        return true;
+    }
+
+    StackAllocator* arena =
+        global_render_data->frame_arenas + global_render_data->frame_arena_index;
+    u8* arena_start = arena->buffer;
+    u8* arena_end   = arena_start + arena->current;
+    if( (u8*)buffer >= arena_start && (u8*)buffer < arena_end ) {
+        *out_copy = buffer;
+        return true;
+    }
+
+    void* result = graphics_frame_alloc( size );
+    if( !result ) {
+        result = graphics_frame_alloc_large( size );
+    }
+    if( !result ) {
+        error_log(
+            "Failed to allocate memory for {f,.2,m} payload copy!", (f64)size );
+        return false;
+    }
+
+    memory_copy( result, buffer, size );
+    *out_copy = result;
+    return true;
+}
 LD_API void graphics_draw(
     mat4     transform,
     RenderID mesh,
@@ -225,25 +315,41 @@ LD_API RenderID graphics_generate_mesh(
     usize vertex_count, struct Vertex3D* vertices,
     usize index_count, u32* indices
 ) {
+    void* vertices_copy = NULL;
+    void* indices_copy  = NULL;
+    if(
+        !graphics_frame_copy(
+            vertices, sizeof(struct Vertex3D) * vertex_count, &vertices_copy ) ||
+        !graphics_frame_copy( indices, sizeof(u32) * index_count, &indices_copy )
+    ) {
+        return 0;
+    }
+
     struct RenderCommand command = {};
     command.type                       = RENDER_COMMAND_GENERATE_MESH;
     command.generate_mesh.id           = global_running_mesh_id;
     command.generate_mesh.vertex_count = vertex_count;
-    command.generate_mesh.vertices     = vertices;
+    command.generate_mesh.vertices     = vertices_copy;
     command.generate_mesh.index_count  = index_count;
-    command.generate_mesh.indices      = indices;
+    command.generate_mesh.indices      = indices_copy;
 
     assert( list_push( &global_render_data->list_commands, &command ) );
 
     return global_running_mesh_id++;
 }
-LD_API void graphics_retire_meshes( usize count, RenderID* meshes ) {
+LD_API b32 graphics_retire_meshes( usize count, RenderID* meshes ) {
+    void* ids_copy = NULL;
+    if( !graphics_frame_copy( meshes, sizeof(RenderID) * count, &ids_copy ) ) {
+        return false;
+    }
+
     struct RenderCommand command = {};
     command.type                = RENDER_COMMAND_RETIRE_MESHES;
     command.retire_meshes.count = count;
-    command.retire_meshes.ids   = meshes;
+    command.retire_meshes.ids   = ids_copy;
 
     assert( list_push( &global_render_data->list_commands, &command ) );
+    return true;
 }
 LD_API RenderID graphics_generate_texture(
     GraphicsTextureType     type,
@@ -271,21 +377,30 @@ LD_API RenderID graphics_generate_texture(
     command.generate_texture.width      = width;
     command.generate_texture.height     = height;
     command.generate_texture.depth      = depth;
-    command.generate_texture.buffer     = buffer;
     command.generate_texture.id         = global_running_texture_id;
+    if( !graphics_frame_copy(
+        buffer, buffer_size, &command.generate_texture.buffer
+    ) ) {
+        return 0;
+    }
 
-    unused(buffer_size);
     assert( list_push( &global_render_data->list_commands, &command ) );
 
     return global_running_texture_id++;
 }
-LD_API void graphics_retire_textures( usize count, RenderID* textures ) {
+LD_API b32 graphics_retire_textures( usize count, RenderID* textures ) {
+    void* ids_copy = NULL;
+    if( !graphics_frame_copy( textures, sizeof(RenderID) * count, &ids_copy ) ) {
+        return false;
+    }
+
     struct RenderCommand command = {};
     command.type                  = RENDER_COMMAND_RETIRE_TEXTURES;
     command.retire_textures.count = count;
-    command.retire_textures.ids   = textures;
+    command.retire_textures.ids   = ids_copy;
 
     assert( list_push( &global_render_data->list_commands, &command ) );
+    return true;
 }
 LD_API void graphics_set_directional_light(
     vec3 direction, vec3 color, b32 is_active
@@ -27,17 +27,29 @@ LD_API void graphics_draw(
     b32      is_wireframe
 );
 
+/// Allocate memory that lives until the end of the next frame.
+/// Buffers allocated with this function are passed to the renderer
+/// without being copied.
+/// Memory returned is aligned to 16 bytes and is not zeroed.
+/// Returns NULL if frame arena is out of memory.
+LD_API void* graphics_frame_alloc( usize size );
+
 /// Send a generate mesh command to the renderer.
-/// Provided buffers must live until the end of the current frame.
+/// Provided buffers are copied into the frame arena
+/// and can be freed as soon as this function returns.
+/// Returns 0 and sends nothing if frame arena is out of memory.
 LD_API RenderID graphics_generate_mesh(
     usize vertex_count, struct Vertex3D* vertices,
     usize index_count, u32* indices );
 /// Retire meshes.
-/// Provided buffers must live until the end of the current frame.
-LD_API void graphics_retire_meshes( usize count, RenderID* meshes );
+/// Provided buffer is copied into the frame arena.
+/// Returns false and sends nothing if frame arena is out of memory.
+LD_API b32 graphics_retire_meshes( usize count, RenderID* meshes );
 
 /// Send a generate texture command to the renderer.
-/// Provided buffers must live until the end of the current frame.
+/// Provided buffer is copied into the frame arena
+/// and can be freed as soon as this function returns.
+/// Returns 0 and sends nothing if frame arena is out of memory.
 LD_API RenderID graphics_generate_texture(
     GraphicsTextureType     type,
     GraphicsTextureFormat   format,
@@ -52,11 +64,14 @@ LD_API RenderID graphics_generate_texture(
     void* buffer
 );
 /// Retire textures.
-/// Provided buffers must live until the end of the current frame.
-LD_API void graphics_retire_textures( usize count, RenderID* textures );
+/// Provided buffer is copied into the frame arena.
+/// Returns false and sends nothing if frame arena is out of memory.
+LD_API b32 graphics_retire_textures( usize count, RenderID* textures );
 
 /// Send a generate texture command to the renderer.
-/// Provided buffers must live until the end of the current frame.
+/// Provided buffer is copied into the frame arena
+/// and can be freed as soon as this function returns.
+/// Returns 0 and sends nothing if frame arena is out of memory.
 header_only
 RenderID graphics_generate_texture_2d(
     GraphicsTextureFormat format,
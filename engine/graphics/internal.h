@@ -7,6 +7,7 @@
 
 #if defined(LD_API_INTERNAL)
 #include "core/math.h"
+#include "core/memory.h"
 #include "core/collections.h"
 #include "engine/graphics/types.h"
 
@@ -54,10 +55,32 @@ typedef u32 Draw3DFlags;
 #define DRAW_3D_SHADOW_RECEIVER (1 << 2)
 #define DRAW_3D_WIREFRAME       (1 << 3)
 
+/// Number of frame arenas.
+/// Payloads copied during frame N stay valid until frame N + 1 has been drawn.
+#define RENDER_FRAME_ARENA_COUNT (2)
+/// Alignment of frame arena allocations.
+#define RENDER_FRAME_ARENA_ALIGNMENT (16)
+
+/// Header of payload that did not fit in frame arena.
+/// Payload follows header and is freed once its frame arena is reused.
+typedef struct RenderFrameLargeAllocation {
+    struct RenderFrameLargeAllocation* next;
+    /// Size of allocation, including header.
+    usize size;
+} RenderFrameLargeAllocation;
+static_assert(
+    sizeof(RenderFrameLargeAllocation) % RENDER_FRAME_ARENA_ALIGNMENT == 0,
+    "RenderFrameLargeAllocation must keep payload aligned!" );
+
 typedef struct RenderData {
     struct Camera* camera;
 
     List list_commands;
+
+    StackAllocator frame_arenas[RENDER_FRAME_ARENA_COUNT];
+    RenderFrameLargeAllocation* frame_large_allocations[RENDER_FRAME_ARENA_COUNT];
+    u32            frame_arena_index;
+    usize          frame_arena_high_water_mark;
 } RenderData;
 
 struct CommandPointLight {
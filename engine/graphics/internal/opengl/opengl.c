@@ -923,7 +923,7 @@ b32 gl_subsystem_init(void) {
         GL_OPEN_SHADER(
             "./resources/shaders/phong.frag.spv", phong_frag );
 
-        u8* read_buffer = system_alloc( buffer_size );
+        u8* read_buffer = system_alloc_tagged( buffer_size, MEMORY_TAG_RENDERER );
         assert( read_buffer );
 
         GL_READ_SHADER( post_process_vert );
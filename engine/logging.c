@@ -19,18 +19,16 @@ global char LOGGING_BUFFER[LOGGING_BUFFER_SIZE] = {0};
 
 global LoggingLevel LOGGING_LEVEL = LOGGING_LEVEL_NONE;
 
+// NOTE(alicia): zero initialized mutex is ready to use,
+// so logging can be locked before subsystem is initialized.
 global Mutex LOGGING_MUTEX = {};
 internal force_inline
 void ___log_lock(void) {
-    if( LOGGING_MUTEX.handle ) {
-        mutex_lock( &LOGGING_MUTEX );
-    }
+    mutex_lock( &LOGGING_MUTEX );
 }
 internal force_inline
 void ___log_unlock(void) {
-    if( LOGGING_MUTEX.handle ) {
-        mutex_unlock( &LOGGING_MUTEX );
-    }
+    mutex_unlock( &LOGGING_MUTEX );
 }
 
 global FileHandle* LOGGING_FILE = NULL;
@@ -56,20 +54,16 @@ void logging_subsystem_initialize( FileHandle* output_file ) {
 }
 void logging_subsystem_attach_file( FileHandle* file ) {
     ___log_lock();
-    read_write_fence();
 
     LOGGING_FILE = file;
 
-    read_write_fence();
     ___log_unlock();
 }
 void logging_subsystem_detach_file(void) {
     ___log_lock();
-    read_write_fence();
 
     LOGGING_FILE = NULL;
 
-    read_write_fence();
     ___log_unlock();
 }
 
@@ -242,13 +236,11 @@ LD_API void logging_output_locked(
     StringSlice message
 ) {
     ___log_lock();
-    read_write_fence();
 
     logging_output(
         type, opt_color_override, trace,
         always_log, new_line, timestamped, message );
 
-    read_write_fence();
     ___log_unlock();
 }
 
@@ -284,14 +276,12 @@ LD_API void ___internal_logging_output_fmt_locked_va(
     usize format_len, const char* format, va_list va
 ) {
     ___log_lock();
-    read_write_fence();
 
     ___internal_logging_output_fmt_va(
         type, opt_color_override, trace,
         always_log, new_line, timestamped,
         format_len, format, va );
 
-    read_write_fence();
     ___log_unlock();
 }
 
@@ -15,6 +15,7 @@
 #include "core/shared_object.h"
 #include "core/time.h"
 #include "core/jobs.h"
+#include "core/scratch.h"
 #include "core/system.h"
 #include "core/lib.h"
 
@@ -39,6 +40,8 @@ global const char* global_executable_name = "";
 // TODO(alicia): defaults for other platforms :)
 #define DEFAULT_RENDERER_BACKEND (RENDERER_BACKEND_OPENGL)
 
+#define DEFAULT_HUGE_PAGES (true)
+
 struct SettingsParse {
     i32 resolution_width;
     i32 resolution_height;
@@ -47,6 +50,7 @@ struct SettingsParse {
     f32 audio_volume_music;
     f32 audio_volume_sfx;
     enum RendererBackend backend;
+    b32 huge_pages;
 };
 internal force_inline
 struct SettingsParse ___settings_parse_default(void) {
@@ -59,6 +63,8 @@ struct SettingsParse ___settings_parse_default(void) {
     result.audio_volume_sfx    = DEFAULT_AUDIO_VOLUME_SFX;
 
     result.backend = DEFAULT_RENDERER_BACKEND;
+
+    result.huge_pages = DEFAULT_HUGE_PAGES;
     return result;
 }
 
@@ -66,6 +72,8 @@ global b32 global_application_is_running = true;
 global f32 global_resolution_scale       = 1.0f;
 
 #define LOGGING_SUBSYSTEM_SIZE (kilobytes(1))
+#define SCRATCH_RESERVE_SIZE   (megabytes(32))
+#define RENDERER_FRAME_ARENA_SIZE (megabytes(8))
 
 typedef usize ApplicationQueryMemoryRequirementFN(void);
 typedef b32 ApplicationInitializeFN( void* memory );
@@ -173,6 +181,7 @@ int main( int argc, char** argv ) {
     #define exit( code )\
         media_shutdown();\
         job_system_shutdown();\
+        scratch_shutdown();\
         return code
 
     global_executable_name = argv[0];
@@ -223,6 +232,7 @@ int main( int argc, char** argv ) {
     i32 height = settings.resolution_height;
     global_resolution_scale = settings.resolution_scale;
     RendererBackend backend = settings.backend;
+    b32 huge_pages          = settings.huge_pages;
 
     StringSlice game_library_path = string_slice( GAME_LIBRARY_PATH_DEFAULT );
 
@@ -596,6 +606,12 @@ int main( int argc, char** argv ) {
 #endif
     note_log( "Platform:          {s}, {s}", os, arch );
     note_log( "Page Size:         {usize}", system_info.page_size );
+    note_log( "CPU:               {cc}", system_info.cpu_name );
+    note_log( "CPU Cores:         {u16} physical, {u16} logical",
+        system_info.physical_cpu_count, system_info.cpu_count );
+    note_log( "CPU Caches:        L1 {f,.2,m} L2 {f,.2,m} L3 {f,.2,m} line {u32}",
+        (f64)system_info.l1_cache_size, (f64)system_info.l2_cache_size,
+        (f64)system_info.l3_cache_size, system_info.cache_line_size );
     note_log( "Game Library Path: {s}", game_library_path );
     note_log( "Renderer Backend:  {cc}",
         renderer_backend_to_string( backend ) );
@@ -669,17 +685,25 @@ int main( int argc, char** argv ) {
     usize audio_subsystem_memory_requirement =
         audio_subsystem_query_memory_requirement();
 
-    u32 thread_count = system_info.cpu_count;
-    thread_count = max( thread_count, 1 );
+    // NOTE(alicia): one worker per physical core, main thread takes
+    // the remaining core. SMT siblings share a core's execution units
+    // and caches so extra workers on them mostly contend with each other.
+    u32 thread_count = system_info.physical_cpu_count ?
+        system_info.physical_cpu_count : system_info.cpu_count;
+    thread_count = thread_count > 1 ? thread_count - 1 : 1;
 
     usize stack_size                       = 0;
     void* stack_buffer                     = NULL;
     usize renderer_subsystem_size          = 0;
     usize renderer_command_buffer_capacity = 0;
     usize renderer_command_buffer_size     = 0;
+    usize renderer_frame_arenas_size       =
+        RENDERER_FRAME_ARENA_SIZE * RENDER_FRAME_ARENA_COUNT;
     usize application_memory_requirement   = 0;
     usize jobs_system_memory_requirement   =
         job_system_query_memory_requirement( thread_count );
+    usize scratch_memory_requirement       =
+        scratch_query_memory_requirement( thread_count + 1 );
     /* allocate stack */ {
         application_memory_requirement =
             application_query_memory_requirement();
@@ -687,6 +711,7 @@ int main( int argc, char** argv ) {
         stack_size += application_memory_requirement;
 
         stack_size += jobs_system_memory_requirement;
+        stack_size += scratch_memory_requirement;
         stack_size += input_subsystem_query_memory_requirement();
         stack_size += audio_subsystem_memory_requirement;
 
@@ -698,14 +723,30 @@ int main( int argc, char** argv ) {
             sizeof(struct RenderCommand) * renderer_command_buffer_capacity;
 
         stack_size += renderer_command_buffer_size;
+        stack_size += renderer_frame_arenas_size;
 
+        MemoryHugePageKind stack_huge_page_kind = MEMORY_HUGE_PAGE_NONE;
         usize stack_page_count = memory_size_to_page_count( stack_size );
-        stack_buffer           = system_page_alloc( stack_page_count );
-        stack_size             = page_count_to_memory_size( stack_page_count );
+        if( huge_pages ) {
+            // NOTE(alicia): huge page allocations are rounded up
+            // to huge page size, let stack use all of it.
+            usize huge_page_size = memory_query_huge_page_size();
+            stack_page_count     = memory_size_to_page_count(
+                ( ( stack_size + huge_page_size - 1 ) / huge_page_size ) *
+                huge_page_size );
+            stack_buffer = system_huge_page_alloc_tagged(
+                stack_page_count, &stack_huge_page_kind, MEMORY_TAG_ENGINE );
+        } else {
+            stack_buffer = system_page_alloc_tagged(
+                stack_page_count, MEMORY_TAG_ENGINE );
+        }
+        stack_size = page_count_to_memory_size( stack_page_count );
 
         info_log(
-            "Stack Size: {usize}({f,.2,m}) Stack Pages: {usize}",
-            stack_size, (f64)stack_size, stack_page_count );
+            "Stack Size: {usize}({f,.2,m}) Stack Pages: {usize} Huge Pages: {cc}",
+            stack_size, (f64)stack_size, stack_page_count,
+            huge_pages ?
+                memory_huge_page_kind_to_cstr( stack_huge_page_kind ) : "disabled" );
         if( !stack_buffer ) {
             string_buffer_empty( error_title, 64 );
             string_buffer_empty( error_message, 255 );
@@ -740,14 +781,31 @@ int main( int argc, char** argv ) {
 #endif
 
     /* initialize input subsystem */ {
-        void* input_subsytem_buffer = stack_allocator_push(
-            &stack, input_subsystem_query_memory_requirement() );
+        void* input_subsytem_buffer = stack_allocator_push_tagged(
+            &stack, input_subsystem_query_memory_requirement(), MEMORY_TAG_INPUT );
         input_subsystem_initialize( input_subsytem_buffer );
     }
 
     /* initialize threading subsystem */ {
+        // NOTE(alicia): job thread indices start at 1, 0 is main thread.
+        void* scratch_buffer =
+            stack_allocator_push_tagged(
+                &stack, scratch_memory_requirement, MEMORY_TAG_CORE );
+        if( !scratch_initialize(
+            thread_count + 1, SCRATCH_RESERVE_SIZE, huge_pages, scratch_buffer
+        ) ) {
+            fatal_log( "Failed to initialize thread scratch arenas!" );
+            media_fatal_message_box_blocking(
+                "Fatal Error "
+                macro_value_to_string(
+                    ENGINE_ERROR_THREAD_SUBSYSTEM_INITIALIZE ),
+                "Failed to initialize thread subsystem!" );
+            exit( ENGINE_ERROR_THREAD_SUBSYSTEM_INITIALIZE );
+        }
+
         void* jobs_subsystem_buffer =
-            stack_allocator_push( &stack, jobs_system_memory_requirement );
+            stack_allocator_push_tagged(
+                &stack, jobs_system_memory_requirement, MEMORY_TAG_CORE );
 
         if( !job_system_initialize( thread_count, jobs_subsystem_buffer ) ) {
             fatal_log( "Failed to initialize thread subsystem!" );
@@ -785,14 +843,27 @@ int main( int argc, char** argv ) {
     RenderData render_data = {};
     /* initialize renderer */ {
         void* renderer_subsystem_buffer =
-            stack_allocator_push( &stack, renderer_subsystem_size );
+            stack_allocator_push_tagged(
+                &stack, renderer_subsystem_size, MEMORY_TAG_RENDERER );
         void* renderer_command_buffer =
-            stack_allocator_push( &stack, renderer_command_buffer_size );
+            stack_allocator_push_tagged(
+                &stack, renderer_command_buffer_size, MEMORY_TAG_RENDERER );
+
+        u8* renderer_frame_arenas_buffer =
+            stack_allocator_push_tagged(
+                &stack, renderer_frame_arenas_size, MEMORY_TAG_RENDERER );
 
         render_data.list_commands = list_create(
             renderer_command_buffer_capacity,
             sizeof(struct RenderCommand), renderer_command_buffer );
 
+        for( usize i = 0; i < RENDER_FRAME_ARENA_COUNT; ++i ) {
+            StackAllocator* arena = render_data.frame_arenas + i;
+            arena->buffer      =
+                renderer_frame_arenas_buffer + ( RENDERER_FRAME_ARENA_SIZE * i );
+            arena->buffer_size = RENDERER_FRAME_ARENA_SIZE;
+        }
+
         if( !renderer_subsystem_init(
             &surface, backend,
             iv2_v2( v2_mul( v2( (f32)width, (f32)height ), global_resolution_scale ) ),
@@ -809,7 +880,8 @@ int main( int argc, char** argv ) {
     }
 
     void* application_memory =
-        stack_allocator_push( &stack, application_memory_requirement );
+        stack_allocator_push_tagged(
+            &stack, application_memory_requirement, MEMORY_TAG_GAME );
     if( !application_initialize( application_memory ) ) {
         fatal_log( "Failed to initialize application!" );
         media_fatal_message_box_blocking(
@@ -882,12 +954,37 @@ int main( int argc, char** argv ) {
     renderer_subsystem_shutdown();
     media_surface_destroy( &surface );
 
+    for( usize i = 0; i < scratch_query_thread_count(); ++i ) {
+        note_log(
+            "Thread {usize} Peak Scratch Usage: {f,.2,m}",
+            i, (f64)scratch_query_peak_usage( i ) );
+    }
+    note_log(
+        "Renderer Peak Frame Arena Usage: {f,.2,m}",
+        (f64)render_data.frame_arena_high_water_mark );
+
+    shared_object_close( game );
+
+    media_shutdown();
+    job_system_shutdown();
+    scratch_shutdown();
+
+    if( huge_pages ) {
+        system_huge_page_free(
+            stack.buffer, memory_size_to_page_count( stack.buffer_size ) );
+    } else {
+        system_page_free(
+            stack.buffer, memory_size_to_page_count( stack.buffer_size ) );
+    }
+
+    memory_telemetry_log_report();
+    memory_telemetry_log_leaks();
+
 #if defined(LD_LOGGING)
     fs_file_close( logging_file );
 #endif
 
-    shared_object_close( game );
-    exit( ENGINE_SUCCESS );
+    return ENGINE_SUCCESS;
 
     #undef exit
 }
@@ -996,7 +1093,8 @@ internal b32 ___settings_parse_float(
 typedef enum Section : u32 {
     SECTION_UNKNOWN,
     SECTION_GRAPHICS,
-    SECTION_AUDIO
+    SECTION_AUDIO,
+    SECTION_MEMORY
 } Section;
 
 internal
@@ -1031,6 +1129,10 @@ b32 parse_settings( struct SettingsParse* out_parse_result ) {
         settings_output_string( "music  = {f,.1} \n", DEFAULT_AUDIO_VOLUME_MUSIC );
         settings_output_string( "sfx    = {f,.1} \n", DEFAULT_AUDIO_VOLUME_SFX );
 
+        settings_output_string( "[memory] \n" );
+        settings_output_string(
+            "huge_pages = {cc} \n", DEFAULT_HUGE_PAGES ? "true" : "false" );
+
         fs_file_close( settings_file );
 
         settings_file = fs_file_open( settings_path, flags );
@@ -1045,6 +1147,7 @@ b32 parse_settings( struct SettingsParse* out_parse_result ) {
     parse_result.resolution_height = DEFAULT_RESOLUTION_HEIGHT;
     parse_result.resolution_scale  = DEFAULT_RESOLUTION_SCALE;
     parse_result.backend           = RENDERER_BACKEND_OPENGL;
+    parse_result.huge_pages        = DEFAULT_HUGE_PAGES;
 
     usize settings_file_size = fs_file_query_size( settings_file );
     if( !settings_file_size ) {
@@ -1095,6 +1198,11 @@ b32 parse_settings( struct SettingsParse* out_parse_result ) {
     StringSlice token_audio_volume_music  = string_slice( "music" );
     StringSlice token_audio_volume_sfx    = string_slice( "sfx" );
 
+    StringSlice token_section_memory    = string_slice( "[memory]" );
+    StringSlice token_memory_huge_pages = string_slice( "huge_pages" );
+    StringSlice token_true              = string_slice( "true" );
+    StringSlice token_false             = string_slice( "false" );
+
 
     usize eol = 0;
     StringSlice line = settings;
@@ -1109,6 +1217,8 @@ b32 parse_settings( struct SettingsParse* out_parse_result ) {
                     section = SECTION_GRAPHICS;
                 } else if( string_slice_find( temp, token_section_audio, NULL ) ) {
                     section = SECTION_AUDIO;
+                } else if( string_slice_find( temp, token_section_memory, NULL ) ) {
+                    section = SECTION_MEMORY;
                 }
             } break;
             case ' ':
@@ -1180,6 +1290,19 @@ b32 parse_settings( struct SettingsParse* out_parse_result ) {
                 }
 
             } break;
+            case SECTION_MEMORY: {
+                if( string_slice_find( temp, token_memory_huge_pages, NULL ) ) {
+                    StringSlice value;
+                    value.str = temp.str + token_memory_huge_pages.len;
+                    value.len = temp.len - token_memory_huge_pages.len;
+
+                    if( string_slice_find( value, token_true, NULL ) ) {
+                        parse_result.huge_pages = true;
+                    } else if( string_slice_find( value, token_false, NULL ) ) {
+                        parse_result.huge_pages = false;
+                    }
+                }
+            } break;
             default: break;
         }
 
@@ -226,6 +226,10 @@ int main( int argc, char** argv ) {
                 }
             }
 
+            // NOTE(alicia): hashes come from the same cstr_hash that
+            // core uses at runtime and every simd path of cstr_hash
+            // produces identical results, so generated constants
+            // match no matter which cpu generated them.
             hash = string_slice_hash( string );
             output_write( "// \"{s}\"", string );
             output_write( "#define HASH_{s,u,30} ({u64}ULL)\n", identifier, hash );
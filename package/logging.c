@@ -37,7 +37,6 @@ void logging_print( b32 verbose, b32 error, usize format_len, char* format, ...
     }
 
     mutex_lock( &global_mutex );
-    read_write_fence();
 
     va_list va;
     va_start( va, format );
@@ -50,7 +49,6 @@ void logging_print( b32 verbose, b32 error, usize format_len, char* format, ...
 
     va_end( va );
 
-    read_write_fence();
     mutex_unlock( &global_mutex );
 }
 
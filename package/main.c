@@ -14,6 +14,7 @@
 #include "core/fs.h"
 #include "core/sync.h"
 #include "core/rand.h"
+#include "core/scratch.h"
 
 #include "generated/package_hashes.h"
 
@@ -161,7 +162,7 @@ int main( int argc, char** argv ) {
                                 ) {
                                     usize capacity = args.create.output_path.len;
                                     capacity += sizeof(".lpkg") - 1;
-                                    char* buffer = system_alloc( capacity );
+                                    char* buffer = system_alloc_tagged( capacity, MEMORY_TAG_PACKAGE );
                                     if( !buffer ) {
                                         error( "failed to allocate {f,m,.2}!", (f64)capacity );
                                         return PACKAGE_ERROR_OUT_OF_MEMORY;
@@ -201,7 +202,7 @@ int main( int argc, char** argv ) {
                                 ) {
                                     usize capacity = args.create.header_output_path.len;
                                     capacity += sizeof(".h") - 1;
-                                    char* buffer = system_alloc( capacity );
+                                    char* buffer = system_alloc_tagged( capacity, MEMORY_TAG_PACKAGE );
                                     if( !buffer ) {
                                         error( "failed to allocate {f,m,.2}!", (f64)capacity );
                                         return PACKAGE_ERROR_OUT_OF_MEMORY;
@@ -333,6 +334,7 @@ int main( int argc, char** argv ) {
                 args.create.output_path );
 
             thread_shutdown();
+            memory_telemetry_log_leaks();
         } break;
         case PACKAGE_MODE_HELP: {
             print_help_mode( args.help.mode );
@@ -396,7 +398,7 @@ PackageError package_mode_create(
     header_params.manifest    = &manifest;
     header_params.output_path = header_output_path;
     read_write_fence();
-    job_system_push( job_header_generate, &header_params );
+    job_system_push_wait( job_header_generate, &header_params );
 
     global_process_resource_params->manifest    = &manifest;
     global_process_resource_params->output_path = output_path;
@@ -414,23 +416,14 @@ PackageError package_mode_create(
             desired_job_count = remaining_resources;
         }
 
-        usize jobs_kicked_off = 0;
         for( usize i = 0; i < desired_job_count; ++i ) {
             usize index = i + running_item_index;
-            if( !job_system_push( job_process_resource, (void*)index ) ) {
-                break;
-            }
-            jobs_kicked_off++;
-        }
-        running_item_index  += jobs_kicked_off;
-        remaining_resources -= jobs_kicked_off;
-
-        if( remaining_resources ) {
-            job_process_resource( 0, (void*)running_item_index );
-            running_item_index++;
-            remaining_resources--;
+            job_system_push_wait( job_process_resource, (void*)index );
         }
+        running_item_index  += desired_job_count;
+        remaining_resources -= desired_job_count;
 
+        // NOTE(alicia): main thread processes resources too while it waits.
         read_write_fence();
         job_system_wait();
 
@@ -482,12 +475,14 @@ PackageError thread_initialize( usize thread_count ) {
     #define error( format, ... )\
         println_err( CONSOLE_COLOR_RED format CONSOLE_COLOR_RESET, ##__VA_ARGS__ )
 
+    usize jobs_size    = job_system_query_memory_requirement( thread_count );
+    usize scratch_size = scratch_query_memory_requirement( thread_count + 1 );
+
     usize buffer_size = (thread_count + 1) * THREAD_BUFFER_SIZE;
-    global_thread_buffer_offset =
-        job_system_query_memory_requirement( thread_count );
+    global_thread_buffer_offset = jobs_size + scratch_size;
     buffer_size += global_thread_buffer_offset;
 
-    void* buffer = system_alloc( buffer_size );
+    void* buffer = system_alloc_tagged( buffer_size, MEMORY_TAG_PACKAGE );
     if( !buffer ) {
         error( "fatal error: failed to create job system" );
         error( "fatal error: could not allocate {f,m,.2}!", (f64)buffer_size );
@@ -497,8 +492,23 @@ PackageError thread_initialize( usize thread_count ) {
     global_thread_buffer      = buffer;
     global_thread_buffer_size = buffer_size;
 
+    // NOTE(alicia): job thread indices start at 1, 0 is main thread.
+    if( !scratch_initialize(
+        thread_count + 1, THREAD_SCRATCH_RESERVE_SIZE, false, (u8*)buffer + jobs_size
+    ) ) {
+        error( "fatal error: failed to create thread scratch arenas" );
+        system_free( buffer, buffer_size );
+        global_thread_buffer      = NULL;
+        global_thread_buffer_size = 0;
+        return PACKAGE_ERROR_OUT_OF_MEMORY;
+    }
+
     if( !job_system_initialize( thread_count, buffer ) ) {
         error( "fatal error: failed to create job system" );
+        scratch_shutdown();
+        system_free( buffer, buffer_size );
+        global_thread_buffer      = NULL;
+        global_thread_buffer_size = 0;
         return PACKAGE_ERROR_CREATE_JOB_SYSTEM;
     }
 
@@ -507,6 +517,15 @@ PackageError thread_initialize( usize thread_count ) {
 }
 void thread_shutdown(void) {
     job_system_shutdown();
+
+    usize thread_index = 0;
+    for( usize i = 0; i < scratch_query_thread_count(); ++i ) {
+        log_note(
+            "thread {usize} peak scratch usage: {f,m,.2}",
+            i, (f64)scratch_query_peak_usage( i ) );
+    }
+    scratch_shutdown();
+
     system_free( global_thread_buffer, global_thread_buffer_size );
 }
 void* thread_buffer_get( usize thread_index ) {
@@ -24,7 +24,8 @@ ManifestItem* ___manifest_list_next( struct ManifestList* list ) {
         usize old_size = list->capacity * sizeof(ManifestItem);
         usize new_size =
             old_size + ( MANIFEST_LIST_MINIMUM_CAPACITY * sizeof(ManifestItem) );
-        ManifestItem* new_buffer = system_realloc( list->buffer, old_size, new_size );
+        ManifestItem* new_buffer = system_realloc_tagged(
+            list->buffer, old_size, new_size, MEMORY_TAG_PACKAGE );
 
         if( !new_buffer ) {
             return NULL;
@@ -49,7 +50,8 @@ PackageError manifest_parse( PathSlice manifest_path, Manifest* out_manifest ) {
         }
 
         out_manifest->text.len = fs_file_query_size( manifest_file );
-        out_manifest->text.str = system_alloc( out_manifest->text.len );
+        out_manifest->text.str = system_alloc_tagged(
+            out_manifest->text.len, MEMORY_TAG_PACKAGE );
         if( !out_manifest->text.str ) {
             log_error(
                 "failed to allocate {f,m,.2} for manifest text!",
@@ -74,7 +76,8 @@ PackageError manifest_parse( PathSlice manifest_path, Manifest* out_manifest ) {
 
     struct ManifestList* list = &out_manifest->items;
     list->capacity = MANIFEST_LIST_MINIMUM_CAPACITY;
-    list->buffer   = system_alloc( list->capacity * sizeof(ManifestItem) );
+    list->buffer   = system_alloc_tagged(
+        list->capacity * sizeof(ManifestItem), MEMORY_TAG_PACKAGE );
     if( !list->buffer ) {
         log_error(
             "failed to allocate {f,m,.2} for manifest item list!",
@@ -13,6 +13,7 @@
 #include "core/sync.h"
 #include "core/memory.h"
 #include "core/fs.h"
+#include "core/scratch.h"
 
 #include "core/rand.h"
 
@@ -66,14 +67,17 @@ void job_process_resource( usize thread_index, void* opaque_params ) {
         "processing '{s}'({usize}) . . .",
         item->identifier, item_index );
 
+    Scratch scratch = scratch_begin( thread_index );
+
     PathBuffer item_path = {}; {
         usize capacity = params->manifest_directory.len + item->path.len + 1;
-        char* buffer = system_alloc( capacity );
+        char* buffer = scratch_push( &scratch, capacity );
         if( !buffer ) {
             log_error( "failed to allocate full item path!" );
             error = PACKAGE_ERROR_OUT_OF_MEMORY;
             goto job_process_resource_end;
         }
+        memory_zero( buffer, capacity );
 
         item_path.str = buffer;
         item_path.cap = capacity;
@@ -175,7 +179,7 @@ void job_process_resource( usize thread_index, void* opaque_params ) {
         "successfully processed '{s}'({usize})!",
         item->identifier, item_index );
 job_process_resource_end:
-    system_free( item_path.v, item_path.len );
+    scratch_end( &scratch );
     fs_file_close( input_file );
     fs_file_close( output_file );
     fs_file_close( temp_file );
@@ -28,6 +28,7 @@ typedef b32 ProcessResourceFN(
     FileHandle* input_file, FileHandle* output_file, usize buffer_size, void* buffer );
 
 #define THREAD_BUFFER_SIZE (megabytes(2))
+#define THREAD_SCRATCH_RESERVE_SIZE (megabytes(64))
 void* thread_buffer_get( usize thread_index );
 
 usize package_compression_stream( void* target, usize count, void* data );
@@ -199,4 +199,7 @@
     #define USIZE_MIN (U32_MIN)
 #endif
 
+/// Size of a cache line in bytes.
+#define CACHE_LINE_SIZE (64)
+
 #endif // header guard
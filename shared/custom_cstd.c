@@ -42,37 +42,32 @@ c_linkage void* memcpy(
 c_linkage void* memmove(
     void* str1, const void* str2, usize n
 ) {
-    #define INTERMEDIATE_BUFFER_SIZE (256ULL)
-    u8 buf[INTERMEDIATE_BUFFER_SIZE];
-    void* intermediate_buffer = buf;
-
-    if( n <= INTERMEDIATE_BUFFER_SIZE ) {
-        memcpy( intermediate_buffer, str2, n );
-        memcpy( str1, intermediate_buffer, n );
+    u8*       dst = str1;
+    const u8* src = str2;
+    if( dst == src || !n ) {
         return str1;
     }
 
-    usize iteration_count = n / INTERMEDIATE_BUFFER_SIZE;
-    usize remaining_bytes = n % INTERMEDIATE_BUFFER_SIZE;
-
-    for( usize i = 0; i < iteration_count; ++i ) {
-        usize offset = i * INTERMEDIATE_BUFFER_SIZE;
-        memcpy(
-            intermediate_buffer,
-            (u8*)str2 + offset,
-            INTERMEDIATE_BUFFER_SIZE
-        );
-        memcpy(
-            (u8*)str1 + offset,
-            intermediate_buffer,
-            INTERMEDIATE_BUFFER_SIZE
-        );
-    }
+    usize count64   = n / sizeof(u64);
+    usize remainder = n % sizeof(u64);
 
-    if( remaining_bytes ) {
-        usize offset = (iteration_count * INTERMEDIATE_BUFFER_SIZE);
-        memcpy( intermediate_buffer, (u8*)str2 + offset, remaining_bytes );
-        memcpy( (u8*)str1 + offset, intermediate_buffer, remaining_bytes );
+    // NOTE(alicia): copying front to back only overwrites bytes
+    // that were already read when destination comes before source,
+    // otherwise copy has to go back to front.
+    if( dst < src ) {
+        for( usize i = 0; i < count64; ++i ) {
+            *((u64*)dst + i) = *((u64*)src + i);
+        }
+        for( usize i = n - remainder; i < n; ++i ) {
+            dst[i] = src[i];
+        }
+    } else {
+        for( usize i = n; i > n - remainder; --i ) {
+            dst[i - 1] = src[i - 1];
+        }
+        for( usize i = count64; i > 0; --i ) {
+            *((u64*)dst + ( i - 1 )) = *((u64*)src + ( i - 1 ));
+        }
     }
 
     return str1;
@@ -342,6 +342,9 @@ typedef void LoggingCallbackFN(
 /// Function has no side effects and return value is strictly
 /// a result of the function's arguments.
 #define pure_const __attribute__((const))
+/// Compile function with additional target features.
+/// Caller is responsible for checking that the cpu supports them.
+#define target_features( features ) __attribute__((target(features)))
 
 #if defined(__cplusplus)
     #define restricted __restrict
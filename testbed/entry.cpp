@@ -30,6 +30,7 @@ struct GameMemory {
 
     RenderID triangle;
     RenderID triangle_diffuse;
+    RenderID floor_diffuse;
 };
 
 struct Vertex3D triangle_vertices[] = {
@@ -41,6 +42,11 @@ struct Vertex3D triangle_vertices[] = {
 u32 triangle_indices[] = { 0, 1, 2 };
 u8  triangle_diffuse[] = { 255, 255, 255 };
 
+// NOTE(alicia): floor texture is 16MB, larger than renderer's
+// frame arena, so uploading it goes through the heap fallback.
+#define FLOOR_DIFFUSE_SIZE    (2048)
+#define FLOOR_DIFFUSE_CHECKER (64)
+
 API usize application_query_memory_requirement() {
     return sizeof(GameMemory);
 }
@@ -81,6 +87,38 @@ API b32 application_initialize( void* in_memory ) {
         1, 1, static_array_size( triangle_diffuse ),
         triangle_diffuse );
 
+    usize floor_diffuse_size =
+        FLOOR_DIFFUSE_SIZE * FLOOR_DIFFUSE_SIZE * 4;
+    u8* floor_diffuse = (u8*)system_alloc( floor_diffuse_size );
+    if( !floor_diffuse ) {
+        error_log( "Failed to allocate floor texture!" );
+        return false;
+    }
+    for( u32 y = 0; y < FLOOR_DIFFUSE_SIZE; ++y ) {
+        for( u32 x = 0; x < FLOOR_DIFFUSE_SIZE; ++x ) {
+            b32 is_dark =
+                ( ( x / FLOOR_DIFFUSE_CHECKER ) + ( y / FLOOR_DIFFUSE_CHECKER ) ) % 2;
+            u8* pixel = floor_diffuse + ( ( ( y * FLOOR_DIFFUSE_SIZE ) + x ) * 4 );
+            pixel[0] = pixel[1] = pixel[2] = is_dark ? 96 : 192;
+            pixel[3] = 255;
+        }
+    }
+    memory->floor_diffuse = graphics_generate_texture_2d(
+        GRAPHICS_TEXTURE_FORMAT_RGBA,
+        GRAPHICS_TEXTURE_BASE_TYPE_UINT8,
+        GRAPHICS_TEXTURE_WRAP_REPEAT,
+        GRAPHICS_TEXTURE_WRAP_REPEAT,
+        GRAPHICS_TEXTURE_FILTER_BILINEAR,
+        GRAPHICS_TEXTURE_FILTER_BILINEAR,
+        FLOOR_DIFFUSE_SIZE, FLOOR_DIFFUSE_SIZE, floor_diffuse_size,
+        floor_diffuse );
+    // NOTE(alicia): renderer copied payload, buffer can go right away.
+    system_free( floor_diffuse, floor_diffuse_size );
+    if( !memory->floor_diffuse ) {
+        error_log( "Failed to upload floor texture!" );
+        return false;
+    }
+
     memory->triangle_transform =
         transform_create( VEC3_ZERO, QUAT_IDENTITY, VEC3_ONE );
 
@@ -174,7 +212,7 @@ API b32 application_run( void* in_memory ) {
         false, true, true, false );
     graphics_draw(
         memory->floor,
-        0, 0, 0, 0, 0,
+        0, memory->floor_diffuse, 0, 0, 0,
         RGB_WHITE,
         false, false, true, false );
 
@@ -185,4 +223,6 @@ API b32 application_run( void* in_memory ) {
 }
 
 #undef API
+#undef FLOOR_DIFFUSE_SIZE
+#undef FLOOR_DIFFUSE_CHECKER
 